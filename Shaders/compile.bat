@@ -1,3 +1,6 @@
 "E:/Program Files (x86)/API/Vulkan/Bin/glslc.exe" basic.vert -o basic.vert.spv
 "E:/Program Files (x86)/API/Vulkan/Bin/glslc.exe" basic.frag -o basic.frag.spv
+"E:/Program Files (x86)/API/Vulkan/Bin/glslc.exe" frustum_cull.comp -o frustum_cull.comp.spv
+"E:/Program Files (x86)/API/Vulkan/Bin/glslc.exe" hiz_reduce.comp -o hiz_reduce.comp.spv
+"E:/Program Files (x86)/API/Vulkan/Bin/glslc.exe" occlusion_cull.comp -o occlusion_cull.comp.spv
 pause
\ No newline at end of file
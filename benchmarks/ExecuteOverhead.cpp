@@ -0,0 +1,60 @@
+// Measures what DeviceFunctionTable::execute adds to calling the function pointer directly.
+// Built once per verification level from the headers alone, see GRAPHICS_BUILD_BENCHMARKS, no device is needed.
+#include "Graphics/DeviceFunctionTable.h"
+
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+	volatile float g_sink = 0.0f;
+
+	void VKAPI_PTR stubSetLineWidth(VkCommandBuffer, float lineWidth)
+	{
+		g_sink = lineWidth;
+	}
+
+	PFN_vkVoidFunction VKAPI_PTR stubGetDeviceProcAddr(VkDevice, const char* name)
+	{
+		if (std::strcmp(name, "vkCmdSetLineWidth") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubSetLineWidth);
+		return nullptr;
+	}
+
+	template<typename Function>
+	double measure(uint64_t iterations, Function&& function)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < iterations; ++i)
+			function(static_cast<float>(i));
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+
+	Graphics::DeviceFunctionTable functions(&stubGetDeviceProcAddr);
+	functions.loadFunction<Graphics::DeviceFunction::CmdSetLineWidth>(VK_NULL_HANDLE);
+	// read back through the table so the compiler can not see which function is called
+	auto direct = functions.get<Graphics::DeviceFunction::CmdSetLineWidth>();
+
+	// warm up
+	measure(iterations / 10, [&](float value) { direct(VK_NULL_HANDLE, value); });
+
+	double directTime = measure(iterations, [&](float value) { direct(VK_NULL_HANDLE, value); });
+	double executeTime = measure(iterations, [&](float value) {
+		functions.execute<Graphics::DeviceFunction::CmdSetLineWidth>(VK_NULL_HANDLE, value);
+	});
+
+	std::cout << "verify level: " << GRAPHICS_VERIFY_LEVEL << "\n"
+		<< "iterations: " << iterations << "\n"
+		<< "direct: " << directTime << " ns/call\n"
+		<< "execute: " << executeTime << " ns/call\n"
+		<< "overhead: " << executeTime - directTime << " ns/call\n";
+	return 0;
+}
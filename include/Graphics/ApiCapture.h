@@ -0,0 +1,777 @@
+#pragma once
+#include "ApiCaptureStructs.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+
+namespace Graphics {
+
+    namespace CaptureDetail {
+
+        template<typename Function>
+        struct CapturedFunction;
+
+        template<typename Ret, typename... Params>
+        struct CapturedFunction<Ret(*)(Params...)> {
+            using ReturnType = Ret;
+            using ParamTypes = std::tuple<Params...>;
+        };
+
+        // allocate infos know how many handles the call writes
+        template<typename T>
+        concept CountsOutputs = requires(const T& value) {
+            { CaptureStruct<T>::getOutputCount(value) } -> std::convertible_to<uint64_t>;
+        };
+
+        // pointers whose length is not the integer parameter before them
+        struct CountOverride {
+            std::string_view function;
+            size_t param;
+            uint64_t count;
+        };
+
+        inline constexpr CountOverride s_countOverrides[] = {
+            { "vkGetDeviceQueue", 3, 1 },
+            { "vkCmdSetBlendConstants", 1, 4 },
+        };
+
+        inline uint64_t getElementCount(std::string_view function, size_t param, uint64_t count) {
+            for (const auto& entry : s_countOverrides)
+                if (entry.function == function && entry.param == param)
+                    return entry.count;
+            return count;
+        }
+
+        // calls function with a null pointer of the chainable struct with this sType, false if there is none
+        template<typename Function, typename... Ts>
+        bool visitChainedType(VkStructureType type, Function&& function, std::tuple<Ts...>*) {
+            return ((CaptureStruct<Ts>::s_type == type && (function(static_cast<Ts*>(nullptr)), true)) || ...);
+        }
+
+        template<typename Function>
+        bool visitChainedType(VkStructureType type, Function&& function) {
+            return visitChainedType(type, function, static_cast<CaptureChainedStructs*>(nullptr));
+        }
+
+        // Encodes an element as its bytes followed by everything its pointers reach, see CaptureStruct.
+        // A pointer is a present flag followed by the element count and the elements, a string its length
+        // and characters, a pNext chain the sType of every struct before it and VK_STRUCTURE_TYPE_MAX_ENUM at the end.
+        class CaptureWriter {
+            std::vector<uint8_t>& m_buffer;
+            bool m_supported = true;
+
+        public:
+            explicit CaptureWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer) {};
+
+            bool isSupported() const { return m_supported; };
+
+            template<typename T>
+            void write(const T& value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                raw(&value, sizeof(T));
+            }
+
+            void raw(const void* data, size_t size) {
+                auto bytes = static_cast<const uint8_t*>(data);
+                m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+            }
+
+            template<typename T>
+            void element(const T& value) {
+                if constexpr (std::is_same_v<T, const char*>) {
+                    string(value);
+                }
+                else {
+                    write(value);
+                    if constexpr (!Handle<T> && std::is_class_v<T>)
+                        member(value);
+                }
+            }
+
+            template<typename H>
+            void handle(const H&) {}
+
+            template<typename T, typename Count>
+            void array(T* const& pointer, Count count) {
+                if (!pointer || count == 0) {
+                    write(uint8_t(0));
+                    return;
+                }
+                write(uint8_t(1));
+                write(static_cast<uint64_t>(count));
+                for (uint64_t i = 0; i < static_cast<uint64_t>(count); ++i)
+                    element(pointer[i]);
+            }
+
+            template<typename T, typename Size>
+            void bytes(T* const& pointer, Size size) {
+                if (!pointer || size == 0) {
+                    write(uint8_t(0));
+                    return;
+                }
+                write(uint8_t(1));
+                write(static_cast<uint64_t>(size));
+                raw(pointer, static_cast<size_t>(size));
+            }
+
+            void string(const char* const& pointer) {
+                if (!pointer) {
+                    write(uint8_t(0));
+                    return;
+                }
+                uint64_t length = std::strlen(pointer);
+                write(uint8_t(1));
+                write(length);
+                raw(pointer, static_cast<size_t>(length));
+            }
+
+            template<typename T>
+            void chain(T* const& pNext) {
+                if (!pNext) {
+                    write(VK_STRUCTURE_TYPE_MAX_ENUM);
+                    return;
+                }
+                VkStructureType type = static_cast<const VkBaseInStructure*>(pNext)->sType;
+                bool known = visitChainedType(type, [&]<typename S>(S*) {
+                    write(type);
+                    element(*static_cast<const S*>(pNext));
+                });
+                if (!known) {
+                    m_supported = false;
+                    write(VK_STRUCTURE_TYPE_MAX_ENUM);
+                }
+            }
+
+            template<typename S>
+            void member(const S& value) {
+                if constexpr (CaptureStruct<S>::s_supported)
+                    CaptureStruct<S>::visit(*this, value);
+                else
+                    m_supported = false;
+            }
+
+            void unsupported() { m_supported = false; };
+        };
+
+        // keeps the replayed copies of captured data alive until the call returned
+        class CaptureArena {
+            std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+
+        public:
+            // zeroed and never empty, so a captured pointer stays non-null
+            template<typename T>
+            T* allocate(uint64_t count) {
+                size_t size = static_cast<size_t>(std::max<uint64_t>(count, 1)) * sizeof(T);
+                return reinterpret_cast<T*>(m_blocks.emplace_back(std::make_unique<std::byte[]>(size)).get());
+            }
+
+            void clear() { m_blocks.clear(); };
+        };
+    }
+
+    enum class CaptureArgument : uint8_t {
+        Value,
+        Handle,
+        // an array, bytes or a string with everything reachable from it, or null
+        Pointer,
+        // the handles written by a create or allocate call
+        OutputHandles,
+        // a pointer ApiCapture can not follow, e.g. a struct without CaptureStruct or a callback
+        Unsupported
+    };
+
+    enum class CaptureRecord : uint8_t {
+        FunctionName,
+        Call
+    };
+
+    // Writes every call going through a FunctionTable to a binary stream while capturing, with
+    // GRAPHICS_ENABLE_CAPTURE defined. A function is written as its name once and as a small id afterwards,
+    // so a capture replays against tables of another build. Scalars and handles are stored by value, pointers deeply
+    // with every array, string and pNext chain they reach as described by CaptureStruct. The length of a pointer is
+    // the integer parameter before it, or what the call wrote to the integer pointer before it, or one.
+    // Handles written by create and allocate calls are stored as outputs, so a replay maps them to its own objects.
+    // Memory written through mapped pointers is not captured.
+    // Records are written after the call returned, in host byte order, under a lock shared by all threads.
+    class ApiCapture
+    {
+        static constexpr char s_magic[4] = { 'G', 'W', 'C', 'P' };
+        static constexpr uint32_t s_version = 2;
+
+        static inline std::atomic<bool> s_capturing = false;
+        static inline std::mutex s_mutex;
+        static inline std::ostream* s_stream = nullptr;
+        static inline std::unordered_map<std::string_view, uint32_t> s_functionIds;
+        static inline uint64_t s_callCount = 0;
+
+        template<typename T>
+        static void appendParam(std::vector<uint8_t>& payload, std::string_view function, size_t index,
+            const T& value, std::optional<uint64_t>& count) {
+            using namespace CaptureDetail;
+            size_t start = payload.size();
+            CaptureWriter writer(payload);
+            if constexpr (Handle<T>) {
+                writer.write(CaptureArgument::Handle);
+                writer.element(value);
+                count.reset();
+            }
+            else if constexpr (std::is_pointer_v<T>) {
+                using Pointee = std::remove_pointer_t<T>;
+                using Element = std::remove_cv_t<Pointee>;
+                if constexpr (std::is_function_v<Pointee>) {
+                    writer.unsupported();
+                }
+                else if constexpr (std::is_same_v<Element, VkAllocationCallbacks>) {
+                    // replays use the default allocator
+                    writer.write(CaptureArgument::Pointer);
+                    writer.write(uint8_t(0));
+                }
+                else if constexpr (std::is_same_v<T, const char*>) {
+                    writer.write(CaptureArgument::Pointer);
+                    writer.string(value);
+                }
+                else if constexpr (Handle<Pointee> && !std::is_const_v<Pointee>) {
+                    writer.write(CaptureArgument::OutputHandles);
+                    writer.array(value, getElementCount(function, index, count.value_or(1)));
+                }
+                else if constexpr (std::is_void_v<Element>) {
+                    writer.write(CaptureArgument::Pointer);
+                    writer.bytes(value, getElementCount(function, index, count.value_or(1)));
+                }
+                else if constexpr (!std::is_const_v<Pointee> && (std::is_integral_v<Pointee> || std::is_pointer_v<Pointee>)) {
+                    // a count or pointer written by the call, e.g. of an enumerate or map call
+                    writer.write(CaptureArgument::Pointer);
+                    writer.array(value, 1);
+                    if constexpr (std::is_integral_v<Pointee>)
+                        count = value ? static_cast<uint64_t>(*value) : 0;
+                }
+                else {
+                    writer.write(CaptureArgument::Pointer);
+                    writer.array(value, getElementCount(function, index, count.value_or(1)));
+                    if constexpr (CountsOutputs<Element>) {
+                        if (value)
+                            count = CaptureStruct<Element>::getOutputCount(*value);
+                    }
+                }
+            }
+            else {
+                writer.write(CaptureArgument::Value);
+                writer.element(value);
+                if constexpr (std::is_integral_v<T>)
+                    count = static_cast<uint64_t>(value);
+            }
+
+            if (!writer.isSupported()) {
+                payload.resize(start);
+                CaptureWriter(payload).write(CaptureArgument::Unsupported);
+            }
+        }
+
+        template<typename Ret, typename... Params>
+        static void appendCall(std::vector<uint8_t>& payload, std::string_view function, const Ret* result,
+            const std::tuple<Params...>& params) {
+            CaptureDetail::CaptureWriter writer(payload);
+            if constexpr (std::is_void_v<Ret>) {
+                writer.write(uint32_t(0));
+            }
+            else {
+                writer.write(static_cast<uint32_t>(sizeof(Ret)));
+                writer.write(*result);
+            }
+            [&]<size_t... Is>(std::index_sequence<Is...>) {
+                std::optional<uint64_t> count;
+                (appendParam(payload, function, Is, std::get<Is>(params), count), ...);
+            }(std::index_sequence_for<Params...>{});
+        }
+
+        static void writeRecord(std::string_view name, const std::vector<uint8_t>& payload) {
+            std::lock_guard lock(s_mutex);
+            if (!s_stream)
+                return;
+
+            auto [it, inserted] = s_functionIds.try_emplace(name, static_cast<uint32_t>(s_functionIds.size()));
+            if (inserted) {
+                writeValue(CaptureRecord::FunctionName);
+                writeValue(it->second);
+                writeValue(static_cast<uint32_t>(name.size()));
+                s_stream->write(name.data(), name.size());
+            }
+            writeValue(CaptureRecord::Call);
+            writeValue(it->second);
+            writeValue(static_cast<uint32_t>(payload.size()));
+            s_stream->write(reinterpret_cast<const char*>(payload.data()), payload.size());
+            ++s_callCount;
+        }
+
+        template<typename T>
+        static void writeValue(const T& value) {
+            s_stream->write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+    public:
+        ApiCapture() = delete;
+
+        // the stream has to stay valid until end, it should be opened in binary mode
+        static void begin(std::ostream& stream) {
+            std::lock_guard lock(s_mutex);
+            s_stream = &stream;
+            s_functionIds.clear();
+            s_callCount = 0;
+            s_stream->write(s_magic, sizeof(s_magic));
+            writeValue(s_version);
+            s_capturing.store(true, std::memory_order_release);
+        }
+
+        static void end() {
+            s_capturing.store(false, std::memory_order_release);
+            std::lock_guard lock(s_mutex);
+            if (s_stream)
+                s_stream->flush();
+            s_stream = nullptr;
+        }
+
+        static bool isCapturing() { return s_capturing.load(std::memory_order_relaxed); };
+
+        static uint64_t getCallCount() {
+            std::lock_guard lock(s_mutex);
+            return s_callCount;
+        }
+
+        // calls function and records it with its result, name has to be the Vulkan name of the function
+        template<typename Ret, typename... Params, typename... Args>
+        static Ret invoke(const char* name, Ret(*function)(Params...), Args&&... args) {
+            std::tuple<Params...> params(std::forward<Args>(args)...);
+            thread_local std::vector<uint8_t> payload;
+            payload.clear();
+
+            if constexpr (std::is_void_v<Ret>) {
+                std::apply(function, params);
+                appendCall<Ret>(payload, name, nullptr, params);
+                writeRecord(name, payload);
+            }
+            else {
+                Ret result = std::apply(function, params);
+                appendCall(payload, name, &result, params);
+                writeRecord(name, payload);
+                return result;
+            }
+        }
+
+        static constexpr std::string_view getMagic() { return { s_magic, sizeof(s_magic) }; };
+        static constexpr uint32_t getVersion() { return s_version; };
+    };
+
+    struct ReplayStatistics {
+        uint64_t replayedCalls = 0;
+        // functions no table knows or is loaded for, or whose arguments were not captured completely
+        uint64_t unsupportedCalls = 0;
+        // calls referencing a captured handle without a mapping
+        uint64_t unmappedCalls = 0;
+        // handles written by replayed calls and mapped to the captured ones
+        uint64_t createdHandles = 0;
+    };
+
+    // Issues the calls of a capture again through FunctionTables, e.g. an InstanceFunctionTable and a
+    // DeviceFunctionTable, looking every function up in the tables in order. Arguments are rebuilt from the capture
+    // with the replayed handles put in place of the captured ones: handles written by replayed create and allocate
+    // calls are mapped automatically, others like the instance through mapHandle or setDefaultHandle. For a replay
+    // in the capturing process setIdentityMapping keeps handles as they are. Calls of functions that are not loaded
+    // are skipped, a table can be loaded from the create callback, e.g. once vkCreateDevice was replayed.
+    template<typename... Tables>
+    class ApiReplayer
+    {
+        template<size_t index>
+        using TableAt = std::tuple_element_t<index, std::tuple<Tables...>>;
+
+        enum class ReplayResult { Replayed, Unsupported, Unmapped };
+
+        class Reader;
+        using ReplayFunction = ReplayResult(*)(ApiReplayer&, std::string_view, Reader&);
+
+        struct FunctionEntry {
+            std::string name;
+            ReplayFunction replay = nullptr;
+        };
+
+        // handles the replayed call writes, mapped once it returned
+        struct PendingOutput {
+            uint64_t captured;
+            const void* storage;
+            uint64_t(*read)(const void*);
+        };
+
+        // Decodes what CaptureWriter encoded into the arena, translating every handle it reaches.
+        class Reader {
+            const uint8_t* m_data;
+            size_t m_remaining;
+            ApiReplayer& m_replayer;
+            bool m_complete = true;
+            bool m_mapped = true;
+
+        public:
+            Reader(const uint8_t* data, size_t size, ApiReplayer& replayer)
+                : m_data(data), m_remaining(size), m_replayer(replayer) {};
+
+            bool isComplete() const { return m_complete; };
+            bool isMapped() const { return m_mapped; };
+
+            bool raw(void* data, size_t size) {
+                if (!m_complete || m_remaining < size) {
+                    m_complete = false;
+                    return false;
+                }
+                std::memcpy(data, m_data, size);
+                m_data += size;
+                m_remaining -= size;
+                return true;
+            }
+
+            template<typename T>
+            bool read(T& value) {
+                return raw(&value, sizeof(T));
+            }
+
+            bool skip(size_t size) {
+                if (!m_complete || m_remaining < size) {
+                    m_complete = false;
+                    return false;
+                }
+                m_data += size;
+                m_remaining -= size;
+                return true;
+            }
+
+            template<typename T>
+            void element(T& value) {
+                if constexpr (std::is_same_v<T, const char*>) {
+                    string(value);
+                }
+                else {
+                    if (!read(value))
+                        return;
+                    if constexpr (CaptureDetail::Handle<T>)
+                        handle(value);
+                    else if constexpr (std::is_class_v<T>)
+                        member(value);
+                }
+            }
+
+            template<typename H>
+            void handle(H& value) {
+                m_mapped = m_replayer.translate(value) && m_mapped;
+            }
+
+            // reads the count of a present pointer, counts beyond the payload are corrupt
+            bool readCount(uint64_t& count) {
+                uint8_t present = 0;
+                if (!read(present) || !present || !read(count))
+                    return false;
+                if (count > m_remaining) {
+                    m_complete = false;
+                    return false;
+                }
+                return true;
+            }
+
+            template<typename T, typename Count>
+            void array(T*& pointer, Count) {
+                pointer = nullptr;
+                uint64_t count = 0;
+                if (!readCount(count))
+                    return;
+                auto elements = m_replayer.m_arena.template allocate<std::remove_const_t<T>>(count);
+                for (uint64_t i = 0; i < count; ++i)
+                    element(elements[i]);
+                pointer = elements;
+            }
+
+            template<typename T, typename Size>
+            void bytes(T*& pointer, Size) {
+                pointer = nullptr;
+                uint64_t size = 0;
+                if (!readCount(size))
+                    return;
+                auto storage = m_replayer.m_arena.template allocate<std::byte>(size);
+                raw(storage, static_cast<size_t>(size));
+                pointer = static_cast<T*>(static_cast<void*>(storage));
+            }
+
+            void string(const char*& pointer) {
+                pointer = nullptr;
+                uint64_t length = 0;
+                if (!readCount(length))
+                    return;
+                auto characters = m_replayer.m_arena.template allocate<char>(length + 1);
+                raw(characters, static_cast<size_t>(length));
+                pointer = characters;
+            }
+
+            template<typename T>
+            void chain(T*& pNext) {
+                pNext = nullptr;
+                VkStructureType type = VK_STRUCTURE_TYPE_MAX_ENUM;
+                if (!read(type) || type == VK_STRUCTURE_TYPE_MAX_ENUM)
+                    return;
+                bool known = CaptureDetail::visitChainedType(type, [&]<typename S>(S*) {
+                    auto chained = m_replayer.m_arena.template allocate<S>(1);
+                    element(*chained);
+                    pNext = chained;
+                });
+                if (!known)
+                    m_complete = false;
+            }
+
+            template<typename S>
+            void member(S& value) {
+                if constexpr (CaptureStruct<S>::s_supported)
+                    CaptureStruct<S>::visit(*this, value);
+                else
+                    m_complete = false;
+            }
+
+            // captured handles go into the storage the call overwrites, they are mapped to its results afterwards
+            template<typename H>
+            void outputs(H*& pointer, std::vector<PendingOutput>& pending) {
+                pointer = nullptr;
+                uint64_t count = 0;
+                if (!readCount(count))
+                    return;
+                auto handles = m_replayer.m_arena.template allocate<H>(count);
+                for (uint64_t i = 0; i < count; ++i) {
+                    if (!read(handles[i]))
+                        return;
+                    pending.push_back({ toValue(handles[i]), &handles[i], [](const void* storage) {
+                        return toValue(*static_cast<const H*>(storage));
+                    } });
+                }
+                pointer = handles;
+            }
+
+            void unsupported() { m_complete = false; };
+        };
+
+        std::tuple<const Tables&...> m_tables;
+        std::unordered_map<uint64_t, uint64_t> m_handles;
+        std::unordered_map<std::type_index, uint64_t> m_defaultHandles;
+        bool m_identityMapping = false;
+        std::vector<FunctionEntry> m_functions;
+        CaptureDetail::CaptureArena m_arena;
+        std::vector<PendingOutput> m_pendingOutputs;
+        std::function<void(std::string_view, uint64_t)> m_createCallback;
+        ReplayStatistics m_statistics;
+
+    public:
+        explicit ApiReplayer(const Tables&... tables) : m_tables(tables...) {};
+
+        void mapHandle(uint64_t captured, uint64_t replayed) { m_handles[captured] = replayed; };
+        void setIdentityMapping(bool identityMapping) { m_identityMapping = identityMapping; };
+
+        // used for captured handles of this type without a mapping, e.g. the instance the capture was made with
+        template<typename H>
+        void setDefaultHandle(H handle) { m_defaultHandles[std::type_index(typeid(H))] = toValue(handle); }
+
+        // called with every handle a replayed call wrote, after it was mapped
+        void setCreateCallback(std::function<void(std::string_view function, uint64_t handle)> callback) {
+            m_createCallback = std::move(callback);
+        }
+
+        // returns false when the stream is not a capture or ends inside a record
+        bool replay(std::istream& stream) {
+            char magic[4];
+            uint32_t version = 0;
+            stream.read(magic, sizeof(magic));
+            stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+            if (!stream || std::string_view(magic, sizeof(magic)) != ApiCapture::getMagic() ||
+                version != ApiCapture::getVersion())
+                return false;
+
+            std::vector<uint8_t> payload;
+            m_functions.clear();
+            while (true) {
+                CaptureRecord record;
+                uint32_t id = 0;
+                uint32_t size = 0;
+                if (!stream.read(reinterpret_cast<char*>(&record), sizeof(record)))
+                    return stream.eof();
+                stream.read(reinterpret_cast<char*>(&id), sizeof(id));
+                stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+                payload.resize(size);
+                stream.read(reinterpret_cast<char*>(payload.data()), size);
+                if (!stream)
+                    return false;
+
+                if (record == CaptureRecord::FunctionName) {
+                    std::string_view name(reinterpret_cast<const char*>(payload.data()), payload.size());
+                    if (m_functions.size() <= id)
+                        m_functions.resize(id + 1);
+                    m_functions[id] = { std::string(name), findFunction(name) };
+                    continue;
+                }
+
+                ReplayResult result = ReplayResult::Unsupported;
+                if (id < m_functions.size() && m_functions[id].replay) {
+                    Reader reader(payload.data(), payload.size(), *this);
+                    result = m_functions[id].replay(*this, m_functions[id].name, reader);
+                }
+                m_arena.clear();
+                m_pendingOutputs.clear();
+                switch (result) {
+                case ReplayResult::Replayed: ++m_statistics.replayedCalls; break;
+                case ReplayResult::Unsupported: ++m_statistics.unsupportedCalls; break;
+                case ReplayResult::Unmapped: ++m_statistics.unmappedCalls; break;
+                }
+            }
+        }
+
+        const ReplayStatistics& getStatistics() const { return m_statistics; };
+        void resetStatistics() { m_statistics = {}; };
+
+    private:
+        template<typename H>
+        static uint64_t toValue(H handle) {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+        }
+
+        template<typename H>
+        bool translate(H& handle) {
+            uint64_t captured = toValue(handle);
+            if (captured == 0 || m_identityMapping)
+                return true;
+
+            uint64_t replayed = 0;
+            if (auto found = m_handles.find(captured); found != m_handles.end())
+                replayed = found->second;
+            else if (auto fallback = m_defaultHandles.find(std::type_index(typeid(H))); fallback != m_defaultHandles.end())
+                replayed = fallback->second;
+            handle = reinterpret_cast<H>(static_cast<uintptr_t>(replayed));
+            return replayed != 0;
+        }
+
+        static ReplayFunction findFunction(std::string_view name) {
+            ReplayFunction function = nullptr;
+            [&]<size_t... Is>(std::index_sequence<Is...>) {
+                ((function = function ? function : findTableFunction<Is>(name)), ...);
+            }(std::index_sequence_for<Tables...>{});
+            return function;
+        }
+
+        template<size_t tableIndex>
+        static ReplayFunction findTableFunction(std::string_view name) {
+            using FunctionEnum = typename TableAt<tableIndex>::FunctionEnumType;
+            static constexpr size_t count = static_cast<size_t>(FunctionEnum::Num);
+            static constexpr auto names = TableAt<tableIndex>::getNames();
+            static constexpr auto functions = []<size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<ReplayFunction, count>{ &replayCall<tableIndex, static_cast<FunctionEnum>(Is)>... };
+            }(std::make_index_sequence<count>{});
+
+            for (size_t i = 0; i < count; ++i)
+                if (name == names[i])
+                    return functions[i];
+            return nullptr;
+        }
+
+        template<typename T>
+        bool readParam(Reader& reader, T& value) {
+            using namespace CaptureDetail;
+            CaptureArgument argument;
+            if (!reader.read(argument))
+                return false;
+
+            if constexpr (Handle<T>) {
+                if (argument != CaptureArgument::Handle)
+                    return false;
+                reader.element(value);
+            }
+            else if constexpr (std::is_pointer_v<T>) {
+                using Pointee = std::remove_pointer_t<T>;
+                using Element = std::remove_cv_t<Pointee>;
+                if constexpr (std::is_function_v<Pointee>) {
+                    return false;
+                }
+                else if constexpr (Handle<Pointee> && !std::is_const_v<Pointee>) {
+                    if (argument != CaptureArgument::OutputHandles)
+                        return false;
+                    reader.outputs(value, m_pendingOutputs);
+                }
+                else {
+                    if (argument != CaptureArgument::Pointer)
+                        return false;
+                    if constexpr (std::is_same_v<Element, VkAllocationCallbacks>) {
+                        uint8_t present = 0;
+                        value = nullptr;
+                        return reader.read(present) && !present;
+                    }
+                    else if constexpr (std::is_same_v<T, const char*>)
+                        reader.string(value);
+                    else if constexpr (std::is_void_v<Element>)
+                        reader.bytes(value, 0);
+                    else
+                        reader.array(value, 0);
+                }
+            }
+            else {
+                if (argument != CaptureArgument::Value)
+                    return false;
+                reader.element(value);
+            }
+            return reader.isComplete();
+        }
+
+        void mapOutputs(std::string_view function) {
+            for (const auto& output : m_pendingOutputs) {
+                uint64_t replayed = output.read(output.storage);
+                if (output.captured == 0 || replayed == 0)
+                    continue;
+                m_handles[output.captured] = replayed;
+                ++m_statistics.createdHandles;
+                if (m_createCallback)
+                    m_createCallback(function, replayed);
+            }
+        }
+
+        template<size_t tableIndex, typename TableAt<tableIndex>::FunctionEnumType func>
+        static ReplayResult replayCall(ApiReplayer& replayer, std::string_view name, Reader& reader) {
+            using Table = TableAt<tableIndex>;
+            using Function = CaptureDetail::CapturedFunction<typename Table::template FunctionType<func>>;
+            const Table& table = std::get<tableIndex>(replayer.m_tables);
+            if (!table.template isLoaded<func>())
+                return ReplayResult::Unsupported;
+
+            uint32_t resultSize = 0;
+            if (!reader.read(resultSize) || !reader.skip(resultSize))
+                return ReplayResult::Unsupported;
+
+            typename Function::ParamTypes params{};
+            bool complete = std::apply([&](auto&... values) {
+                return (replayer.readParam(reader, values) && ...);
+            }, params);
+            if (!complete)
+                return ReplayResult::Unsupported;
+            if (!reader.isMapped())
+                return ReplayResult::Unmapped;
+
+            std::apply(table.template get<func>(), params);
+            replayer.mapOutputs(name);
+            return ReplayResult::Replayed;
+        }
+    };
+}
@@ -0,0 +1,851 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace Graphics {
+
+    namespace CaptureDetail {
+
+        template<typename T>
+        concept Complete = requires { sizeof(T); };
+
+        // Vulkan handles are pointers to types that are never defined, dispatchable or not
+        template<typename T>
+        concept Handle = std::is_pointer_v<T> &&
+            !std::is_void_v<std::remove_cv_t<std::remove_pointer_t<T>>> &&
+            !std::is_function_v<std::remove_pointer_t<T>> &&
+            !Complete<std::remove_pointer_t<T>>;
+
+        template<typename T>
+        concept Chained = requires(T value) { value.sType; value.pNext; };
+    }
+
+    // Describes what ApiCapture has to store of a struct besides its bytes. visit is called with a writer while
+    // capturing and with a reader while replaying, the reader translates handles and points every visited pointer
+    // at the replayed copy of its data, so every pointer member has to be visited or ignored.
+    // Structs without sType are taken as plain values unless specialized, structs with sType are only captured
+    // when they are specialized. Pointers Vulkan ignores, e.g. the infos of other descriptor types, are not followed.
+    template<typename T>
+    struct CaptureStruct {
+        static constexpr bool s_supported = !CaptureDetail::Chained<T>;
+
+        template<typename Visitor, typename S>
+        static void visit(Visitor&, S&) {}
+    };
+
+    struct CaptureValueStruct {
+        static constexpr bool s_supported = true;
+    };
+
+    // structs that point to nothing but their pNext chain
+    template<VkStructureType type>
+    struct CaptureChainedStruct {
+        static constexpr bool s_supported = true;
+        static constexpr VkStructureType s_type = type;
+
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+        }
+    };
+
+    // a callback can not be replayed
+    template<VkStructureType type>
+    struct CaptureUnsupportedStruct {
+        static constexpr bool s_supported = false;
+        static constexpr VkStructureType s_type = type;
+
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S&) {
+            visitor.unsupported();
+        }
+    };
+
+    template<> struct CaptureStruct<VkPhysicalDeviceProperties2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceFeatures2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceMemoryProperties2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkan11Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkan11Properties> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkan12Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkan12Properties> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkan13Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkan13Properties> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES> {};
+    template<> struct CaptureStruct<VkPhysicalDevice16BitStorageFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDevice8BitStorageFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceMultiviewFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceDescriptorIndexingFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceScalarBlockLayoutFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SCALAR_BLOCK_LAYOUT_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVulkanMemoryModelFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_MEMORY_MODEL_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceImagelessFramebufferFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceUniformBufferStandardLayoutFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_UNIFORM_BUFFER_STANDARD_LAYOUT_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderSubgroupExtendedTypesFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_SUBGROUP_EXTENDED_TYPES_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceSeparateDepthStencilLayoutsFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SEPARATE_DEPTH_STENCIL_LAYOUTS_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceHostQueryResetFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceTimelineSemaphoreFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceBufferDeviceAddressFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceImageRobustnessFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_ROBUSTNESS_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceInlineUniformBlockFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDevicePipelineCreationCacheControlFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_CREATION_CACHE_CONTROL_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDevicePrivateDataFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRIVATE_DATA_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderDemoteToHelperInvocationFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DEMOTE_TO_HELPER_INVOCATION_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderTerminateInvocationFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_TERMINATE_INVOCATION_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceSubgroupSizeControlFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceSynchronization2Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceZeroInitializeWorkgroupMemoryFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ZERO_INITIALIZE_WORKGROUP_MEMORY_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceDynamicRenderingFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderIntegerDotProductFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_INTEGER_DOT_PRODUCT_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceMaintenance4Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_4_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceMeshShaderFeaturesEXT> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceRobustness2FeaturesEXT> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ROBUSTNESS_2_FEATURES_EXT> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceVariablePointersFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VARIABLE_POINTERS_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceProtectedMemoryFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROTECTED_MEMORY_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceSamplerYcbcrConversionFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SAMPLER_YCBCR_CONVERSION_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderDrawParametersFeatures> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderAtomicInt64Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_ATOMIC_INT64_FEATURES> {};
+    template<> struct CaptureStruct<VkPhysicalDeviceShaderFloat16Int8Features> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES> {};
+    template<> struct CaptureStruct<VkQueueFamilyProperties2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_QUEUE_FAMILY_PROPERTIES_2> {};
+    template<> struct CaptureStruct<VkMemoryRequirements2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2> {};
+    template<> struct CaptureStruct<VkMemoryDedicatedRequirements> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS> {};
+    template<> struct CaptureStruct<VkSparseImageMemoryRequirements2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SPARSE_IMAGE_MEMORY_REQUIREMENTS_2> {};
+    template<> struct CaptureStruct<VkDeviceQueueInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEVICE_QUEUE_INFO_2> {};
+    template<> struct CaptureStruct<VkSamplerCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkSemaphoreCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkSemaphoreTypeCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkFenceCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_FENCE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkCommandPoolCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkMemoryAllocateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO> {};
+    template<> struct CaptureStruct<VkMemoryAllocateFlagsInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO> {};
+    template<> struct CaptureStruct<VkQueryPoolCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkMemoryBarrier> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MEMORY_BARRIER> {};
+    template<> struct CaptureStruct<VkMemoryBarrier2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MEMORY_BARRIER_2> {};
+    template<> struct CaptureStruct<VkPipelineInputAssemblyStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkPipelineTessellationStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkPipelineRasterizationStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkPipelineDepthStencilStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO> {};
+    template<> struct CaptureStruct<VkDebugUtilsMessengerCreateInfoEXT> : CaptureUnsupportedStruct<VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT> {};
+
+    template<>
+    struct CaptureStruct<VkApplicationInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_APPLICATION_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.string(value.pApplicationName);
+            visitor.string(value.pEngineName);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkInstanceCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pApplicationInfo, 1);
+            visitor.array(value.ppEnabledLayerNames, value.enabledLayerCount);
+            visitor.array(value.ppEnabledExtensionNames, value.enabledExtensionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDeviceQueueCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pQueuePriorities, value.queueCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDeviceCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pQueueCreateInfos, value.queueCreateInfoCount);
+            visitor.array(value.ppEnabledLayerNames, value.enabledLayerCount);
+            visitor.array(value.ppEnabledExtensionNames, value.enabledExtensionCount);
+            visitor.array(value.pEnabledFeatures, 1);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkBufferCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pQueueFamilyIndices,
+                value.sharingMode == VK_SHARING_MODE_CONCURRENT ? value.queueFamilyIndexCount : 0);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkImageCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pQueueFamilyIndices,
+                value.sharingMode == VK_SHARING_MODE_CONCURRENT ? value.queueFamilyIndexCount : 0);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSwapchainCreateInfoKHR> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.surface);
+            visitor.array(value.pQueueFamilyIndices,
+                value.imageSharingMode == VK_SHARING_MODE_CONCURRENT ? value.queueFamilyIndexCount : 0);
+            visitor.handle(value.oldSwapchain);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkImageViewCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.image);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkBufferViewCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.buffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkShaderModuleCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.bytes(value.pCode, value.codeSize);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineCacheCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.bytes(value.pInitialData, value.initialDataSize);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSubpassDescription> : CaptureValueStruct {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.array(value.pInputAttachments, value.inputAttachmentCount);
+            visitor.array(value.pColorAttachments, value.colorAttachmentCount);
+            visitor.array(value.pResolveAttachments, value.colorAttachmentCount);
+            visitor.array(value.pDepthStencilAttachment, 1);
+            visitor.array(value.pPreserveAttachments, value.preserveAttachmentCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkRenderPassCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pAttachments, value.attachmentCount);
+            visitor.array(value.pSubpasses, value.subpassCount);
+            visitor.array(value.pDependencies, value.dependencyCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkFramebufferCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.renderPass);
+            // imageless framebuffers take their attachments at begin
+            visitor.array(value.pAttachments,
+                (value.flags & VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT) ? 0 : value.attachmentCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDescriptorSetLayoutBinding> : CaptureValueStruct {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            bool samplers = value.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER ||
+                value.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            visitor.array(value.pImmutableSamplers, samplers ? value.descriptorCount : 0);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDescriptorSetLayoutCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pBindings, value.bindingCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineLayoutCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pSetLayouts, value.setLayoutCount);
+            visitor.array(value.pPushConstantRanges, value.pushConstantRangeCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDescriptorPoolCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pPoolSizes, value.poolSizeCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDescriptorSetAllocateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.descriptorPool);
+            visitor.array(value.pSetLayouts, value.descriptorSetCount);
+        }
+
+        // length of the handle array the allocate call writes
+        static uint64_t getOutputCount(const VkDescriptorSetAllocateInfo& value) { return value.descriptorSetCount; }
+    };
+
+    template<>
+    struct CaptureStruct<VkCommandBufferAllocateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.commandPool);
+        }
+
+        static uint64_t getOutputCount(const VkCommandBufferAllocateInfo& value) { return value.commandBufferCount; }
+    };
+
+    template<>
+    struct CaptureStruct<VkDescriptorImageInfo> : CaptureValueStruct {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.handle(value.sampler);
+            visitor.handle(value.imageView);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDescriptorBufferInfo> : CaptureValueStruct {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.handle(value.buffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkWriteDescriptorSet> : CaptureChainedStruct<VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.dstSet);
+
+            uint32_t imageCount = 0;
+            uint32_t bufferCount = 0;
+            uint32_t texelBufferCount = 0;
+            switch (value.descriptorType) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                imageCount = value.descriptorCount;
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                bufferCount = value.descriptorCount;
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                texelBufferCount = value.descriptorCount;
+                break;
+            default:
+                // the data of other types lives in the pNext chain
+                break;
+            }
+            visitor.array(value.pImageInfo, imageCount);
+            visitor.array(value.pBufferInfo, bufferCount);
+            visitor.array(value.pTexelBufferView, texelBufferCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCopyDescriptorSet> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcSet);
+            visitor.handle(value.dstSet);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSpecializationInfo> : CaptureValueStruct {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.array(value.pMapEntries, value.mapEntryCount);
+            visitor.bytes(value.pData, value.dataSize);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineShaderStageCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.module);
+            visitor.string(value.pName);
+            visitor.array(value.pSpecializationInfo, 1);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineVertexInputStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pVertexBindingDescriptions, value.vertexBindingDescriptionCount);
+            visitor.array(value.pVertexAttributeDescriptions, value.vertexAttributeDescriptionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineViewportStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pViewports, value.viewportCount);
+            visitor.array(value.pScissors, value.scissorCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineMultisampleStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            // one 32 bit word per 32 samples
+            visitor.array(value.pSampleMask, (static_cast<uint32_t>(value.rasterizationSamples) + 31) / 32);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineColorBlendStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pAttachments, value.attachmentCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineDynamicStateCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pDynamicStates, value.dynamicStateCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPipelineRenderingCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pColorAttachmentFormats, value.colorAttachmentCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkGraphicsPipelineCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pStages, value.stageCount);
+            visitor.array(value.pVertexInputState, 1);
+            visitor.array(value.pInputAssemblyState, 1);
+            visitor.array(value.pTessellationState, 1);
+            visitor.array(value.pViewportState, 1);
+            visitor.array(value.pRasterizationState, 1);
+            visitor.array(value.pMultisampleState, 1);
+            visitor.array(value.pDepthStencilState, 1);
+            visitor.array(value.pColorBlendState, 1);
+            visitor.array(value.pDynamicState, 1);
+            visitor.handle(value.layout);
+            visitor.handle(value.renderPass);
+            visitor.handle(value.basePipelineHandle);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkComputePipelineCreateInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.member(value.stage);
+            visitor.handle(value.layout);
+            visitor.handle(value.basePipelineHandle);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkMappedMemoryRange> : CaptureChainedStruct<VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.memory);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkBufferMemoryBarrier> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.buffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkImageMemoryBarrier> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.image);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkBufferMemoryBarrier2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.buffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkImageMemoryBarrier2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.image);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDependencyInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEPENDENCY_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pMemoryBarriers, value.memoryBarrierCount);
+            visitor.array(value.pBufferMemoryBarriers, value.bufferMemoryBarrierCount);
+            visitor.array(value.pImageMemoryBarriers, value.imageMemoryBarrierCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCommandBufferInheritanceInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.renderPass);
+            visitor.handle(value.framebuffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCommandBufferBeginInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pInheritanceInfo, 1);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkRenderPassBeginInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.renderPass);
+            visitor.handle(value.framebuffer);
+            visitor.array(value.pClearValues, value.clearValueCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkRenderingAttachmentInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.imageView);
+            visitor.handle(value.resolveImageView);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkRenderingInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_RENDERING_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pColorAttachments, value.colorAttachmentCount);
+            visitor.array(value.pDepthAttachment, 1);
+            visitor.array(value.pStencilAttachment, 1);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSubmitInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SUBMIT_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pWaitSemaphores, value.waitSemaphoreCount);
+            visitor.array(value.pWaitDstStageMask, value.waitSemaphoreCount);
+            visitor.array(value.pCommandBuffers, value.commandBufferCount);
+            visitor.array(value.pSignalSemaphores, value.signalSemaphoreCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkTimelineSemaphoreSubmitInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pWaitSemaphoreValues, value.waitSemaphoreValueCount);
+            visitor.array(value.pSignalSemaphoreValues, value.signalSemaphoreValueCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSemaphoreSubmitInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.semaphore);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCommandBufferSubmitInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.commandBuffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSubmitInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SUBMIT_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pWaitSemaphoreInfos, value.waitSemaphoreInfoCount);
+            visitor.array(value.pCommandBufferInfos, value.commandBufferInfoCount);
+            visitor.array(value.pSignalSemaphoreInfos, value.signalSemaphoreInfoCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSemaphoreWaitInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pSemaphores, value.semaphoreCount);
+            visitor.array(value.pValues, value.semaphoreCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkSemaphoreSignalInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.semaphore);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPresentIdKHR> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PRESENT_ID_KHR> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pPresentIds, value.swapchainCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkPresentInfoKHR> : CaptureChainedStruct<VK_STRUCTURE_TYPE_PRESENT_INFO_KHR> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pWaitSemaphores, value.waitSemaphoreCount);
+            visitor.array(value.pSwapchains, value.swapchainCount);
+            visitor.array(value.pImageIndices, value.swapchainCount);
+            // written by the call, replayed into a copy
+            visitor.array(value.pResults, value.swapchainCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDebugUtilsLabelEXT> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.string(value.pLabelName);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkBufferDeviceAddressInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.buffer);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDeviceMemoryOpaqueCaptureAddressInfo> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEVICE_MEMORY_OPAQUE_CAPTURE_ADDRESS_INFO> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.memory);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDeviceBufferMemoryRequirements> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pCreateInfo, 1);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkDeviceImageMemoryRequirements> : CaptureChainedStruct<VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.array(value.pCreateInfo, 1);
+        }
+    };
+
+    // the region structs of the copy commands only chain
+    template<> struct CaptureStruct<VkBufferCopy2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_COPY_2> {};
+    template<> struct CaptureStruct<VkImageCopy2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_COPY_2> {};
+    template<> struct CaptureStruct<VkBufferImageCopy2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2> {};
+    template<> struct CaptureStruct<VkImageBlit2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_BLIT_2> {};
+    template<> struct CaptureStruct<VkImageResolve2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_IMAGE_RESOLVE_2> {};
+
+    template<>
+    struct CaptureStruct<VkCopyBufferInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcBuffer);
+            visitor.handle(value.dstBuffer);
+            visitor.array(value.pRegions, value.regionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCopyImageInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcImage);
+            visitor.handle(value.dstImage);
+            visitor.array(value.pRegions, value.regionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCopyBufferToImageInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COPY_BUFFER_TO_IMAGE_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcBuffer);
+            visitor.handle(value.dstImage);
+            visitor.array(value.pRegions, value.regionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkCopyImageToBufferInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_COPY_IMAGE_TO_BUFFER_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcImage);
+            visitor.handle(value.dstBuffer);
+            visitor.array(value.pRegions, value.regionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkBlitImageInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_BLIT_IMAGE_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcImage);
+            visitor.handle(value.dstImage);
+            visitor.array(value.pRegions, value.regionCount);
+        }
+    };
+
+    template<>
+    struct CaptureStruct<VkResolveImageInfo2> : CaptureChainedStruct<VK_STRUCTURE_TYPE_RESOLVE_IMAGE_INFO_2> {
+        template<typename Visitor, typename S>
+        static void visit(Visitor& visitor, S& value) {
+            visitor.chain(value.pNext);
+            visitor.handle(value.srcImage);
+            visitor.handle(value.dstImage);
+            visitor.array(value.pRegions, value.regionCount);
+        }
+    };
+
+    // every struct that may appear in a pNext chain, looked up by sType
+    using CaptureChainedStructs = std::tuple<
+        VkPhysicalDeviceProperties2, VkPhysicalDeviceFeatures2, VkPhysicalDeviceMemoryProperties2,
+        VkPhysicalDeviceVulkan11Features, VkPhysicalDeviceVulkan11Properties, VkPhysicalDeviceVulkan12Features,
+        VkPhysicalDeviceVulkan12Properties, VkPhysicalDeviceVulkan13Features, VkPhysicalDeviceVulkan13Properties,
+        VkPhysicalDevice16BitStorageFeatures, VkPhysicalDevice8BitStorageFeatures, VkPhysicalDeviceMultiviewFeatures,
+        VkPhysicalDeviceDescriptorIndexingFeatures, VkPhysicalDeviceScalarBlockLayoutFeatures,
+        VkPhysicalDeviceVulkanMemoryModelFeatures, VkPhysicalDeviceImagelessFramebufferFeatures,
+        VkPhysicalDeviceUniformBufferStandardLayoutFeatures, VkPhysicalDeviceShaderSubgroupExtendedTypesFeatures,
+        VkPhysicalDeviceSeparateDepthStencilLayoutsFeatures, VkPhysicalDeviceHostQueryResetFeatures,
+        VkPhysicalDeviceTimelineSemaphoreFeatures, VkPhysicalDeviceBufferDeviceAddressFeatures,
+        VkPhysicalDeviceImageRobustnessFeatures, VkPhysicalDeviceInlineUniformBlockFeatures,
+        VkPhysicalDevicePipelineCreationCacheControlFeatures, VkPhysicalDevicePrivateDataFeatures,
+        VkPhysicalDeviceShaderDemoteToHelperInvocationFeatures, VkPhysicalDeviceShaderTerminateInvocationFeatures,
+        VkPhysicalDeviceSubgroupSizeControlFeatures, VkPhysicalDeviceSynchronization2Features,
+        VkPhysicalDeviceZeroInitializeWorkgroupMemoryFeatures, VkPhysicalDeviceDynamicRenderingFeatures,
+        VkPhysicalDeviceShaderIntegerDotProductFeatures, VkPhysicalDeviceMaintenance4Features,
+        VkPhysicalDeviceMeshShaderFeaturesEXT, VkPhysicalDeviceRobustness2FeaturesEXT,
+        VkPhysicalDeviceVariablePointersFeatures, VkPhysicalDeviceProtectedMemoryFeatures,
+        VkPhysicalDeviceSamplerYcbcrConversionFeatures, VkPhysicalDeviceShaderDrawParametersFeatures,
+        VkPhysicalDeviceShaderAtomicInt64Features, VkPhysicalDeviceShaderFloat16Int8Features,
+        VkMemoryDedicatedRequirements, VkMemoryAllocateFlagsInfo, VkSemaphoreTypeCreateInfo,
+        VkTimelineSemaphoreSubmitInfo, VkPipelineRenderingCreateInfo, VkPresentIdKHR>;
+}
@@ -44,58 +44,78 @@
 #define GRAPHICS_API_ATTR VKAPI_ATTR
 #define GRAPHICS_API_CALL VKAPI_CALL
 #define GRAPHICS_API_PTR  VKAPI_PTR
-#define GRAPHICS_VERIFY(condition, message) { \
-    auto __LOCATION_VARIABLE__ = std::source_location::current(); \
-    Graphics::verify(condition, message, \
-        __LOCATION_VARIABLE__.function_name(), \
-        __LOCATION_VARIABLE__.file_name(), \
-        __LOCATION_VARIABLE__.line(), \
-        __LOCATION_VARIABLE__.column()); \
-}
-
-#define GRAPHICS_VERIFY_RESULT(result, message) { \
-if constexpr (std::convertible_to<decltype(result), Graphics::Result>) { \
-    GRAPHICS_VERIFY(static_cast<Graphics::Result>(result) == Graphics::Result::Success, \
-        std::string(message) + ": " + ResultManager::getResultMessage(result).data()); \
-} \
-else if constexpr (std::convertible_to<decltype(result), vk::Result>) { \
-    \
-    GRAPHICS_VERIFY(static_cast<vk::Result>(result) == vk::Result::eSuccess, \
-        std::string(message) + ": " + ResultManager::getResultMessage(result).data()); \
-} \
-else { \
-    GRAPHICS_VERIFY(static_cast<uint32_t>(result) == VK_SUCCESS, \
-        std::string(message) + ": " + ResultManager::getResultMessage(result).data()); \
-} \
-} \
 
 #if defined(GRAPHICS_NO_VERIFY) && defined(GRAPHICS_ALWAYS_VERIFY)
 #error "GRAPHICS_NO_VERIFY and GRAPHICS_ALWAYS_VERIFY cannot be defined at the same time"
 #endif
 
-#if !defined(_DEBUG) && !defined(NODEBUG) 
-#define _DEBUG
+// Verification levels, GRAPHICS_VERIFY_LEVEL may be defined to one of them, otherwise builds without NDEBUG
+// verify fully and builds with it not at all.
+// Off compiles every check away, conditions and messages are not evaluated.
+// Cheap evaluates the conditions of GRAPHICS_VERIFY and GRAPHICS_VERIFY_RESULT.
+// Full adds the checks done per call, e.g. whether a function was loaded in FunctionTable::execute, and GRAPHICS_VERIFY_FULL.
+// Messages are only built when a check failed.
+#define GRAPHICS_VERIFY_LEVEL_OFF 0
+#define GRAPHICS_VERIFY_LEVEL_CHEAP 1
+#define GRAPHICS_VERIFY_LEVEL_FULL 2
+
+#ifndef GRAPHICS_VERIFY_LEVEL
+#if defined(GRAPHICS_NO_VERIFY)
+#define GRAPHICS_VERIFY_LEVEL GRAPHICS_VERIFY_LEVEL_OFF
+#elif !defined(NDEBUG) || defined(GRAPHICS_ALWAYS_VERIFY)
+#define GRAPHICS_VERIFY_LEVEL GRAPHICS_VERIFY_LEVEL_FULL
+#else
+#define GRAPHICS_VERIFY_LEVEL GRAPHICS_VERIFY_LEVEL_OFF
+#endif
+#endif
+
+#if GRAPHICS_VERIFY_LEVEL >= GRAPHICS_VERIFY_LEVEL_CHEAP
+#define GRAPHICS_VERIFY(condition, message) do { \
+    if (!(condition)) [[unlikely]] \
+        Graphics::verifyFailed(message, std::source_location::current()); \
+} while (false)
+
+#define GRAPHICS_VERIFY_RESULT(result, message) do { \
+    if (!Graphics::isSuccess(result)) [[unlikely]] \
+        Graphics::verifyFailed(std::string(message) + ": " + ResultManager::getResultMessage(result).data(), \
+            std::source_location::current()); \
+} while (false)
+#else
+// sizeof keeps the operands referenced without evaluating them
+#define GRAPHICS_VERIFY(condition, message) do { (void)sizeof(!(condition)); (void)sizeof(message); } while (false)
+#define GRAPHICS_VERIFY_RESULT(result, message) do { (void)sizeof(result); (void)sizeof(message); } while (false)
+#endif
+
+#if GRAPHICS_VERIFY_LEVEL >= GRAPHICS_VERIFY_LEVEL_FULL
+#define GRAPHICS_VERIFY_FULL(condition, message) GRAPHICS_VERIFY(condition, message)
+#else
+#define GRAPHICS_VERIFY_FULL(condition, message) do { (void)sizeof(!(condition)); (void)sizeof(message); } while (false)
 #endif
 
 namespace Graphics {
 
     using DeviceSize = VkDeviceSize;
 
-    static inline void verify(bool condition, std::string_view message, const char* function, const char* file, int line, int column) {
-#if defined(_DEBUG) && !defined(GRAPHICS_NO_VERIFY) || defined(GRAPHICS_ALWAYS_VERIFY)
-        if (!condition) {
-            std::stringstream formatted;
-            formatted << "[VERIFY FAILED] " << message <<
-                "\n  File: " << file <<
-                "\n  Function: " << function <<
-                "\n  Line: " << line <<
-                "\n  Column: " << column << std::endl;
-            std::cerr << formatted.str();
-            throw std::runtime_error(formatted.str());
-        }
-#else
-        (void)condition; (void)message; (void)file; (void)line; (void)func;
-#endif
+    // out of line so the checking call sites stay small, only reached when a check failed
+    [[noreturn]] inline void verifyFailed(std::string_view message, const std::source_location& location) {
+        std::stringstream formatted;
+        formatted << "[VERIFY FAILED] " << message <<
+            "\n  File: " << location.file_name() <<
+            "\n  Function: " << location.function_name() <<
+            "\n  Line: " << location.line() <<
+            "\n  Column: " << location.column() << std::endl;
+        std::cerr << formatted.str();
+        throw std::runtime_error(formatted.str());
+    }
+
+    template<typename T>
+    constexpr bool isSuccess(const T& result) {
+        if constexpr (std::convertible_to<T, Result>)
+            return static_cast<Result>(result) == Result::Success;
+        else if constexpr (std::convertible_to<T, vk::Result>)
+            return static_cast<vk::Result>(result) == vk::Result::eSuccess;
+        else
+            return static_cast<uint32_t>(result) == VK_SUCCESS;
     }
 
     using SampleMask = VkSampleMask;
@@ -0,0 +1,277 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/Camera.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Pipeline.h"
+#include "Graphics/HandleTypes/ShaderModule.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+#include "Graphics/HandleTypes/DescriptorPool.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/Utility/Utility.h"
+
+#include <vector>
+#include <array>
+#include <cstring>
+
+namespace Graphics::Culling
+{
+	using FrustumPlanes = std::array<glm::vec4, 6>;
+
+	// Gribb-Hartmann plane extraction, planes point inwards and are normalized
+	inline FrustumPlanes extractFrustumPlanes(const glm::mat4& viewProjection)
+	{
+		auto row = [&](int i) {
+			return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+		};
+
+		FrustumPlanes planes = {
+			row(3) + row(0), // left
+			row(3) - row(0), // right
+			row(3) + row(1), // bottom
+			row(3) - row(1), // top
+			row(3) + row(2), // near, conservative for a [0, 1] depth range
+			row(3) - row(2)  // far
+		};
+
+		for (auto& plane : planes)
+			plane /= glm::length(glm::vec3(plane));
+		return planes;
+	}
+
+	inline FrustumPlanes extractFrustumPlanes(const CameraBase& camera)
+	{
+		return extractFrustumPlanes(camera.getProjection() * camera.getView());
+	}
+
+	// matches CullObject in Shaders/frustum_cull.comp (std430)
+	struct alignas(16) CullObject
+	{
+		glm::vec4 sphere; // xyz center, w radius, world space
+		glm::vec4 aabbMin;
+		glm::vec4 aabbMax;
+		DrawIndexedCommand command;
+		uint32_t padding[3];
+	};
+	static_assert(sizeof(CullObject) == 80, "CullObject must match the std430 layout of the culling shader");
+
+	// GPU frustum culling. Object bounds and draw arguments live in a storage buffer, a compute pass
+	// (Shaders/frustum_cull.comp) tests them against the frustum planes and writes the survivors
+	// into an indirect buffer laid out as | draw count | 12 bytes padding | DrawIndexedCommand[] |.
+	// With compaction the survivors are packed and drawn with drawIndexedIndirectCount,
+	// otherwise culled commands keep their slot with instanceCount = 0.
+	class FrustumCuller
+	{
+	public:
+		static constexpr uint32_t s_workGroupSize = 64;
+		static constexpr DeviceSize s_commandsOffset = 16;
+
+	private:
+		struct PushConstants {
+			FrustumPlanes planes;
+			uint32_t objectCount;
+			uint32_t compact;
+		};
+
+		struct FrameData {
+			Buffer objectBuffer;
+			Memory objectMemory;
+			MemoryMapping objectMapping;
+			DescriptorSet descriptorSet;
+			// version of m_objects last copied into this frame's object buffer
+			uint64_t uploadedVersion = 0;
+		};
+
+		std::vector<CullObject> m_objects;
+		uint64_t m_objectsVersion = 1;
+
+		std::vector<FrameData> m_frames;
+		Buffer m_outputBuffer;
+		Memory m_outputMemory;
+
+		DescriptorSetLayout m_setLayout;
+		DescriptorPool m_descriptorPool;
+		PipelineLayout m_pipelineLayout;
+		ComputePipeline m_pipeline;
+
+		uint32_t m_maxObjects = 0;
+		bool m_compact = false;
+
+	public:
+		FrustumCuller() = default;
+
+		FrustumCuller(const FrustumCuller&) = delete;
+		FrustumCuller& operator=(const FrustumCuller&) = delete;
+
+		~FrustumCuller() { GRAPHICS_VERIFY(m_frames.empty(), "FrustumCuller was not destroyed"); };
+
+		// compaction is used when preferCompaction is set and drawIndexedIndirectCount was loaded
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, const ShaderModuleRef& cullShader,
+			uint32_t framesInFlight, uint32_t maxObjects, bool preferCompaction = true)
+		{
+			GRAPHICS_VERIFY(m_frames.empty(), "Trying to create a valid FrustumCuller");
+			m_maxObjects = maxObjects;
+			m_compact = preferCompaction && functions.isLoaded<DeviceFunction::CmdDrawIndexedIndirectCountKHR>();
+			m_objects.reserve(maxObjects);
+
+			std::array<DescriptorSetLayoutBinding, 2> bindings = {
+				DescriptorSetLayoutBinding(0, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(1, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute)
+			};
+			m_setLayout.create(functions, device, DescriptorSetLayoutCreateInfo(bindings));
+
+			PushConstantRange pushConstantRange(Flags::ShaderStage::Bits::Compute, 0, sizeof(PushConstants));
+			m_pipelineLayout.create(functions, device, PipelineLayoutCreateInfo(
+				std::span<const DescriptorSetLayout>(&m_setLayout, 1), std::span<const PushConstantRange>(&pushConstantRange, 1)));
+
+			m_pipeline.create(functions, device, ComputePipelineCreateInfo(
+				PipelineShaderStageCreateInfo(Flags::ShaderStage::Bits::Compute, cullShader, "main"), m_pipelineLayout));
+
+			Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, m_outputBuffer, m_outputMemory,
+				s_commandsOffset + sizeof(DrawIndexedCommand) * maxObjects,
+				Flags::BufferUsage::Bits::StorageBuffer | Flags::BufferUsage::Bits::IndirectBuffer |
+				Flags::BufferUsage::Bits::TransferDst, Flags::MemoryProperty::Bits::DeviceLocal);
+
+			std::array<DescriptorPoolSize, 1> poolSizes = { DescriptorPoolSize(2 * framesInFlight, DescriptorType::StorageBuffer) };
+			m_descriptorPool.create(functions, device, DescriptorPoolCreateInfo(framesInFlight, poolSizes));
+
+			std::vector<DescriptorSetLayoutRef> layouts(framesInFlight, m_setLayout.getReference());
+			auto sets = DescriptorPoolRef::allocateSets(functions, device, DescriptorSetAllocateInfo(m_descriptorPool, layouts));
+
+			m_frames.resize(framesInFlight);
+			for (uint32_t i = 0; i < framesInFlight; ++i)
+			{
+				auto& frame = m_frames[i];
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, frame.objectBuffer, frame.objectMemory,
+					sizeof(CullObject) * maxObjects, Flags::BufferUsage::Bits::StorageBuffer,
+					Flags::MemoryProperty::Bits::HostVisibleCoherent);
+				frame.objectMapping = frame.objectMemory.map(functions, device);
+				frame.descriptorSet = sets[i];
+
+				std::array<DescriptorBufferInfo, 2> bufferInfos = {
+					DescriptorBufferInfo(frame.objectBuffer, 0, MemoryMapping::s_wholeSize),
+					DescriptorBufferInfo(m_outputBuffer, 0, MemoryMapping::s_wholeSize)
+				};
+				std::array<DescriptorSetWrite, 2> writes = {
+					DescriptorSetWrite(frame.descriptorSet, 0, 0, std::span<const DescriptorBufferInfo>(&bufferInfos[0], 1)),
+					DescriptorSetWrite(frame.descriptorSet, 1, 0, std::span<const DescriptorBufferInfo>(&bufferInfos[1], 1))
+				};
+				for (auto& write : writes)
+					write.setDescriptorType(DescriptorType::StorageBuffer);
+				DescriptorSet::update(functions, device, writes);
+			}
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			if (m_frames.empty())
+				return;
+
+			for (auto& frame : m_frames)
+			{
+				frame.objectMemory.unmap(functions, device, frame.objectMapping);
+				frame.objectBuffer.destroy(functions, device);
+				frame.objectMemory.destroy(functions, device);
+			}
+			m_frames.clear();
+
+			// destroying the pool frees the sets
+			m_descriptorPool.destroy(functions, device);
+			m_outputBuffer.destroy(functions, device);
+			m_outputMemory.destroy(functions, device);
+			m_pipeline.destroy(functions, device);
+			m_pipelineLayout.destroy(functions, device);
+			m_setLayout.destroy(functions, device);
+		}
+
+		uint32_t addObject(const CullObject& object)
+		{
+			if (m_objects.size() == m_maxObjects)
+				throw std::runtime_error("Object count exceeds FrustumCuller capacity");
+			m_objects.push_back(object);
+			++m_objectsVersion;
+			return static_cast<uint32_t>(m_objects.size() - 1);
+		}
+
+		void setObject(uint32_t index, const CullObject& object)
+		{
+			GRAPHICS_VERIFY(index < m_objects.size(), "Object index is out of range");
+			m_objects[index] = object;
+			++m_objectsVersion;
+		}
+
+		void clearObjects()
+		{
+			m_objects.clear();
+			++m_objectsVersion;
+		}
+
+		// records the culling pass, must be outside of a render pass. The object buffer of frameIndex
+		// is only rewritten when objects changed since it was last uploaded and must not be in use by the GPU.
+		void record(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer,
+			uint32_t frameIndex, const FrustumPlanes& planes)
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frames.size(), "Frame index is out of range");
+			auto& frame = m_frames[frameIndex];
+
+			if (frame.uploadedVersion != m_objectsVersion)
+			{
+				std::memcpy(frame.objectMapping.get<CullObject>(), m_objects.data(), sizeof(CullObject) * m_objects.size());
+				frame.uploadedVersion = m_objectsVersion;
+			}
+
+			if (m_objects.empty())
+				return;
+
+			// the previous frame's indirect draws must be done reading before the output is rewritten
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::DrawIndirect,
+				Flags::PipelineStage::Bits::Transfer | Flags::PipelineStage::Bits::ComputeShader,
+				Flags::Dependency::Bits::None, {}, {}, {});
+
+			if (m_compact)
+			{
+				commandBuffer.fillBuffer(functions, m_outputBuffer, 0, sizeof(uint32_t), 0);
+				std::array<MemoryBarrier, 1> clearBarrier = { MemoryBarrier(Flags::Access::Bits::TransferWrite,
+					Flags::Access::Bits::ShaderRead | Flags::Access::Bits::ShaderWrite) };
+				commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::Transfer,
+					Flags::PipelineStage::Bits::ComputeShader, Flags::Dependency::Bits::None, clearBarrier, {}, {});
+			}
+
+			PushConstants constants{ planes, static_cast<uint32_t>(m_objects.size()), m_compact ? 1u : 0u };
+
+			commandBuffer.bindPipeline(functions, m_pipeline, PipelineBindPoint::Compute);
+			commandBuffer.bindDescriptorSets(functions, PipelineBindPoint::Compute, m_pipelineLayout, 0,
+				std::span<const DescriptorSet>(&frame.descriptorSet, 1));
+			commandBuffer.pushConstants(functions, m_pipelineLayout, Flags::ShaderStage::Bits::Compute,
+				0, sizeof(PushConstants), &constants);
+			commandBuffer.dispatch(functions, (static_cast<uint32_t>(m_objects.size()) + s_workGroupSize - 1) / s_workGroupSize, 1, 1);
+
+			std::array<MemoryBarrier, 1> resultBarrier = { MemoryBarrier(Flags::Access::Bits::ShaderWrite,
+				Flags::Access::Bits::IndirectCommandRead) };
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::ComputeShader,
+				Flags::PipelineStage::Bits::DrawIndirect, Flags::Dependency::Bits::None, resultBarrier, {}, {});
+		}
+
+		// draws the surviving objects, pipeline and geometry must already be bound
+		void draw(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer) const
+		{
+			if (m_objects.empty())
+				return;
+
+			if (m_compact)
+				commandBuffer.drawIndexedIndirectCount(functions, m_outputBuffer, s_commandsOffset,
+					m_outputBuffer, 0, static_cast<uint32_t>(m_objects.size()));
+			else
+				commandBuffer.drawIndexedIndirect(functions, m_outputBuffer, s_commandsOffset,
+					static_cast<uint32_t>(m_objects.size()));
+		}
+
+		BufferRef getOutputBuffer() const { return m_outputBuffer; };
+		size_t getObjectCount() const { return m_objects.size(); };
+		bool isCompacting() const { return m_compact; };
+	};
+}
@@ -0,0 +1,592 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Image.h"
+#include "Graphics/HandleTypes/Sampler.h"
+#include "Graphics/HandleTypes/Pipeline.h"
+#include "Graphics/HandleTypes/ShaderModule.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+#include "Graphics/HandleTypes/DescriptorPool.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/Utility/Utility.h"
+#include "Graphics/Profiling/GpuProfiler.h"
+#include "FrustumCuller.h"
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <cstddef>
+#include <string_view>
+
+namespace Graphics::Culling
+{
+	// Two phase occlusion culling against a hierarchical depth (Hi-Z) pyramid.
+	//   1. recordEarlyCull + drawEarly: objects visible last frame are frustum tested and drawn.
+	//   2. recordLateCull: the depth attachment is reduced into a max depth mip pyramid
+	//      (Shaders/hiz_reduce.comp), every object is tested against frustum and pyramid
+	//      (Shaders/occlusion_cull.comp) and its visibility is stored for the next frame.
+	//   3. drawLate: objects that became visible this frame are drawn.
+	// The depth image needs Sampled usage (see Utility::createBasicSwapChain), the early render pass
+	// has to store depth and leave it in DepthStencilAttachmentOptimal, the late one has to load it.
+	// Depth is expected to be in [0, 1] with 0 closest to the camera.
+	// With a profiler set the GPU time of the cull passes is measured, see setProfiler.
+	class HiZOcclusionCuller
+	{
+	public:
+		static constexpr uint32_t s_workGroupSize = 64;
+		static constexpr uint32_t s_reduceGroupSize = 8;
+		static constexpr uint32_t s_maxPyramidLevels = 16;
+		static constexpr DeviceSize s_commandsOffset = 16;
+
+		// read back at the end of the late cull, valid once the frame's work has completed
+		struct Statistics {
+			uint32_t objectCount = 0;
+			uint32_t drawnEarly = 0;
+			uint32_t drawnLate = 0;
+			uint32_t frustumCulled = 0;
+			uint32_t occlusionCulled = 0;
+
+			uint32_t getDrawn() const { return drawnEarly + drawnLate; };
+			uint32_t getCulled() const { return frustumCulled + occlusionCulled; };
+		};
+
+	private:
+		struct CullConstants {
+			glm::mat4 viewProjection;
+			glm::vec2 pyramidSize;
+			uint32_t objectCount;
+			uint32_t late;
+			uint32_t compact;
+		};
+
+		struct ReduceConstants {
+			int32_t sourceWidth;
+			int32_t sourceHeight;
+			int32_t destinationWidth;
+			int32_t destinationHeight;
+		};
+
+		// device side layout of the readback buffer
+		struct StatisticsReadback {
+			uint32_t drawnEarly;
+			uint32_t drawnLate;
+			uint32_t frustumCulled;
+			uint32_t occlusionCulled;
+		};
+
+		struct DrawOutput {
+			Buffer buffer;
+			Memory memory;
+		};
+
+		struct FrameData {
+			Buffer objectBuffer;
+			Memory objectMemory;
+			MemoryMapping objectMapping;
+			Buffer readbackBuffer;
+			Memory readbackMemory;
+			MemoryMapping readbackMapping;
+			DescriptorSet cullSet;
+			uint64_t uploadedVersion = 0;
+			uint32_t objectCount = 0;
+		};
+
+		std::vector<CullObject> m_objects;
+		uint64_t m_objectsVersion = 1;
+		bool m_resetVisibility = true;
+
+		std::vector<FrameData> m_frames;
+		DrawOutput m_earlyOutput;
+		DrawOutput m_lateOutput;
+		Buffer m_visibilityBuffer;
+		Memory m_visibilityMemory;
+		Buffer m_statisticsBuffer;
+		Memory m_statisticsMemory;
+
+		// depth pyramid, one view per level for the reduction and one over all levels for culling
+		Image m_pyramid;
+		Memory m_pyramidMemory;
+		ImageView m_pyramidView;
+		std::vector<ImageView> m_pyramidLevelViews;
+		uint32_t m_pyramidWidth = 0;
+		uint32_t m_pyramidHeight = 0;
+		uint32_t m_pyramidLevels = 0;
+
+		ImageRef m_depthImage;
+		ImageViewRef m_depthView;
+		uint32_t m_depthWidth = 0;
+		uint32_t m_depthHeight = 0;
+
+		Sampler m_sampler;
+		DescriptorSetLayout m_reduceSetLayout;
+		DescriptorSetLayout m_cullSetLayout;
+		DescriptorPool m_descriptorPool;
+		std::vector<DescriptorSet> m_reduceSets;
+		PipelineLayout m_reduceLayout;
+		PipelineLayout m_cullLayout;
+		ComputePipeline m_reducePipeline;
+		ComputePipeline m_cullPipeline;
+
+		PhysicalDeviceMemoryProperties m_memoryProperties;
+		uint32_t m_maxObjects = 0;
+		bool m_compact = false;
+		Profiling::GpuProfiler* m_profiler = nullptr;
+
+	public:
+		HiZOcclusionCuller() = default;
+
+		HiZOcclusionCuller(const HiZOcclusionCuller&) = delete;
+		HiZOcclusionCuller& operator=(const HiZOcclusionCuller&) = delete;
+
+		~HiZOcclusionCuller() { GRAPHICS_VERIFY(m_frames.empty(), "HiZOcclusionCuller was not destroyed"); };
+
+		// compaction is used when preferCompaction is set and drawIndexedIndirectCount was loaded
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties,
+			const ShaderModuleRef& reduceShader, const ShaderModuleRef& cullShader,
+			uint32_t framesInFlight, uint32_t maxObjects,
+			const ImageRef& depthImage, const ImageViewRef& depthView, const Extent2D& depthExtent,
+			bool preferCompaction = true)
+		{
+			GRAPHICS_VERIFY(m_frames.empty(), "Trying to create a valid HiZOcclusionCuller");
+			m_memoryProperties = memoryProperties;
+			m_maxObjects = maxObjects;
+			m_compact = preferCompaction && functions.isLoaded<DeviceFunction::CmdDrawIndexedIndirectCountKHR>();
+			m_objects.reserve(maxObjects);
+
+			m_sampler.create(functions, device, SamplerCreateInfo(Filter::Nearest, Filter::Nearest,
+				SamplerMipmapMode::Nearest, SamplerAddressMode::ClampToEdge,
+				SamplerAddressMode::ClampToEdge, SamplerAddressMode::ClampToEdge));
+
+			std::array<DescriptorSetLayoutBinding, 2> reduceBindings = {
+				DescriptorSetLayoutBinding(0, DescriptorType::CombinedImageSampler, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(1, DescriptorType::StorageImage, 1, Flags::ShaderStage::Bits::Compute)
+			};
+			m_reduceSetLayout.create(functions, device, DescriptorSetLayoutCreateInfo(reduceBindings));
+
+			std::array<DescriptorSetLayoutBinding, 6> cullBindings = {
+				DescriptorSetLayoutBinding(0, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(1, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(2, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(3, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(4, DescriptorType::StorageBuffer, 1, Flags::ShaderStage::Bits::Compute),
+				DescriptorSetLayoutBinding(5, DescriptorType::CombinedImageSampler, 1, Flags::ShaderStage::Bits::Compute)
+			};
+			m_cullSetLayout.create(functions, device, DescriptorSetLayoutCreateInfo(cullBindings));
+
+			PushConstantRange reduceRange(Flags::ShaderStage::Bits::Compute, 0, sizeof(ReduceConstants));
+			m_reduceLayout.create(functions, device, PipelineLayoutCreateInfo(
+				std::span<const DescriptorSetLayout>(&m_reduceSetLayout, 1), std::span<const PushConstantRange>(&reduceRange, 1)));
+			PushConstantRange cullRange(Flags::ShaderStage::Bits::Compute, 0, sizeof(CullConstants));
+			m_cullLayout.create(functions, device, PipelineLayoutCreateInfo(
+				std::span<const DescriptorSetLayout>(&m_cullSetLayout, 1), std::span<const PushConstantRange>(&cullRange, 1)));
+
+			m_reducePipeline.create(functions, device, ComputePipelineCreateInfo(
+				PipelineShaderStageCreateInfo(Flags::ShaderStage::Bits::Compute, reduceShader, "main"), m_reduceLayout));
+			m_cullPipeline.create(functions, device, ComputePipelineCreateInfo(
+				PipelineShaderStageCreateInfo(Flags::ShaderStage::Bits::Compute, cullShader, "main"), m_cullLayout));
+
+			auto outputUsage = Flags::BufferUsage::Bits::StorageBuffer | Flags::BufferUsage::Bits::IndirectBuffer |
+				Flags::BufferUsage::Bits::TransferDst | Flags::BufferUsage::Bits::TransferSrc;
+			for (auto* output : { &m_earlyOutput, &m_lateOutput })
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, output->buffer, output->memory,
+					s_commandsOffset + sizeof(DrawIndexedCommand) * maxObjects, outputUsage, Flags::MemoryProperty::Bits::DeviceLocal);
+			Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, m_visibilityBuffer, m_visibilityMemory,
+				sizeof(uint32_t) * maxObjects, Flags::BufferUsage::Bits::StorageBuffer | Flags::BufferUsage::Bits::TransferDst,
+				Flags::MemoryProperty::Bits::DeviceLocal);
+			Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, m_statisticsBuffer, m_statisticsMemory,
+				sizeof(uint32_t) * 4, outputUsage, Flags::MemoryProperty::Bits::DeviceLocal);
+
+			std::array<DescriptorPoolSize, 3> poolSizes = {
+				DescriptorPoolSize(s_maxPyramidLevels + framesInFlight, DescriptorType::CombinedImageSampler),
+				DescriptorPoolSize(s_maxPyramidLevels, DescriptorType::StorageImage),
+				DescriptorPoolSize(5 * framesInFlight, DescriptorType::StorageBuffer)
+			};
+			m_descriptorPool.create(functions, device, DescriptorPoolCreateInfo(s_maxPyramidLevels + framesInFlight, poolSizes));
+
+			std::vector<DescriptorSetLayoutRef> reduceLayouts(s_maxPyramidLevels, m_reduceSetLayout.getReference());
+			m_reduceSets = DescriptorPoolRef::allocateSets(functions, device, DescriptorSetAllocateInfo(m_descriptorPool, reduceLayouts));
+			std::vector<DescriptorSetLayoutRef> cullLayouts(framesInFlight, m_cullSetLayout.getReference());
+			auto cullSets = DescriptorPoolRef::allocateSets(functions, device, DescriptorSetAllocateInfo(m_descriptorPool, cullLayouts));
+
+			m_frames.resize(framesInFlight);
+			for (uint32_t i = 0; i < framesInFlight; ++i)
+			{
+				auto& frame = m_frames[i];
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, frame.objectBuffer, frame.objectMemory,
+					sizeof(CullObject) * maxObjects, Flags::BufferUsage::Bits::StorageBuffer,
+					Flags::MemoryProperty::Bits::HostVisibleCoherent);
+				frame.objectMapping = frame.objectMemory.map(functions, device);
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, frame.readbackBuffer, frame.readbackMemory,
+					sizeof(StatisticsReadback), Flags::BufferUsage::Bits::TransferDst, Flags::MemoryProperty::Bits::HostVisibleCoherent);
+				frame.readbackMapping = frame.readbackMemory.map(functions, device);
+				std::memset(frame.readbackMapping.get<StatisticsReadback>(), 0, sizeof(StatisticsReadback));
+				frame.cullSet = cullSets[i];
+
+				std::array<DescriptorBufferInfo, 5> bufferInfos = {
+					DescriptorBufferInfo(frame.objectBuffer, 0, MemoryMapping::s_wholeSize),
+					DescriptorBufferInfo(m_visibilityBuffer, 0, MemoryMapping::s_wholeSize),
+					DescriptorBufferInfo(m_earlyOutput.buffer, 0, MemoryMapping::s_wholeSize),
+					DescriptorBufferInfo(m_lateOutput.buffer, 0, MemoryMapping::s_wholeSize),
+					DescriptorBufferInfo(m_statisticsBuffer, 0, MemoryMapping::s_wholeSize)
+				};
+				std::vector<DescriptorSetWrite> writes;
+				for (uint32_t binding = 0; binding < bufferInfos.size(); ++binding)
+				{
+					writes.emplace_back(frame.cullSet, binding, 0, std::span<const DescriptorBufferInfo>(&bufferInfos[binding], 1));
+					writes.back().setDescriptorType(DescriptorType::StorageBuffer);
+				}
+				DescriptorSet::update(functions, device, writes);
+			}
+
+			createPyramid(functions, device, depthImage, depthView, depthExtent);
+		}
+
+		// the pyramid follows the depth attachment, must be called after the swap chain was recreated
+		// and while none of the frames is in use by the GPU
+		void resize(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const ImageRef& depthImage, const ImageViewRef& depthView, const Extent2D& depthExtent)
+		{
+			destroyPyramid(functions, device);
+			createPyramid(functions, device, depthImage, depthView, depthExtent);
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			if (m_frames.empty())
+				return;
+
+			destroyPyramid(functions, device);
+			for (auto& frame : m_frames)
+			{
+				frame.objectMemory.unmap(functions, device, frame.objectMapping);
+				frame.objectBuffer.destroy(functions, device);
+				frame.objectMemory.destroy(functions, device);
+				frame.readbackMemory.unmap(functions, device, frame.readbackMapping);
+				frame.readbackBuffer.destroy(functions, device);
+				frame.readbackMemory.destroy(functions, device);
+			}
+			m_frames.clear();
+			m_reduceSets.clear();
+
+			for (auto* output : { &m_earlyOutput, &m_lateOutput })
+			{
+				output->buffer.destroy(functions, device);
+				output->memory.destroy(functions, device);
+			}
+			m_visibilityBuffer.destroy(functions, device);
+			m_visibilityMemory.destroy(functions, device);
+			m_statisticsBuffer.destroy(functions, device);
+			m_statisticsMemory.destroy(functions, device);
+
+			// destroying the pool frees the sets
+			m_descriptorPool.destroy(functions, device);
+			m_cullPipeline.destroy(functions, device);
+			m_reducePipeline.destroy(functions, device);
+			m_cullLayout.destroy(functions, device);
+			m_reduceLayout.destroy(functions, device);
+			m_cullSetLayout.destroy(functions, device);
+			m_reduceSetLayout.destroy(functions, device);
+			m_sampler.destroy(functions, device);
+		}
+
+		uint32_t addObject(const CullObject& object)
+		{
+			if (m_objects.size() == m_maxObjects)
+				throw std::runtime_error("Object count exceeds HiZOcclusionCuller capacity");
+			m_objects.push_back(object);
+			++m_objectsVersion;
+			return static_cast<uint32_t>(m_objects.size() - 1);
+		}
+
+		void setObject(uint32_t index, const CullObject& object)
+		{
+			GRAPHICS_VERIFY(index < m_objects.size(), "Object index is out of range");
+			m_objects[index] = object;
+			++m_objectsVersion;
+		}
+
+		// visibility is tracked per index, so it starts over with the new objects
+		void clearObjects()
+		{
+			m_objects.clear();
+			++m_objectsVersion;
+			m_resetVisibility = true;
+		}
+
+		// records the scopes "HiZ early cull", "HiZ pyramid" and "HiZ late cull", the profiler's frame has to
+		// be begun on the command buffers passed to recordEarlyCull and recordLateCull, nullptr stops profiling
+		void setProfiler(Profiling::GpuProfiler* profiler) { m_profiler = profiler; };
+
+		// first phase, must be outside of a render pass. The object buffer of frameIndex is only
+		// rewritten when objects changed since it was last uploaded and must not be in use by the GPU.
+		void recordEarlyCull(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer,
+			uint32_t frameIndex, const glm::mat4& viewProjection)
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frames.size(), "Frame index is out of range");
+			auto& frame = m_frames[frameIndex];
+
+			if (frame.uploadedVersion != m_objectsVersion)
+			{
+				std::memcpy(frame.objectMapping.get<CullObject>(), m_objects.data(), sizeof(CullObject) * m_objects.size());
+				frame.uploadedVersion = m_objectsVersion;
+			}
+			frame.objectCount = static_cast<uint32_t>(m_objects.size());
+
+			// the previous frame's draws and readback must be done before the outputs are cleared
+			commandBuffer.pipelineBarrier(functions,
+				Flags::PipelineStage::Bits::DrawIndirect | Flags::PipelineStage::Bits::Transfer |
+				Flags::PipelineStage::Bits::ComputeShader,
+				Flags::PipelineStage::Bits::Transfer, Flags::Dependency::Bits::None, {}, {}, {});
+
+			commandBuffer.fillBuffer(functions, m_earlyOutput.buffer, 0, sizeof(uint32_t), 0);
+			commandBuffer.fillBuffer(functions, m_lateOutput.buffer, 0, sizeof(uint32_t), 0);
+			commandBuffer.fillBuffer(functions, m_statisticsBuffer, 0, sizeof(uint32_t) * 4, 0);
+			if (m_resetVisibility)
+			{
+				commandBuffer.fillBuffer(functions, m_visibilityBuffer, 0, sizeof(uint32_t) * m_maxObjects, 0);
+				m_resetVisibility = false;
+			}
+
+			std::array<MemoryBarrier, 1> clearBarrier = { MemoryBarrier(Flags::Access::Bits::TransferWrite,
+				Flags::Access::Bits::ShaderRead | Flags::Access::Bits::ShaderWrite) };
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::Transfer,
+				Flags::PipelineStage::Bits::ComputeShader, Flags::Dependency::Bits::None, clearBarrier, {}, {});
+
+			{
+				auto scope = profile(functions, commandBuffer, "HiZ early cull");
+				dispatchCull(functions, commandBuffer, frame, viewProjection, false);
+			}
+
+			std::array<MemoryBarrier, 1> resultBarrier = { MemoryBarrier(Flags::Access::Bits::ShaderWrite,
+				Flags::Access::Bits::IndirectCommandRead | Flags::Access::Bits::ShaderRead) };
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::ComputeShader,
+				Flags::PipelineStage::Bits::DrawIndirect | Flags::PipelineStage::Bits::ComputeShader,
+				Flags::Dependency::Bits::None, resultBarrier, {}, {});
+		}
+
+		// second phase, must be recorded after the render pass of drawEarly ended and outside of a render pass
+		void recordLateCull(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer,
+			uint32_t frameIndex, const glm::mat4& viewProjection)
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frames.size(), "Frame index is out of range");
+			auto& frame = m_frames[frameIndex];
+
+			{
+				auto scope = profile(functions, commandBuffer, "HiZ pyramid");
+				buildPyramid(functions, commandBuffer);
+			}
+			{
+				auto scope = profile(functions, commandBuffer, "HiZ late cull");
+				dispatchCull(functions, commandBuffer, frame, viewProjection, true);
+			}
+
+			std::array<MemoryBarrier, 1> resultBarrier = { MemoryBarrier(Flags::Access::Bits::ShaderWrite,
+				Flags::Access::Bits::IndirectCommandRead | Flags::Access::Bits::TransferRead) };
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::ComputeShader,
+				Flags::PipelineStage::Bits::DrawIndirect | Flags::PipelineStage::Bits::Transfer,
+				Flags::Dependency::Bits::None, resultBarrier, {}, {});
+
+			Utility::transferData(functions, commandBuffer, m_earlyOutput.buffer, frame.readbackBuffer,
+				sizeof(uint32_t), 0, offsetof(StatisticsReadback, drawnEarly));
+			Utility::transferData(functions, commandBuffer, m_lateOutput.buffer, frame.readbackBuffer,
+				sizeof(uint32_t), 0, offsetof(StatisticsReadback, drawnLate));
+			Utility::transferData(functions, commandBuffer, m_statisticsBuffer, frame.readbackBuffer,
+				sizeof(uint32_t) * 2, 0, offsetof(StatisticsReadback, frustumCulled));
+
+			std::array<MemoryBarrier, 1> readbackBarrier = { MemoryBarrier(Flags::Access::Bits::TransferWrite,
+				Flags::Access::Bits::HostRead) };
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::Transfer,
+				Flags::PipelineStage::Bits::Host, Flags::Dependency::Bits::None, readbackBarrier, {}, {});
+		}
+
+		// pipeline and geometry must already be bound
+		void drawEarly(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer) const {
+			draw(functions, commandBuffer, m_earlyOutput);
+		}
+
+		void drawLate(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer) const {
+			draw(functions, commandBuffer, m_lateOutput);
+		}
+
+		// results of the last submission of frameIndex, only valid once its fence has been signaled
+		Statistics getStatistics(uint32_t frameIndex) const
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frames.size(), "Frame index is out of range");
+			const auto& frame = m_frames[frameIndex];
+			const auto* readback = frame.readbackMapping.get<StatisticsReadback>();
+			return { frame.objectCount, readback->drawnEarly, readback->drawnLate,
+				readback->frustumCulled, readback->occlusionCulled };
+		}
+
+		ImageViewRef getPyramidView() const { return m_pyramidView; };
+		uint32_t getPyramidLevels() const { return m_pyramidLevels; };
+		size_t getObjectCount() const { return m_objects.size(); };
+		bool isCompacting() const { return m_compact; };
+
+	private:
+		// an empty scope when no profiler is set
+		Profiling::GpuProfiler::Scope profile(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer,
+			std::string_view name)
+		{
+			if (!m_profiler)
+				return {};
+			return m_profiler->scope(functions, commandBuffer, name);
+		}
+
+		void createPyramid(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const ImageRef& depthImage, const ImageViewRef& depthView, const Extent2D& depthExtent)
+		{
+			m_depthImage = depthImage;
+			m_depthView = depthView;
+			m_depthWidth = depthExtent.getWidth();
+			m_depthHeight = depthExtent.getHeight();
+
+			// a power of two base keeps every level an exact 2x2 reduction of the previous one
+			m_pyramidWidth = std::max(std::bit_floor(m_depthWidth), 1u);
+			m_pyramidHeight = std::max(std::bit_floor(m_depthHeight), 1u);
+			m_pyramidLevels = std::min(Utility::calculateMipLevels(Extent2D(m_pyramidWidth, m_pyramidHeight)), s_maxPyramidLevels);
+
+			m_pyramid.create(functions, device, ImageCreateInfo(ImageType::Image2D, PixelFormat::R32Sfloat,
+				Extent3D(Extent2D(m_pyramidWidth, m_pyramidHeight), 1), m_pyramidLevels, 1, Flags::SampleCount::Bits::SC1,
+				ImageTiling::Optimal, Flags::ImageUsage::Bits::Sampled | Flags::ImageUsage::Bits::Storage));
+			auto requirements = m_pyramid.getMemoryRequirements(device, functions);
+			m_pyramidMemory.create(functions, device, MemoryAllocateInfo(requirements.getSize(),
+				Utility::findMemoryTypeFirstFit(m_memoryProperties, requirements.getMemoryTypeBits(),
+					Flags::MemoryProperty::Bits::DeviceLocal)));
+			m_pyramidMemory.bindImage(functions, device, m_pyramid);
+
+			m_pyramidView.create(device, functions, ImageViewCreateInfo(m_pyramid, ImageViewType::T2D, PixelFormat::R32Sfloat,
+				ComponentMapping(), ImageSubresourceRange(Flags::ImageAspect::Bits::Color, 0, m_pyramidLevels)));
+			m_pyramidLevelViews.resize(m_pyramidLevels);
+			for (uint32_t level = 0; level < m_pyramidLevels; ++level)
+				m_pyramidLevelViews[level].create(device, functions, ImageViewCreateInfo(m_pyramid, ImageViewType::T2D,
+					PixelFormat::R32Sfloat, ComponentMapping(), ImageSubresourceRange(Flags::ImageAspect::Bits::Color, level, 1)));
+
+			std::vector<DescriptorImageInfo> imageInfos;
+			imageInfos.reserve(2 * m_pyramidLevels + m_frames.size());
+			std::vector<DescriptorSetWrite> writes;
+			for (uint32_t level = 0; level < m_pyramidLevels; ++level)
+			{
+				if (level == 0)
+					imageInfos.emplace_back(m_sampler, m_depthView, ImageLayout::DepthStencilReadOnlyOptimal);
+				else
+					imageInfos.emplace_back(m_sampler, m_pyramidLevelViews[level - 1], ImageLayout::General);
+				writes.emplace_back(m_reduceSets[level], 0, 0, std::span<const DescriptorImageInfo>(&imageInfos.back(), 1));
+				writes.back().setDescriptorType(DescriptorType::CombinedImageSampler);
+
+				imageInfos.emplace_back(SamplerRef(), m_pyramidLevelViews[level], ImageLayout::General);
+				writes.emplace_back(m_reduceSets[level], 1, 0, std::span<const DescriptorImageInfo>(&imageInfos.back(), 1));
+				writes.back().setDescriptorType(DescriptorType::StorageImage);
+			}
+			for (auto& frame : m_frames)
+			{
+				imageInfos.emplace_back(m_sampler, m_pyramidView, ImageLayout::General);
+				writes.emplace_back(frame.cullSet, 5, 0, std::span<const DescriptorImageInfo>(&imageInfos.back(), 1));
+				writes.back().setDescriptorType(DescriptorType::CombinedImageSampler);
+			}
+			DescriptorSet::update(functions, device, writes);
+		}
+
+		void destroyPyramid(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			for (auto& view : m_pyramidLevelViews)
+				view.destroy(device, functions);
+			m_pyramidLevelViews.clear();
+			m_pyramidView.destroy(device, functions);
+			m_pyramid.destroy(functions, device);
+			m_pyramidMemory.destroy(functions, device);
+		}
+
+		void buildPyramid(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer)
+		{
+			// the previous contents are never read, the pyramid is rebuilt from scratch every frame
+			std::array<ImageMemoryBarrier, 2> toRead = {
+				ImageMemoryBarrier(m_depthImage, ImageLayout::DepthStencilAttachmentOptimal, ImageLayout::DepthStencilReadOnlyOptimal,
+					Flags::Access::Bits::DepthStencilAttachmentWrite, Flags::Access::Bits::ShaderRead,
+					ImageMemoryBarrier::s_queueFamilyIgnored, ImageMemoryBarrier::s_queueFamilyIgnored,
+					ImageSubresourceRange(Flags::ImageAspect::Bits::Depth)),
+				ImageMemoryBarrier(m_pyramid, ImageLayout::Undefined, ImageLayout::General,
+					Flags::Access::Bits::None, Flags::Access::Bits::ShaderWrite,
+					ImageMemoryBarrier::s_queueFamilyIgnored, ImageMemoryBarrier::s_queueFamilyIgnored,
+					ImageSubresourceRange(Flags::ImageAspect::Bits::Color, 0, m_pyramidLevels))
+			};
+			commandBuffer.pipelineBarrier(functions,
+				Flags::PipelineStage::Bits::LateFragmentTests | Flags::PipelineStage::Bits::ComputeShader,
+				Flags::PipelineStage::Bits::ComputeShader, Flags::Dependency::Bits::None, {}, {}, toRead);
+
+			commandBuffer.bindPipeline(functions, m_reducePipeline, PipelineBindPoint::Compute);
+
+			uint32_t sourceWidth = m_depthWidth;
+			uint32_t sourceHeight = m_depthHeight;
+			for (uint32_t level = 0; level < m_pyramidLevels; ++level)
+			{
+				uint32_t width = std::max(m_pyramidWidth >> level, 1u);
+				uint32_t height = std::max(m_pyramidHeight >> level, 1u);
+				ReduceConstants constants{ static_cast<int32_t>(sourceWidth), static_cast<int32_t>(sourceHeight),
+					static_cast<int32_t>(width), static_cast<int32_t>(height) };
+
+				commandBuffer.bindDescriptorSets(functions, PipelineBindPoint::Compute, m_reduceLayout, 0,
+					std::span<const DescriptorSet>(&m_reduceSets[level], 1));
+				commandBuffer.pushConstants(functions, m_reduceLayout, Flags::ShaderStage::Bits::Compute,
+					0, sizeof(ReduceConstants), &constants);
+				commandBuffer.dispatch(functions, (width + s_reduceGroupSize - 1) / s_reduceGroupSize,
+					(height + s_reduceGroupSize - 1) / s_reduceGroupSize, 1);
+
+				std::array<MemoryBarrier, 1> levelBarrier = { MemoryBarrier(Flags::Access::Bits::ShaderWrite,
+					Flags::Access::Bits::ShaderRead) };
+				commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::ComputeShader,
+					Flags::PipelineStage::Bits::ComputeShader, Flags::Dependency::Bits::None, levelBarrier, {}, {});
+
+				sourceWidth = width;
+				sourceHeight = height;
+			}
+
+			// hand the depth attachment back to the late render pass
+			std::array<ImageMemoryBarrier, 1> toAttachment = {
+				ImageMemoryBarrier(m_depthImage, ImageLayout::DepthStencilReadOnlyOptimal, ImageLayout::DepthStencilAttachmentOptimal,
+					Flags::Access::Bits::None,
+					Flags::Access::Bits::DepthStencilAttachmentRead | Flags::Access::Bits::DepthStencilAttachmentWrite,
+					ImageMemoryBarrier::s_queueFamilyIgnored, ImageMemoryBarrier::s_queueFamilyIgnored,
+					ImageSubresourceRange(Flags::ImageAspect::Bits::Depth))
+			};
+			commandBuffer.pipelineBarrier(functions, Flags::PipelineStage::Bits::ComputeShader,
+				Flags::PipelineStage::Bits::EarlyFragmentTests, Flags::Dependency::Bits::None, {}, {}, toAttachment);
+		}
+
+		void dispatchCull(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer,
+			const FrameData& frame, const glm::mat4& viewProjection, bool late)
+		{
+			if (frame.objectCount == 0)
+				return;
+
+			CullConstants constants{ viewProjection, glm::vec2(m_pyramidWidth, m_pyramidHeight),
+				frame.objectCount, late ? 1u : 0u, m_compact ? 1u : 0u };
+
+			commandBuffer.bindPipeline(functions, m_cullPipeline, PipelineBindPoint::Compute);
+			commandBuffer.bindDescriptorSets(functions, PipelineBindPoint::Compute, m_cullLayout, 0,
+				std::span<const DescriptorSet>(&frame.cullSet, 1));
+			commandBuffer.pushConstants(functions, m_cullLayout, Flags::ShaderStage::Bits::Compute,
+				0, sizeof(CullConstants), &constants);
+			commandBuffer.dispatch(functions, (frame.objectCount + s_workGroupSize - 1) / s_workGroupSize, 1, 1);
+		}
+
+		void draw(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer, const DrawOutput& output) const
+		{
+			if (m_objects.empty())
+				return;
+
+			if (m_compact)
+				commandBuffer.drawIndexedIndirectCount(functions, output.buffer, s_commandsOffset,
+					output.buffer, 0, static_cast<uint32_t>(m_objects.size()));
+			else
+				commandBuffer.drawIndexedIndirect(functions, output.buffer, s_commandsOffset,
+					static_cast<uint32_t>(m_objects.size()));
+		}
+	};
+}
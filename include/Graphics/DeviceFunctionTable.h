@@ -631,6 +631,26 @@ namespace Graphics {
         static constexpr const char* name = "vkSignalSemaphoreKHR";
     };
 
+    // VK_KHR_present_wait extension functions
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::WaitForPresentKHR> {
+        using Type = PFN_vkWaitForPresentKHR;
+        static constexpr const char* name = "vkWaitForPresentKHR";
+    };
+
+    // VK_KHR_draw_indirect_count extension functions
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::CmdDrawIndirectCountKHR> {
+        using Type = PFN_vkCmdDrawIndirectCountKHR;
+        static constexpr const char* name = "vkCmdDrawIndirectCountKHR";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::CmdDrawIndexedIndirectCountKHR> {
+        using Type = PFN_vkCmdDrawIndexedIndirectCountKHR;
+        static constexpr const char* name = "vkCmdDrawIndexedIndirectCountKHR";
+    };
+
     // VK_KHR_copy_commands2 extension functions
     template <>
     struct DeviceFunctionTraits<DeviceFunction::CmdCopyBuffer2KHR> {
@@ -873,6 +893,12 @@ namespace Graphics {
         static constexpr const char* name = "vkCreateGraphicsPipelines";
     };
 
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::CreateComputePipelines> {
+        using Type = PFN_vkCreateComputePipelines;
+        static constexpr const char* name = "vkCreateComputePipelines";
+    };
+
     template <>
     struct DeviceFunctionTraits<DeviceFunction::DestroyDescriptorPool> {
         using Type = PFN_vkDestroyDescriptorPool;
@@ -909,5 +935,47 @@ namespace Graphics {
         static constexpr const char* name = "vkUpdateDescriptorSets";
     };
 
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::DestroyQueryPool> {
+        using Type = PFN_vkDestroyQueryPool;
+        static constexpr const char* name = "vkDestroyQueryPool";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::CreateQueryPool> {
+        using Type = PFN_vkCreateQueryPool;
+        static constexpr const char* name = "vkCreateQueryPool";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::GetQueryPoolResults> {
+        using Type = PFN_vkGetQueryPoolResults;
+        static constexpr const char* name = "vkGetQueryPoolResults";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::DestroyPipelineCache> {
+        using Type = PFN_vkDestroyPipelineCache;
+        static constexpr const char* name = "vkDestroyPipelineCache";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::CreatePipelineCache> {
+        using Type = PFN_vkCreatePipelineCache;
+        static constexpr const char* name = "vkCreatePipelineCache";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::GetPipelineCacheData> {
+        using Type = PFN_vkGetPipelineCacheData;
+        static constexpr const char* name = "vkGetPipelineCacheData";
+    };
+
+    template <>
+    struct DeviceFunctionTraits<DeviceFunction::MergePipelineCaches> {
+        using Type = PFN_vkMergePipelineCaches;
+        static constexpr const char* name = "vkMergePipelineCaches";
+    };
+
     using DeviceFunctionTable = FunctionTable<DeviceFunction, DeviceFunctionTraits, VkDevice, PFN_vkGetDeviceProcAddr>;
 }
\ No newline at end of file
@@ -353,6 +353,13 @@ namespace Graphics {
         WaitSemaphoresKHR,
         SignalSemaphoreKHR,
 
+        // VK_KHR_present_wait extension
+        WaitForPresentKHR,
+
+        // VK_KHR_draw_indirect_count extension
+        CmdDrawIndirectCountKHR,
+        CmdDrawIndexedIndirectCountKHR,
+
         // VK_KHR_push_descriptor extension
         //CmdPushDescriptorSetKHR,
         //CmdPushDescriptorSetWithTemplateKHR,
@@ -383,6 +390,7 @@ namespace Graphics {
         ResetDescriptorPool,
 
         CreateGraphicsPipelines,
+        CreateComputePipelines,
         DestroyPipeline,
 
         UpdateDescriptorSets,
@@ -417,6 +425,13 @@ namespace Graphics {
         CreateDescriptorPool,
         DestroyBufferView,
         CreateBufferView,
+        DestroyQueryPool,
+        CreateQueryPool,
+        GetQueryPoolResults,
+        DestroyPipelineCache,
+        CreatePipelineCache,
+        GetPipelineCacheData,
+        MergePipelineCaches,
         Num
     };
 
@@ -1027,6 +1042,59 @@ namespace Graphics {
         using CorrespondingType = PresentMode;
     };
 
+    enum class QueryType : uint32_t
+    {
+        Occlusion          = VK_QUERY_TYPE_OCCLUSION,
+        PipelineStatistics = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+        Timestamp          = VK_QUERY_TYPE_TIMESTAMP
+    };
+
+    template<>
+    struct EnumVulkanConnect<QueryType> {
+        using CorrespondingType = vk::QueryType;
+    };
+
+    template<>
+    struct EnumVulkanConnect<vk::QueryType> {
+        using CorrespondingType = QueryType;
+    };
+
+    template<>
+    struct EnumCVulkanConnect<QueryType> {
+        using CorrespondingType = VkQueryType;
+    };
+
+    template<>
+    struct EnumCVulkanConnect<VkQueryType> {
+        using CorrespondingType = QueryType;
+    };
+
+    enum class SemaphoreType : uint32_t
+    {
+        Binary   = VK_SEMAPHORE_TYPE_BINARY,
+        Timeline = VK_SEMAPHORE_TYPE_TIMELINE
+    };
+
+    template<>
+    struct EnumVulkanConnect<SemaphoreType> {
+        using CorrespondingType = vk::SemaphoreType;
+    };
+
+    template<>
+    struct EnumVulkanConnect<vk::SemaphoreType> {
+        using CorrespondingType = SemaphoreType;
+    };
+
+    template<>
+    struct EnumCVulkanConnect<SemaphoreType> {
+        using CorrespondingType = VkSemaphoreType;
+    };
+
+    template<>
+    struct EnumCVulkanConnect<VkSemaphoreType> {
+        using CorrespondingType = SemaphoreType;
+    };
+
     enum class SharingMode : uint32_t
     {
         Exclusive  = VK_SHARING_MODE_EXCLUSIVE,
@@ -1135,6 +1203,10 @@ namespace Graphics {
         BindSparseInfo = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO,
         FenceCreateInfo = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
         SemaphoreCreateInfo = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        SemaphoreTypeCreateInfo = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        TimelineSemaphoreSubmitInfo = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        SemaphoreWaitInfo = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        SemaphoreSignalInfo = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO,
         EventCreateInfo = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO,
         QueryPoolCreateInfo = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
         BufferCreateInfo = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
@@ -1172,8 +1244,19 @@ namespace Graphics {
         BufferMemoryBarrier = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
         ImageMemoryBarrier = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
         MemoryBarrier = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        MemoryBarrier2 = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        BufferMemoryBarrier2 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+        ImageMemoryBarrier2 = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+        DependencyInfo = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        SubmitInfo2 = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+        SemaphoreSubmitInfo = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+        CommandBufferSubmitInfo = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+        RenderingInfo = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        RenderingAttachmentInfo = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        PipelineRenderingCreateInfo = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
         SwapchainCreateInfoKHR = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
         PresentInfoKHR = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        PresentIdKHR = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
         DebugUtilsObjectNameInfoEXT = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
         DebugUtilsObjectTagInfoEXT = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_TAG_INFO_EXT,
         DebugUtilsLabelEXT = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
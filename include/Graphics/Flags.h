@@ -9,36 +9,40 @@ namespace Graphics::Flags
     template <typename Definition>
     class FlagsBase
     {
+    public:
+        using Bits = typename Definition::Bits;
+        // 64 bit for the synchronization2 masks, 32 bit for everything else
+        using StorageType = std::underlying_type_t<Bits>;
+
     protected:
-        uint32_t m_flags;
+        StorageType m_flags;
 
     public:
-        using Bits = typename Definition::Bits;
         using VulkanFlags = typename Definition::VulkanFlags;
         using VulkanBits = typename Definition::VulkanBits;
         using VulkanCFlags = typename Definition::VulkanCFlags;
         using VulkanCBits = typename Definition::VulkanCBits;
 
         constexpr FlagsBase() : m_flags(0) {};
-        constexpr FlagsBase(Bits bit) : m_flags(static_cast<uint32_t>(bit)) {}
-        constexpr FlagsBase(uint32_t flags) : m_flags(flags) {}
+        constexpr FlagsBase(Bits bit) : m_flags(static_cast<StorageType>(bit)) {}
+        constexpr FlagsBase(StorageType flags) : m_flags(flags) {}
 
         template<typename T>
-        constexpr FlagsBase(T flags) requires (!std::is_void_v<T>&& std::convertible_to<T, VulkanFlags>) : m_flags(static_cast<uint32_t>(flags)) {};
+        constexpr FlagsBase(T flags) requires (!std::is_void_v<T>&& std::convertible_to<T, VulkanFlags>) : m_flags(static_cast<StorageType>(flags)) {};
 
         template<typename T>
-        constexpr FlagsBase(T bit) requires (!std::is_void_v<T>&& std::convertible_to<T, VulkanBits>) : m_flags(static_cast<uint32_t>(bit)) {};
+        constexpr FlagsBase(T bit) requires (!std::is_void_v<T>&& std::convertible_to<T, VulkanBits>) : m_flags(static_cast<StorageType>(bit)) {};
 
         template<typename T>
-        constexpr FlagsBase(T value) requires (!std::is_void_v<T>&& std::convertible_to<T, VulkanCBits>) { m_flags = static_cast<uint32_t>(value); }
+        constexpr FlagsBase(T value) requires (!std::is_void_v<T>&& std::convertible_to<T, VulkanCBits>) { m_flags = static_cast<StorageType>(value); }
 
         constexpr operator VulkanFlags() const requires (!std::is_void_v<VulkanFlags>) { return VulkanFlags(this->m_flags); }
         constexpr operator VulkanBits() const requires (!std::is_void_v<VulkanBits>) { return static_cast<VulkanBits>(this->m_flags); }
 
-        constexpr operator uint32_t() const { return m_flags; }
+        constexpr operator StorageType() const { return m_flags; }
 
         constexpr inline FlagsBase operator|(const Bits& other) const {
-            return static_cast<FlagsBase>(m_flags | static_cast<uint32_t>(other));
+            return static_cast<FlagsBase>(m_flags | static_cast<StorageType>(other));
         }
 
         constexpr inline FlagsBase operator|(const FlagsBase& other) const {
@@ -46,17 +50,17 @@ namespace Graphics::Flags
         }
 
         constexpr inline FlagsBase& operator|=(const Bits& other) {
-            m_flags |= static_cast<uint32_t>(other);
+            m_flags |= static_cast<StorageType>(other);
             return *this;
         }
 
         constexpr inline FlagsBase& operator|=(const FlagsBase& other) {
-            m_flags |= static_cast<uint32_t>(other);
+            m_flags |= static_cast<StorageType>(other);
             return *this;
         }
 
         constexpr inline FlagsBase operator&(const Bits& other) const {
-            return static_cast<FlagsBase>(m_flags & static_cast<uint32_t>(other));
+            return static_cast<FlagsBase>(m_flags & static_cast<StorageType>(other));
         }
 
         constexpr inline FlagsBase operator&(const FlagsBase& other) const {
@@ -64,45 +68,45 @@ namespace Graphics::Flags
         }
 
         constexpr inline FlagsBase& operator&=(const Bits& other) {
-            m_flags &= static_cast<uint32_t>(other);
+            m_flags &= static_cast<StorageType>(other);
             return *this;
         }
 
         constexpr inline FlagsBase& operator&=(const FlagsBase& other) {
-            m_flags &= static_cast<uint32_t>(other);
+            m_flags &= static_cast<StorageType>(other);
             return *this;
         }
 
         constexpr inline bool operator==(const FlagsBase& other) const {
-            return m_flags == static_cast<uint32_t>(other);
+            return m_flags == static_cast<StorageType>(other);
         }
 
         constexpr inline bool operator!=(const FlagsBase& other) const {
-            return m_flags != static_cast<uint32_t>(other);
+            return m_flags != static_cast<StorageType>(other);
         }
 
         constexpr inline bool operator==(const Bits& other) const {
-            return m_flags == static_cast<uint32_t>(other);
+            return m_flags == static_cast<StorageType>(other);
         }
 
         constexpr inline bool operator!=(const Bits& other) const {
-            return m_flags != static_cast<uint32_t>(other);
+            return m_flags != static_cast<StorageType>(other);
         }
 
-        constexpr inline bool operator==(const uint32_t& other) const {
+        constexpr inline bool operator==(const StorageType& other) const {
             return m_flags == other;
         }
 
-        constexpr inline bool operator!=(const uint32_t& other) const {
+        constexpr inline bool operator!=(const StorageType& other) const {
             return m_flags != other;
         }
 
-        constexpr bool hasFlag(const uint32_t& flag) const {
+        constexpr bool hasFlag(const StorageType& flag) const {
             return (m_flags & flag) == flag;
         }
 
         constexpr bool hasFlag(const Bits& flag) const {
-            return (m_flags & static_cast<uint32_t>(flag)) == static_cast<uint32_t>(flag);
+            return (m_flags & static_cast<StorageType>(flag)) == static_cast<StorageType>(flag);
         }
 
         constexpr bool hasFlags(const FlagsBase& flags) const {
@@ -110,7 +114,7 @@ namespace Graphics::Flags
         }
 
         constexpr bool doesntHaveFlag(const Bits& flag) const {
-            return (m_flags & static_cast<uint32_t>(flag)) == 0;
+            return (m_flags & static_cast<StorageType>(flag)) == 0;
         }
 
         constexpr bool doesntHaveFlags(const FlagsBase& flags) const {
@@ -123,7 +127,7 @@ namespace Graphics::Flags
             Definition::s_bitCount;
         } {
 			size_t index = 0;
-			uint32_t flagValue = static_cast<uint32_t>(flag);
+			StorageType flagValue = static_cast<StorageType>(flag);
             while (flagValue >>= 1) ++index;
 			return index;
         }
@@ -154,52 +158,52 @@ namespace Graphics::Flags
 
         template <typename Bits>
         constexpr inline typename BitTraits<Bits>::ParentType operator|(const Bits& a, const Bits& b) {
-            return static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+            return static_cast<std::underlying_type_t<Bits>>(a) | static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
         constexpr inline typename BitTraits<Bits>::ParentType operator&(const Bits& a, const Bits& b) {
-            return static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+            return static_cast<std::underlying_type_t<Bits>>(a) & static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
         constexpr inline bool operator==(const Bits& a, const FlagsBase<typename BitTraits<Bits>::ParentType>& b) {
-            return static_cast<uint32_t>(a) == static_cast<uint32_t>(b);
+            return static_cast<std::underlying_type_t<Bits>>(a) == static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
         constexpr inline bool operator!=(const Bits& a, const FlagsBase<typename BitTraits<Bits>::ParentType>& b) {
-            return static_cast<uint32_t>(a) != static_cast<uint32_t>(b);
+            return static_cast<std::underlying_type_t<Bits>>(a) != static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
-        constexpr inline bool operator==(const uint32_t& a, const FlagsBase<typename BitTraits<Bits>::ParentType>& b) {
-            return a == static_cast<uint32_t>(b);
+        constexpr inline bool operator==(const std::underlying_type_t<Bits>& a, const FlagsBase<typename BitTraits<Bits>::ParentType>& b) {
+            return a == static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
-        constexpr inline bool operator!=(const uint32_t& a, const FlagsBase<typename BitTraits<Bits>::ParentType>& b) {
-            return a != static_cast<uint32_t>(b);
+        constexpr inline bool operator!=(const std::underlying_type_t<Bits>& a, const FlagsBase<typename BitTraits<Bits>::ParentType>& b) {
+            return a != static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
-        constexpr inline bool operator==(const uint32_t& a, const Bits& b) {
-            return a == static_cast<uint32_t>(b);
+        constexpr inline bool operator==(const std::underlying_type_t<Bits>& a, const Bits& b) {
+            return a == static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
-        constexpr inline bool operator!=(const uint32_t& a, const Bits& b) {
-            return a != static_cast<uint32_t>(b);
+        constexpr inline bool operator!=(const std::underlying_type_t<Bits>& a, const Bits& b) {
+            return a != static_cast<std::underlying_type_t<Bits>>(b);
         }
 
         template <typename Bits>
-        constexpr inline bool operator==(const Bits& a, const uint32_t& b) {
-            return b == static_cast<uint32_t>(a);
+        constexpr inline bool operator==(const Bits& a, const std::underlying_type_t<Bits>& b) {
+            return b == static_cast<std::underlying_type_t<Bits>>(a);
         }
 
         template <typename Bits>
-        constexpr inline bool operator!=(const Bits& a, const uint32_t& b) {
-            return b != static_cast<uint32_t>(a);
+        constexpr inline bool operator!=(const Bits& a, const std::underlying_type_t<Bits>& b) {
+            return b != static_cast<std::underlying_type_t<Bits>>(a);
         }
     }
 
@@ -533,6 +537,94 @@ namespace Graphics::Flags
             using VulkanCBits = VkAccessFlagBits;
         };
 
+        struct PipelineStage2
+        {
+            enum class Bits : uint64_t {
+                None                             = VK_PIPELINE_STAGE_2_NONE,
+                TopOfPipe                        = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT,
+                DrawIndirect                     = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                VertexInput                      = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT,
+                VertexShader                     = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                TessellationControlShader        = VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT,
+                TessellationEvaluationShader     = VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT,
+                GeometryShader                   = VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT,
+                FragmentShader                   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                EarlyFragmentTests               = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
+                LateFragmentTests                = VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                ColorAttachmentOutput            = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                ComputeShader                    = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                AllTransfer                      = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                BottomOfPipe                     = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT,
+                Host                             = VK_PIPELINE_STAGE_2_HOST_BIT,
+                AllGraphics                      = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT,
+                AllCommands                      = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                Copy                             = VK_PIPELINE_STAGE_2_COPY_BIT,
+                Resolve                          = VK_PIPELINE_STAGE_2_RESOLVE_BIT,
+                Blit                             = VK_PIPELINE_STAGE_2_BLIT_BIT,
+                Clear                            = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+                IndexInput                       = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT,
+                VertexAttributeInput             = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT,
+                PreRasterizationShaders          = VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT,
+                TransformFeedbackEXT             = VK_PIPELINE_STAGE_2_TRANSFORM_FEEDBACK_BIT_EXT,
+                ConditionalRenderingEXT          = VK_PIPELINE_STAGE_2_CONDITIONAL_RENDERING_BIT_EXT,
+                CommandPreprocessNV              = VK_PIPELINE_STAGE_2_COMMAND_PREPROCESS_BIT_NV,
+                FragmentShadingRateAttachmentKHR = VK_PIPELINE_STAGE_2_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR,
+                AccelerationStructureBuildKHR    = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                RayTracingShaderKHR              = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                FragmentDensityProcessEXT        = VK_PIPELINE_STAGE_2_FRAGMENT_DENSITY_PROCESS_BIT_EXT,
+                TaskShaderEXT                    = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+                MeshShaderEXT                    = VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_EXT
+            };
+
+            using VulkanFlags = vk::PipelineStageFlags2;
+            using VulkanBits = vk::PipelineStageFlagBits2;
+            using VulkanCFlags = VkPipelineStageFlags2;
+            using VulkanCBits = VkPipelineStageFlagBits2;
+        };
+
+        struct Access2
+        {
+            enum class Bits : uint64_t {
+                None                                 = VK_ACCESS_2_NONE,
+                IndirectCommandRead                  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                IndexRead                            = VK_ACCESS_2_INDEX_READ_BIT,
+                VertexAttributeRead                  = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT,
+                UniformRead                          = VK_ACCESS_2_UNIFORM_READ_BIT,
+                InputAttachmentRead                  = VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT,
+                ShaderRead                           = VK_ACCESS_2_SHADER_READ_BIT,
+                ShaderWrite                          = VK_ACCESS_2_SHADER_WRITE_BIT,
+                ColorAttachmentRead                  = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT,
+                ColorAttachmentWrite                 = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                DepthStencilAttachmentRead           = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                DepthStencilAttachmentWrite          = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                TransferRead                         = VK_ACCESS_2_TRANSFER_READ_BIT,
+                TransferWrite                        = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                HostRead                             = VK_ACCESS_2_HOST_READ_BIT,
+                HostWrite                            = VK_ACCESS_2_HOST_WRITE_BIT,
+                MemoryRead                           = VK_ACCESS_2_MEMORY_READ_BIT,
+                MemoryWrite                          = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                ShaderSampledRead                    = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                ShaderStorageRead                    = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                ShaderStorageWrite                   = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                TransformFeedbackWriteEXT            = VK_ACCESS_2_TRANSFORM_FEEDBACK_WRITE_BIT_EXT,
+                TransformFeedbackCounterReadEXT      = VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT,
+                TransformFeedbackCounterWriteEXT     = VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT,
+                ConditionalRenderingReadEXT          = VK_ACCESS_2_CONDITIONAL_RENDERING_READ_BIT_EXT,
+                CommandPreprocessReadNV              = VK_ACCESS_2_COMMAND_PREPROCESS_READ_BIT_NV,
+                CommandPreprocessWriteNV             = VK_ACCESS_2_COMMAND_PREPROCESS_WRITE_BIT_NV,
+                FragmentShadingRateAttachmentReadKHR = VK_ACCESS_2_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR,
+                AccelerationStructureReadKHR         = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR,
+                AccelerationStructureWriteKHR        = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                FragmentDensityMapReadEXT            = VK_ACCESS_2_FRAGMENT_DENSITY_MAP_READ_BIT_EXT,
+                ColorAttachmentReadNoncoherentEXT    = VK_ACCESS_2_COLOR_ATTACHMENT_READ_NONCOHERENT_BIT_EXT
+            };
+
+            using VulkanFlags = vk::AccessFlags2;
+            using VulkanBits = vk::AccessFlagBits2;
+            using VulkanCFlags = VkAccessFlags2;
+            using VulkanCBits = VkAccessFlagBits2;
+        };
+
         struct ImageUsage
         {
             enum class Bits : uint32_t {
@@ -674,6 +766,37 @@ namespace Graphics::Flags
             using VulkanCBits = VkFenceCreateFlagBits;
         };
 
+        struct ResolveMode
+        {
+            enum class Bits : uint32_t {
+                None = VK_RESOLVE_MODE_NONE,
+                SampleZero = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT,
+                Average = VK_RESOLVE_MODE_AVERAGE_BIT,
+                Min = VK_RESOLVE_MODE_MIN_BIT,
+                Max = VK_RESOLVE_MODE_MAX_BIT,
+            };
+
+            using VulkanFlags = vk::ResolveModeFlags;
+            using VulkanBits = vk::ResolveModeFlagBits;
+            using VulkanCFlags = VkResolveModeFlags;
+            using VulkanCBits = VkResolveModeFlagBits;
+        };
+
+        struct Rendering
+        {
+            enum class Bits : uint32_t {
+                None = 0,
+                ContentsSecondaryCommandBuffers = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT,
+                Suspending = VK_RENDERING_SUSPENDING_BIT,
+                Resuming = VK_RENDERING_RESUMING_BIT,
+            };
+
+            using VulkanFlags = vk::RenderingFlags;
+            using VulkanBits = vk::RenderingFlagBits;
+            using VulkanCFlags = VkRenderingFlags;
+            using VulkanCBits = VkRenderingFlagBits;
+        };
+
         struct CommandPoolCreate
         {
             enum class Bits : uint32_t {
@@ -1051,6 +1174,35 @@ namespace Graphics::Flags
             using VulkanCBits = VkQueryControlFlagBits;
         };
 
+        struct PipelineCacheCreate
+        {
+            enum class Bits : uint32_t {
+                None = 0,
+                ExternallySynchronized = VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT
+            };
+
+            using VulkanFlags = vk::PipelineCacheCreateFlags;
+            using VulkanBits = vk::PipelineCacheCreateFlagBits;
+            using VulkanCFlags = VkPipelineCacheCreateFlags;
+            using VulkanCBits = VkPipelineCacheCreateFlagBits;
+        };
+
+        struct QueryResult
+        {
+            enum class Bits : uint32_t {
+                None = 0,
+                Result64 = VK_QUERY_RESULT_64_BIT,
+                Wait = VK_QUERY_RESULT_WAIT_BIT,
+                WithAvailability = VK_QUERY_RESULT_WITH_AVAILABILITY_BIT,
+                Partial = VK_QUERY_RESULT_PARTIAL_BIT
+            };
+
+            using VulkanFlags = vk::QueryResultFlags;
+            using VulkanBits = vk::QueryResultFlagBits;
+            using VulkanCFlags = VkQueryResultFlags;
+            using VulkanCBits = VkQueryResultFlagBits;
+        };
+
         struct QueryPipelineStatistic
         {
             enum class Bits : uint32_t {
@@ -1196,6 +1348,18 @@ namespace Graphics::Flags
             using VulkanCFlags = VkDescriptorBindingFlags;
             using VulkanCBits = VkDescriptorBindingFlagBits;
         };
+
+        struct SemaphoreWait {
+            enum class Bits : uint32_t {
+                None = 0,
+                Any = VK_SEMAPHORE_WAIT_ANY_BIT
+            };
+
+            using VulkanFlags = vk::SemaphoreWaitFlags;
+            using VulkanBits = vk::SemaphoreWaitFlagBits;
+            using VulkanCFlags = VkSemaphoreWaitFlags;
+            using VulkanCBits = VkSemaphoreWaitFlagBits;
+        };
     }
 
     // Type aliases using FlagsBase with traits
@@ -1211,10 +1375,14 @@ namespace Graphics::Flags
     using PipelineStage = FlagsBase<Traits::PipelineStage>;
     using ShaderStage = FlagsBase<Traits::ShaderStage>;
     using Access = FlagsBase<Traits::Access>;
+    using PipelineStage2 = FlagsBase<Traits::PipelineStage2>;
+    using Access2 = FlagsBase<Traits::Access2>;
     using ImageUsage = FlagsBase<Traits::ImageUsage>;
     using ImageAspect = FlagsBase<Traits::ImageAspect>;
     using FormatFeature = FlagsBase<Traits::FormatFeature>;
     using FenceCreate = FlagsBase<Traits::FenceCreate>;
+    using ResolveMode = FlagsBase<Traits::ResolveMode>;
+    using Rendering = FlagsBase<Traits::Rendering>;
     using CommandPoolCreate = FlagsBase<Traits::CommandPoolCreate>;
     using CommandPoolReset = FlagsBase<Traits::CommandPoolReset>;
     using SurfaceTransform = FlagsBase<Traits::SurfaceTransform>;
@@ -1240,6 +1408,8 @@ namespace Graphics::Flags
     using DescriptorPoolCreate = FlagsBase<Traits::DescriptorPoolCreate>;
     using DescriptorPoolReset = FlagsBase<Traits::DescriptorPoolReset>;
     using QueryControl = FlagsBase<Traits::QueryControl>;
+    using QueryResult = FlagsBase<Traits::QueryResult>;
+    using PipelineCacheCreate = FlagsBase<Traits::PipelineCacheCreate>;
     using QueryPipelineStatistic = FlagsBase<Traits::QueryPipelineStatistic>;
     using SamplerCreate = FlagsBase<Traits::SamplerCreate>;
     using CommandBufferReset = FlagsBase<Traits::CommandBufferReset>;
@@ -1248,6 +1418,7 @@ namespace Graphics::Flags
     using ImageCreate = FlagsBase<Traits::ImageCreate>;
     using SurfaceCreate = FlagsBase<Traits::SurfaceCreate>;
     using DescriptorBinding = FlagsBase<Traits::DescriptorBinding>;
+    using SemaphoreWait = FlagsBase<Traits::SemaphoreWait>;
 
     // DebugUtils namespace
     namespace DebugUtils {
@@ -1267,10 +1438,14 @@ namespace Graphics::Flags
     template<> struct BitTraits<PipelineStage::Bits> { using ParentType = PipelineStage; };
     template<> struct BitTraits<ShaderStage::Bits> { using ParentType = ShaderStage; };
     template<> struct BitTraits<Access::Bits> { using ParentType = Access; };
+    template<> struct BitTraits<PipelineStage2::Bits> { using ParentType = PipelineStage2; };
+    template<> struct BitTraits<Access2::Bits> { using ParentType = Access2; };
     template<> struct BitTraits<ImageUsage::Bits> { using ParentType = ImageUsage; };
     template<> struct BitTraits<ImageAspect::Bits> { using ParentType = ImageAspect; };
     template<> struct BitTraits<FormatFeature::Bits> { using ParentType = FormatFeature; };
     template<> struct BitTraits<FenceCreate::Bits> { using ParentType = FenceCreate; };
+    template<> struct BitTraits<ResolveMode::Bits> { using ParentType = ResolveMode; };
+    template<> struct BitTraits<Rendering::Bits> { using ParentType = Rendering; };
     template<> struct BitTraits<CommandPoolCreate::Bits> { using ParentType = CommandPoolCreate; };
     template<> struct BitTraits<CommandPoolReset::Bits> { using ParentType = CommandPoolReset; };
     template<> struct BitTraits<DebugUtils::MessengerCallbackData::Bits> { using ParentType = DebugUtils::MessengerCallbackData; };
@@ -1296,6 +1471,8 @@ namespace Graphics::Flags
     template<> struct BitTraits<ColorComponent::Bits> { using ParentType = ColorComponent; };
     template<> struct BitTraits<DescriptorPoolReset::Bits> { using ParentType = DescriptorPoolReset; };
     template<> struct BitTraits<QueryControl::Bits> { using ParentType = QueryControl; };
+    template<> struct BitTraits<QueryResult::Bits> { using ParentType = QueryResult; };
+    template<> struct BitTraits<PipelineCacheCreate::Bits> { using ParentType = PipelineCacheCreate; };
     template<> struct BitTraits<QueryPipelineStatistic::Bits> { using ParentType = QueryPipelineStatistic; };
     template<> struct BitTraits<SamplerCreate::Bits> { using ParentType = SamplerCreate; };
     template<> struct BitTraits<CommandBufferReset::Bits> { using ParentType = CommandBufferReset; };
@@ -1304,4 +1481,5 @@ namespace Graphics::Flags
     template<> struct BitTraits<ImageCreate::Bits> { using ParentType = ImageCreate; };
     template<> struct BitTraits<SurfaceCreate::Bits> { using ParentType = SurfaceCreate; };
     template<> struct BitTraits<DescriptorBinding::Bits> { using ParentType = DescriptorBinding; };
+    template<> struct BitTraits<SemaphoreWait::Bits> { using ParentType = SemaphoreWait; };
 }
\ No newline at end of file
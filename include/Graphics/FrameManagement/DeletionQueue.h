@@ -0,0 +1,219 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Image.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Sampler.h"
+#include "Graphics/HandleTypes/QueryPool.h"
+#include "Graphics/HandleTypes/Pipeline.h"
+#include "Graphics/HandleTypes/PipelineCache.h"
+#include "Graphics/HandleTypes/RenderPass.h"
+#include "Graphics/HandleTypes/FrameBuffer.h"
+#include "Graphics/HandleTypes/ShaderModule.h"
+#include "Graphics/HandleTypes/DescriptorPool.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+#include "Graphics/HandleTypes/CommandPool.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/HandleTypes/Fence.h"
+#include "Graphics/HandleTypes/Semaphore.h"
+#include "Graphics/HandleTypes/SwapChain.h"
+#include "Graphics/MemoryManagement/MemoryPool.h"
+
+#include <deque>
+#include <tuple>
+#include <functional>
+#include <limits>
+
+namespace Graphics::FrameManagement
+{
+	// Takes ownership of device objects the GPU may still be using and destroys them once the value they were
+	// enqueued with completed. Values are points on one monotonic timeline, e.g. a FrameScheduler queue value or
+	// the frame number of a FrameContextManager, so collect only has to look at the front of each queue.
+	// Instance level objects (Instance, Device, Surface, Messenger) are never used by queued work and are not covered.
+	class DeletionQueue
+	{
+		template<typename T>
+		struct Pending {
+			uint64_t value;
+			T object;
+		};
+
+		struct PendingCommandBuffer {
+			CommandPoolRef pool;
+			CommandBuffer commandBuffer;
+		};
+
+		struct PendingDescriptorSet {
+			DescriptorPoolRef pool;
+			DescriptorSet set;
+		};
+
+		struct PendingAllocation {
+			MemoryManagement::MemoryPool* pool;
+			MemoryManagement::MemoryPool::Allocation allocation;
+		};
+
+		// views and framebuffers come first so they are gone before the objects they reference
+		std::tuple<
+			std::deque<Pending<ImageView>>,
+			std::deque<Pending<BufferView>>,
+			std::deque<Pending<FrameBuffer>>,
+			std::deque<Pending<Pipeline>>,
+			std::deque<Pending<ComputePipeline>>,
+			std::deque<Pending<PipelineLayout>>,
+			std::deque<Pending<PipelineCache>>,
+			std::deque<Pending<RenderPass>>,
+			std::deque<Pending<ShaderModule>>,
+			std::deque<Pending<DescriptorSetLayout>>,
+			std::deque<Pending<PendingDescriptorSet>>,
+			std::deque<Pending<DescriptorPool>>,
+			std::deque<Pending<PendingCommandBuffer>>,
+			std::deque<Pending<CommandPool>>,
+			std::deque<Pending<Sampler>>,
+			std::deque<Pending<QueryPool>>,
+			std::deque<Pending<Image>>,
+			std::deque<Pending<Buffer>>,
+			std::deque<Pending<PendingAllocation>>,
+			std::deque<Pending<Memory>>,
+			std::deque<Pending<Fence>>,
+			std::deque<Pending<Semaphore>>,
+			std::deque<Pending<SwapChain>>,
+			std::deque<Pending<std::function<void()>>>
+		> m_queues;
+
+		uint64_t m_lastValue = 0;
+		size_t m_pendingCount = 0;
+		size_t m_collectedCount = 0;
+
+	public:
+		DeletionQueue() = default;
+
+		DeletionQueue(const DeletionQueue&) = delete;
+		DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+		~DeletionQueue() { GRAPHICS_VERIFY(m_pendingCount == 0, "DeletionQueue was not flushed"); };
+
+		// takes over the object, the handle passed in is reset and may be created again right away
+		template<typename T> requires requires(const T& object) { object.isValid(); }
+		void enqueue(uint64_t value, T&& object)
+		{
+			static_assert(!std::is_lvalue_reference_v<T>, "Objects are moved into the DeletionQueue");
+			if (!object.isValid())
+				return;
+			push(value, std::move(object));
+		}
+
+		// frees a command buffer back to its pool, the pool itself has to outlive the value
+		void enqueue(uint64_t value, const CommandPoolRef& pool, const CommandBuffer& commandBuffer)
+		{
+			push(value, PendingCommandBuffer{ pool, commandBuffer });
+		}
+
+		// frees a set back to its pool, the pool has to be created with FreeDescriptorSet
+		void enqueue(uint64_t value, const DescriptorPoolRef& pool, const DescriptorSet& set)
+		{
+			push(value, PendingDescriptorSet{ pool, set });
+		}
+
+		// returns a MemoryPool allocation, the pool has to outlive the value
+		void enqueue(uint64_t value, MemoryManagement::MemoryPool& pool, const MemoryManagement::MemoryPool::Allocation& allocation)
+		{
+			push(value, PendingAllocation{ &pool, allocation });
+		}
+
+		// for everything that is not a plain handle, runs after every handle enqueued for the same value
+		void enqueue(uint64_t value, std::function<void()>&& deletion)
+		{
+			push(value, std::move(deletion));
+		}
+
+		// destroys everything enqueued with a value up to completedValue, returns the number of destroyed objects
+		size_t collect(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t completedValue)
+		{
+			if (m_pendingCount == 0)
+				return 0;
+
+			size_t collected = 0;
+			std::apply([&](auto&... queues) {
+				((collected += collectQueue(functions, device, queues, completedValue)), ...);
+			}, m_queues);
+
+			m_pendingCount -= collected;
+			m_collectedCount += collected;
+			return collected;
+		}
+
+		// destroys everything regardless of GPU progress, the caller has to make sure the device is idle
+		size_t flush(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			return collect(functions, device, std::numeric_limits<uint64_t>::max());
+		}
+
+		bool isEmpty() const { return m_pendingCount == 0; };
+		size_t getPendingCount() const { return m_pendingCount; };
+		size_t getCollectedCount() const { return m_collectedCount; };
+		void resetStatistics() { m_collectedCount = 0; };
+
+	private:
+		template<typename T>
+		void push(uint64_t value, T&& object)
+		{
+			GRAPHICS_VERIFY(value >= m_lastValue, "DeletionQueue values have to grow monotonically");
+			m_lastValue = value;
+			std::get<std::deque<Pending<T>>>(m_queues).push_back(Pending<T>{ value, std::move(object) });
+			++m_pendingCount;
+		}
+
+		template<typename T>
+		static size_t collectQueue(const DeviceFunctionTable& functions, const DeviceRef& device,
+			std::deque<Pending<T>>& queue, uint64_t completedValue)
+		{
+			size_t collected = 0;
+			while (!queue.empty() && queue.front().value <= completedValue)
+			{
+				destroyObject(functions, device, queue.front().object);
+				queue.pop_front();
+				++collected;
+			}
+			return collected;
+		}
+
+		template<typename T>
+		static void destroyObject(const DeviceFunctionTable& functions, const DeviceRef& device, T& object)
+		{
+			object.destroy(functions, device);
+		}
+
+		static void destroyObject(const DeviceFunctionTable& functions, const DeviceRef& device, ImageView& view)
+		{
+			view.destroy(device, functions);
+		}
+
+		static void destroyObject(const DeviceFunctionTable& functions, const DeviceRef& device, FrameBuffer& frameBuffer)
+		{
+			frameBuffer.destroy(device, functions);
+		}
+
+		static void destroyObject(const DeviceFunctionTable& functions, const DeviceRef& device, PendingCommandBuffer& pending)
+		{
+			pending.pool.freeCommandBuffer(functions, device, pending.commandBuffer);
+		}
+
+		static void destroyObject(const DeviceFunctionTable& functions, const DeviceRef& device, PendingDescriptorSet& pending)
+		{
+			pending.pool.freeSet(functions, device, pending.set);
+		}
+
+		static void destroyObject(const DeviceFunctionTable&, const DeviceRef&, PendingAllocation& pending)
+		{
+			pending.pool->free(pending.allocation);
+		}
+
+		static void destroyObject(const DeviceFunctionTable&, const DeviceRef&, std::function<void()>& deletion)
+		{
+			deletion();
+		}
+	};
+}
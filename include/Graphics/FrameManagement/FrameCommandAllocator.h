@@ -0,0 +1,164 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Flags.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/Fence.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/HandleTypes/CommandPool.h"
+
+#include <vector>
+
+namespace Graphics::FrameManagement
+{
+	// Hands out command buffers from one transient pool per frame in flight and per recording thread.
+	// Buffers are never freed individually: the whole pool of a frame is reset with vkResetCommandPool
+	// once the fence of that frame has signaled, and its buffers are reused from a cached list.
+	class FrameCommandAllocator
+	{
+		struct ThreadPool {
+			CommandPool pool;
+			std::vector<CommandBuffer> primaryBuffers;
+			std::vector<CommandBuffer> secondaryBuffers;
+			uint32_t primaryUsed = 0;
+			uint32_t secondaryUsed = 0;
+		};
+
+		// indexed by frameIndex * m_threadCount + threadIndex
+		std::vector<ThreadPool> m_pools;
+
+		uint32_t m_frameCount = 0;
+		uint32_t m_threadCount = 0;
+		uint32_t m_currentFrame = 0;
+	public:
+
+		FrameCommandAllocator() = default;
+
+		FrameCommandAllocator(const DeviceFunctionTable& functions, const DeviceRef& device,
+			uint32_t queueFamilyIndex, uint32_t framesInFlight, uint32_t threadCount = 1)
+		{
+			create(functions, device, queueFamilyIndex, framesInFlight, threadCount);
+		}
+
+		FrameCommandAllocator(FrameCommandAllocator&& other) noexcept
+		{
+			m_pools = std::exchange(other.m_pools, {});
+			m_frameCount = std::exchange(other.m_frameCount, 0);
+			m_threadCount = std::exchange(other.m_threadCount, 0);
+			m_currentFrame = std::exchange(other.m_currentFrame, 0);
+		}
+
+		FrameCommandAllocator& operator=(FrameCommandAllocator&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			GRAPHICS_VERIFY(m_pools.empty(), "Overwriting a FrameCommandAllocator that was not destroyed");
+			m_pools = std::exchange(other.m_pools, {});
+			m_frameCount = std::exchange(other.m_frameCount, 0);
+			m_threadCount = std::exchange(other.m_threadCount, 0);
+			m_currentFrame = std::exchange(other.m_currentFrame, 0);
+			return *this;
+		}
+
+		FrameCommandAllocator(const FrameCommandAllocator&) = delete;
+		FrameCommandAllocator& operator=(const FrameCommandAllocator&) = delete;
+
+		~FrameCommandAllocator() { GRAPHICS_VERIFY(m_pools.empty(), "FrameCommandAllocator was not destroyed"); };
+
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			uint32_t queueFamilyIndex, uint32_t framesInFlight, uint32_t threadCount = 1)
+		{
+			GRAPHICS_VERIFY(m_pools.empty(), "Trying to create a valid FrameCommandAllocator");
+			GRAPHICS_VERIFY(framesInFlight > 0 && threadCount > 0,
+				"FrameCommandAllocator needs at least one frame and one thread");
+
+			m_frameCount = framesInFlight;
+			m_threadCount = threadCount;
+			m_currentFrame = 0;
+			m_pools.resize(static_cast<size_t>(framesInFlight) * threadCount);
+
+			// individual buffers are never reset, so the pools dont need ResetCommandBuffer
+			CommandPoolCreateInfo createInfo(queueFamilyIndex, Flags::CommandPoolCreate::Bits::Transient);
+			for (auto& threadPool : m_pools)
+				threadPool.pool.create(functions, device, createInfo);
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			if (m_pools.empty())
+				return;
+
+			// destroying a pool frees every buffer allocated from it
+			for (auto& threadPool : m_pools)
+				threadPool.pool.destroy(functions, device);
+			m_pools.clear();
+			m_frameCount = 0;
+			m_threadCount = 0;
+			m_currentFrame = 0;
+		}
+
+		// waits for the fence guarding the frame, then recycles all of the frame's command buffers
+		void beginFrame(const DeviceFunctionTable& functions, const DeviceRef& device,
+			uint32_t frameIndex, const FenceRef& frameFence)
+		{
+			frameFence.wait(functions, device);
+			beginFrame(functions, device, frameIndex);
+		}
+
+		// the caller guarantees that the GPU is done with every buffer previously handed out for frameIndex
+		void beginFrame(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t frameIndex)
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frameCount, "Frame index is out of range");
+			m_currentFrame = frameIndex;
+
+			for (uint32_t thread = 0; thread < m_threadCount; ++thread)
+			{
+				auto& threadPool = getThreadPool(frameIndex, thread);
+				if (threadPool.primaryUsed == 0 && threadPool.secondaryUsed == 0)
+					continue;
+
+				// keep the pool memory around, the next frame will need roughly the same amount
+				threadPool.pool.reset(functions, device, Flags::CommandPoolReset::Bits::None);
+				threadPool.primaryUsed = 0;
+				threadPool.secondaryUsed = 0;
+			}
+		}
+
+		// returns a buffer in the initial state, only allocating when the cached list of the pool is exhausted.
+		// Each thread must only use its own threadIndex, no locking is done.
+		CommandBuffer acquire(const DeviceFunctionTable& functions, const DeviceRef& device,
+			uint32_t threadIndex = 0, CommandBufferLevel level = CommandBufferLevel::Primary)
+		{
+			GRAPHICS_VERIFY(threadIndex < m_threadCount, "Thread index is out of range");
+			auto& threadPool = getThreadPool(m_currentFrame, threadIndex);
+
+			bool primary = level == CommandBufferLevel::Primary;
+			auto& buffers = primary ? threadPool.primaryBuffers : threadPool.secondaryBuffers;
+			auto& used = primary ? threadPool.primaryUsed : threadPool.secondaryUsed;
+
+			if (used == buffers.size())
+				buffers.push_back(threadPool.pool.allocateCommandBuffer(functions, device, level));
+
+			return buffers[used++];
+		}
+
+		uint32_t getFrameCount() const { return m_frameCount; };
+		uint32_t getThreadCount() const { return m_threadCount; };
+		uint32_t getCurrentFrame() const { return m_currentFrame; };
+
+		CommandPoolRef getPool(uint32_t frameIndex, uint32_t threadIndex) const {
+			return m_pools[static_cast<size_t>(frameIndex) * m_threadCount + threadIndex].pool;
+		};
+
+		// number of buffers handed out for the current frame by the given thread
+		uint32_t getUsedCount(uint32_t threadIndex) const {
+			const auto& threadPool = m_pools[static_cast<size_t>(m_currentFrame) * m_threadCount + threadIndex];
+			return threadPool.primaryUsed + threadPool.secondaryUsed;
+		};
+
+	private:
+		ThreadPool& getThreadPool(uint32_t frameIndex, uint32_t threadIndex) {
+			return m_pools[static_cast<size_t>(frameIndex) * m_threadCount + threadIndex];
+		}
+	};
+}
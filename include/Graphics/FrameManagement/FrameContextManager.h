@@ -0,0 +1,221 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Flags.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/Fence.h"
+#include "Graphics/HandleTypes/Semaphore.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/HandleTypes/Queue.h"
+#include "Graphics/Utility/Utility.h"
+#include "FrameCommandAllocator.h"
+
+#include <vector>
+#include <functional>
+#include <array>
+#include <span>
+
+namespace Graphics::FrameManagement
+{
+	// slice of the per frame upload buffer, valid until the frame slot comes around again
+	struct UploadAllocation
+	{
+		BufferRef buffer;
+		DeviceSize offset = 0;
+		void* data = nullptr;
+	};
+
+	// Owns everything that is used by exactly one frame in flight: command pools, the fence signaled by
+	// the frame's submission, the acquire and render finished semaphores, a host visible upload buffer
+	// that is bump allocated and a list of deletions deferred until the frame retired.
+	// beginFrame only waits for the oldest frame, so the CPU can prepare up to N - 1 frames ahead of the GPU.
+	class FrameContextManager
+	{
+		struct FrameContext {
+			Fence fence;
+			Semaphore imageAvailable;
+			Semaphore renderFinished;
+
+			Buffer uploadBuffer;
+			Memory uploadMemory;
+			MemoryMapping uploadMapping;
+			DeviceSize uploadOffset = 0;
+
+			std::vector<std::function<void()>> deletions;
+			// the fence is only reset right before a submission, a frame without one stays signaled
+			bool submitted = false;
+		};
+
+		std::vector<FrameContext> m_frames;
+		FrameCommandAllocator m_commandAllocator;
+		DeviceSize m_uploadCapacity = 0;
+		uint32_t m_currentFrame = 0;
+		uint64_t m_frameNumber = 0;
+		bool m_inFrame = false;
+
+	public:
+		FrameContextManager() = default;
+
+		FrameContextManager(const FrameContextManager&) = delete;
+		FrameContextManager& operator=(const FrameContextManager&) = delete;
+
+		~FrameContextManager() { GRAPHICS_VERIFY(m_frames.empty(), "FrameContextManager was not destroyed"); };
+
+		// uploadCapacity is the size of the per frame upload buffer, no buffer is created when it is 0
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, uint32_t queueFamilyIndex,
+			uint32_t framesInFlight, DeviceSize uploadCapacity = 0, uint32_t recordingThreads = 1)
+		{
+			GRAPHICS_VERIFY(m_frames.empty(), "Trying to create a valid FrameContextManager");
+			GRAPHICS_VERIFY(framesInFlight > 0, "FrameContextManager needs at least one frame");
+
+			m_commandAllocator.create(functions, device, queueFamilyIndex, framesInFlight, recordingThreads);
+			m_uploadCapacity = uploadCapacity;
+			m_frames.resize(framesInFlight);
+			for (auto& frame : m_frames)
+			{
+				frame.fence.create(functions, device, FenceCreateInfo(Flags::FenceCreate::Bits::Signaled));
+				frame.imageAvailable.create(functions, device);
+				frame.renderFinished.create(functions, device);
+				if (uploadCapacity == 0)
+					continue;
+
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, frame.uploadBuffer,
+					frame.uploadMemory, uploadCapacity, Flags::BufferUsage::Bits::TransferSrc |
+					Flags::BufferUsage::Bits::UniformBuffer | Flags::BufferUsage::Bits::StorageBuffer |
+					Flags::BufferUsage::Bits::VertexBuffer | Flags::BufferUsage::Bits::IndexBuffer,
+					Flags::MemoryProperty::Bits::HostVisibleCoherent);
+				frame.uploadMapping = frame.uploadMemory.map(functions, device);
+			}
+			m_currentFrame = 0;
+			m_frameNumber = 0;
+			m_inFrame = false;
+		}
+
+		// waits for every frame still in flight, then releases all frame resources
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			if (m_frames.empty())
+				return;
+
+			waitForAllFrames(functions, device);
+			for (auto& frame : m_frames)
+			{
+				runDeletions(frame);
+				if (frame.uploadBuffer.isSet())
+				{
+					frame.uploadMemory.unmap(functions, device, frame.uploadMapping);
+					frame.uploadBuffer.destroy(functions, device);
+					frame.uploadMemory.destroy(functions, device);
+				}
+				frame.renderFinished.destroy(functions, device);
+				frame.imageAvailable.destroy(functions, device);
+				frame.fence.destroy(functions, device);
+			}
+			m_frames.clear();
+			m_commandAllocator.destroy(functions, device);
+		}
+
+		// waits until the GPU is done with the oldest frame and recycles its resources, returns the frame index
+		uint32_t beginFrame(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			GRAPHICS_VERIFY(!m_inFrame, "endFrame was not called for the previous frame");
+			auto& frame = m_frames[m_currentFrame];
+			frame.fence.wait(functions, device);
+			frame.submitted = false;
+
+			runDeletions(frame);
+			frame.uploadOffset = 0;
+			m_commandAllocator.beginFrame(functions, device, m_currentFrame);
+			m_inFrame = true;
+			return m_currentFrame;
+		}
+
+		// command buffer of the current frame in the initial state, see FrameCommandAllocator::acquire
+		CommandBuffer acquireCommandBuffer(const DeviceFunctionTable& functions, const DeviceRef& device,
+			uint32_t threadIndex = 0, CommandBufferLevel level = CommandBufferLevel::Primary)
+		{
+			GRAPHICS_VERIFY(m_inFrame, "Command buffers can only be acquired between beginFrame and endFrame");
+			return m_commandAllocator.acquire(functions, device, threadIndex, level);
+		}
+
+		// bump allocation from the current frame's upload buffer, throws when the frame ran out of space
+		UploadAllocation allocateUpload(DeviceSize size, DeviceSize alignment = 16)
+		{
+			GRAPHICS_VERIFY(m_inFrame, "Uploads can only be allocated between beginFrame and endFrame");
+			auto& frame = m_frames[m_currentFrame];
+			DeviceSize offset = (frame.uploadOffset + alignment - 1) / alignment * alignment;
+			if (offset + size > m_uploadCapacity)
+				throw std::runtime_error("Upload size exceeds the FrameContextManager per frame capacity");
+
+			frame.uploadOffset = offset + size;
+			return { frame.uploadBuffer, offset, frame.uploadMapping.get<uint8_t>(static_cast<size_t>(offset)) };
+		}
+
+		// runs once the GPU finished the current frame, e.g. destroying a buffer the frame still reads
+		void deferDeletion(std::function<void()>&& deletion)
+		{
+			GRAPHICS_VERIFY(m_inFrame, "Deletions can only be deferred between beginFrame and endFrame");
+			m_frames[m_currentFrame].deletions.push_back(std::move(deletion));
+		}
+
+		// submits the frame's command buffers, waiting for the acquired image at waitStage when waitForImage is set
+		// and signaling renderFinished and the frame fence
+		void submit(const DeviceFunctionTable& functions, const DeviceRef& device, const Queue& queue,
+			std::span<const CommandBuffer> commandBuffers, bool waitForImage = true,
+			Flags::PipelineStage waitStage = Flags::PipelineStage::Bits::ColorAttachmentOutput)
+		{
+			GRAPHICS_VERIFY(m_inFrame, "Submissions can only be made between beginFrame and endFrame");
+			auto& frame = m_frames[m_currentFrame];
+			GRAPHICS_VERIFY(!frame.submitted, "The frame fence can only be signaled by one submission");
+
+			std::array<SemaphoreRef, 1> waitSemaphores = { frame.imageAvailable };
+			std::array<SemaphoreRef, 1> signalSemaphores = { frame.renderFinished };
+			std::span<const SemaphoreRef> waits(waitSemaphores.data(), waitForImage ? 1 : 0);
+			QueueSubmitInfo submitInfo(commandBuffers, std::span<const Flags::PipelineStage>(&waitStage, waits.size()),
+				waits, signalSemaphores);
+
+			frame.fence.reset(functions, device);
+			queue.submit(functions, submitInfo, frame.fence);
+			frame.submitted = true;
+		}
+
+		// moves on to the next frame, a frame that never submitted keeps its fence signaled
+		void endFrame()
+		{
+			GRAPHICS_VERIFY(m_inFrame, "beginFrame was not called");
+			m_currentFrame = (m_currentFrame + 1) % static_cast<uint32_t>(m_frames.size());
+			++m_frameNumber;
+			m_inFrame = false;
+		}
+
+		// waits for the fences of all frames, enough before recreating the swap chain
+		// without idling queues the frames never used
+		void waitForAllFrames(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			std::vector<FenceRef> fences;
+			fences.reserve(m_frames.size());
+			for (const auto& frame : m_frames)
+				fences.push_back(frame.fence);
+			Fence::wait(functions, device, fences);
+		}
+
+		SemaphoreRef getImageAvailableSemaphore() const { return m_frames[m_currentFrame].imageAvailable; };
+		SemaphoreRef getRenderFinishedSemaphore() const { return m_frames[m_currentFrame].renderFinished; };
+		FenceRef getFence() const { return m_frames[m_currentFrame].fence; };
+
+		uint32_t getCurrentFrame() const { return m_currentFrame; };
+		uint32_t getFramesInFlight() const { return static_cast<uint32_t>(m_frames.size()); };
+		uint64_t getFrameNumber() const { return m_frameNumber; };
+		DeviceSize getUploadUsage() const { return m_frames[m_currentFrame].uploadOffset; };
+
+	private:
+		static void runDeletions(FrameContext& frame)
+		{
+			for (auto& deletion : frame.deletions)
+				deletion();
+			frame.deletions.clear();
+		}
+	};
+}
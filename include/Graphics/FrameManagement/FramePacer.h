@@ -0,0 +1,169 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/SwapChain.h"
+
+#include <deque>
+#include <span>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+namespace Graphics::FrameManagement
+{
+	struct FramePacingStatistics
+	{
+		// CPU time from acquiring the image to handing it to present
+		std::chrono::nanoseconds acquireToPresent{ 0 };
+		// from acquire until the image was on screen, only measured with present wait. Approximate: the display
+		// time is taken when waitForPresent returns on the CPU, which is after the actual scanout started
+		std::chrono::nanoseconds acquireToDisplay{ 0 };
+		// time between two displayed frames, only measured with present wait, approximate like acquireToDisplay
+		std::chrono::nanoseconds displayInterval{ 0 };
+		uint64_t presentedFrames = 0;
+		uint64_t displayedFrames = 0;
+	};
+
+	// Limits how many presents may be queued ahead of the display and measures the latency of every frame.
+	// With VK_KHR_present_wait/present_id every present carries an id and waitForFrameSlot blocks on the display
+	// of an older one, otherwise only the CPU side is measured and the frame fences are the only limit.
+	// Display times are approximated by the CPU time at which waitForPresent returned, there is no present
+	// timing query, so they lag the real scanout by the wakeup latency of the waiting thread.
+	// In low latency mode a single present is queued and the wait is stretched so the frame starts, and samples
+	// its input, as late as the measured work time still allows to make the next display refresh.
+	class FramePacer
+	{
+		using Clock = std::chrono::steady_clock;
+
+		struct PendingPresent {
+			uint64_t id;
+			Clock::time_point acquireTime;
+			Clock::time_point presentTime;
+		};
+
+		bool m_presentWait = false;
+		bool m_lowLatency = false;
+		uint32_t m_maxQueuedPresents = 2;
+		std::chrono::nanoseconds m_presentTimeout = std::chrono::milliseconds(100);
+		std::chrono::nanoseconds m_latencyMargin = std::chrono::microseconds(500);
+		std::chrono::nanoseconds m_gpuTimeEstimate{ 0 };
+
+		std::deque<PendingPresent> m_pending;
+		uint64_t m_nextPresentId = 1;
+		Clock::time_point m_acquireTime;
+		Clock::time_point m_lastDisplayTime;
+		FramePacingStatistics m_statistics;
+
+	public:
+		FramePacer() = default;
+
+		// presentWait has to match whether presentWait and presentId were enabled on the device
+		FramePacer(bool presentWait, uint32_t maxQueuedPresents = 2, bool lowLatency = false)
+		{
+			setPresentWait(presentWait);
+			setMaxQueuedPresents(maxQueuedPresents);
+			setLowLatency(lowLatency);
+		}
+
+		void setPresentWait(bool presentWait) { m_presentWait = presentWait; };
+		void setMaxQueuedPresents(uint32_t maxQueuedPresents) { m_maxQueuedPresents = std::max(maxQueuedPresents, 1u); };
+		void setLowLatency(bool lowLatency) { m_lowLatency = lowLatency; };
+		// presents not displayed within the timeout are dropped from pacing, e.g. while the window is hidden
+		void setPresentTimeout(std::chrono::nanoseconds timeout) { m_presentTimeout = timeout; };
+		// safety margin subtracted from the low latency start time
+		void setLatencyMargin(std::chrono::nanoseconds margin) { m_latencyMargin = margin; };
+		// GPU time of a frame, e.g. from GPU timestamps, added to the CPU time when predicting the start time
+		void setGpuTimeEstimate(std::chrono::nanoseconds gpuTime) { m_gpuTimeEstimate = gpuTime; };
+
+		bool usesPresentWait() const { return m_presentWait; };
+		bool isLowLatency() const { return m_lowLatency; };
+		uint32_t getMaxQueuedPresents() const { return m_lowLatency ? 1 : m_maxQueuedPresents; };
+
+		// call before acquiring the next image and before sampling input for the frame
+		void waitForFrameSlot(const DeviceFunctionTable& functions, const DeviceRef& device, const SwapChainRef& swapChain)
+		{
+			if (!m_presentWait)
+				return;
+
+			while (m_pending.size() >= getMaxQueuedPresents())
+			{
+				auto pending = m_pending.front();
+				m_pending.pop_front();
+				auto result = swapChain.waitForPresent(functions, device, pending.id,
+					static_cast<uint64_t>(m_presentTimeout.count()));
+				// the wakeup time stands in for the display time
+				if (result == Result::Success || result == Result::SuboptimalKHR)
+					recordDisplay(pending, Clock::now());
+			}
+
+			if (m_lowLatency)
+				delayFrameStart();
+		}
+
+		// call right after the image was acquired
+		void onAcquire() { m_acquireTime = Clock::now(); };
+
+		// call right before presenting, the returned id goes into PresentIdInfo when present wait is used
+		uint64_t onPresent()
+		{
+			auto now = Clock::now();
+			uint64_t presentId = m_nextPresentId++;
+			updateAverage(m_statistics.acquireToPresent, now - m_acquireTime);
+			++m_statistics.presentedFrames;
+			if (m_presentWait)
+				m_pending.push_back({ presentId, m_acquireTime, now });
+			return presentId;
+		}
+
+		// drops pending presents, e.g. after the swap chain was recreated and old ids can not be waited for
+		void reset() { m_pending.clear(); };
+
+		const FramePacingStatistics& getStatistics() const { return m_statistics; };
+		void resetStatistics() { m_statistics = {}; };
+
+		// Mailbox replaces queued images and has the lowest latency without tearing, Fifo paces to the display
+		// and is always supported. Low latency prefers Mailbox, otherwise Fifo keeps the frame rate stable.
+		static PresentMode choosePresentMode(std::span<const PresentMode> available, bool lowLatency)
+		{
+			auto supports = [&](PresentMode mode) {
+				return std::find(available.begin(), available.end(), mode) != available.end();
+			};
+			if (lowLatency && supports(PresentMode::Mailbox))
+				return PresentMode::Mailbox;
+			return PresentMode::Fifo;
+		}
+
+	private:
+		// displayTime is an approximation, see the class comment
+		void recordDisplay(const PendingPresent& pending, Clock::time_point displayTime)
+		{
+			updateAverage(m_statistics.acquireToDisplay, displayTime - pending.acquireTime);
+			if (m_statistics.displayedFrames > 0)
+				updateAverage(m_statistics.displayInterval, displayTime - m_lastDisplayTime);
+			m_lastDisplayTime = displayTime;
+			++m_statistics.displayedFrames;
+		}
+
+		// the previous frame was just displayed, the next refresh follows one display interval later
+		void delayFrameStart()
+		{
+			if (m_statistics.displayedFrames < 2)
+				return;
+
+			auto workTime = m_statistics.acquireToPresent + m_gpuTimeEstimate + m_latencyMargin;
+			auto startTime = m_lastDisplayTime + m_statistics.displayInterval - workTime;
+			if (startTime > Clock::now())
+				std::this_thread::sleep_until(startTime);
+		}
+
+		// exponential moving average, reacts within a few frames without jumping on single spikes
+		template<typename Duration>
+		void updateAverage(std::chrono::nanoseconds& average, Duration sample)
+		{
+			auto value = std::chrono::duration_cast<std::chrono::nanoseconds>(sample);
+			average = average.count() == 0 ? value : (average * 7 + value) / 8;
+		}
+	};
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Flags.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/Fence.h"
+#include "Graphics/HandleTypes/Semaphore.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/HandleTypes/Queue.h"
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <algorithm>
+
+namespace Graphics::FrameManagement
+{
+	// position on the timeline of one scheduler queue, the work submitted with it
+	// has finished once the timeline semaphore of that queue reached the value
+	struct TimelinePoint
+	{
+		uint32_t queue = 0;
+		uint64_t value = 0;
+	};
+
+	struct TimelineSubmission
+	{
+		std::span<const CommandBuffer> commandBuffers;
+		// points on the timelines of other queues this submission has to wait for
+		std::span<const TimelinePoint> waitPoints;
+		std::span<const Flags::PipelineStage> waitPointStages;
+		// binary semaphores, e.g. for swap chain image acquisition and presentation
+		std::span<const SemaphoreRef> waitSemaphores;
+		std::span<const Flags::PipelineStage> waitSemaphoreStages;
+		std::span<const SemaphoreRef> signalSemaphores;
+	};
+
+	// Tracks GPU progress with one timeline semaphore per queue. Every submission signals the next value
+	// of its queue, so "has this work retired" is a comparison against the last known counter value
+	// and frames in flight are paced by waiting on the values recorded N frames ago instead of per frame fences.
+	class FrameScheduler
+	{
+		struct QueueTimeline {
+			Semaphore semaphore;
+			uint64_t submitted = 0;
+			// last counter value read from the device, only ever grows
+			uint64_t completed = 0;
+		};
+
+		std::vector<QueueTimeline> m_queues;
+		// [frame slot][queue] values submitted up to the end of the frame that used the slot
+		std::vector<std::vector<uint64_t>> m_frameValues;
+		uint32_t m_frameSlot = 0;
+		uint64_t m_frameNumber = 0;
+
+		// reused between submissions to avoid allocations
+		std::vector<SemaphoreRef> m_waitSemaphores;
+		std::vector<Flags::PipelineStage> m_waitStages;
+		std::vector<uint64_t> m_waitValues;
+		std::vector<SemaphoreRef> m_signalSemaphores;
+		std::vector<uint64_t> m_signalValues;
+
+	public:
+		FrameScheduler() = default;
+
+		FrameScheduler(const FrameScheduler&) = delete;
+		FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+		~FrameScheduler() { GRAPHICS_VERIFY(m_queues.empty(), "FrameScheduler was not destroyed"); };
+
+		// queueCount is the number of queues whose work is tracked, indices are chosen by the caller
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			uint32_t queueCount, uint32_t framesInFlight)
+		{
+			GRAPHICS_VERIFY(m_queues.empty(), "Trying to create a valid FrameScheduler");
+			GRAPHICS_VERIFY(queueCount > 0 && framesInFlight > 0, "FrameScheduler needs at least one queue and one frame");
+
+			m_queues.resize(queueCount);
+			for (auto& queue : m_queues)
+				queue.semaphore.createTimeline(functions, device);
+
+			m_frameValues.assign(framesInFlight, std::vector<uint64_t>(queueCount, 0));
+			m_frameSlot = 0;
+			m_frameNumber = 0;
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			for (auto& queue : m_queues)
+				queue.semaphore.destroy(functions, device);
+			m_queues.clear();
+			m_frameValues.clear();
+		}
+
+		// waits until the GPU finished the frame that last used the current slot, returns the slot index
+		uint32_t beginFrame(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			const auto& values = m_frameValues[m_frameSlot];
+			for (uint32_t queue = 0; queue < m_queues.size(); ++queue)
+				wait(functions, device, { queue, values[queue] });
+			return m_frameSlot;
+		}
+
+		// remembers what the frame submitted and moves on to the next slot
+		void endFrame()
+		{
+			auto& values = m_frameValues[m_frameSlot];
+			for (size_t queue = 0; queue < m_queues.size(); ++queue)
+				values[queue] = m_queues[queue].submitted;
+			m_frameSlot = (m_frameSlot + 1) % static_cast<uint32_t>(m_frameValues.size());
+			++m_frameNumber;
+		}
+
+		// submits to queue and signals the next value of its timeline, the returned point retires with the work
+		TimelinePoint submit(const DeviceFunctionTable& functions, uint32_t queueIndex, const Queue& queue,
+			const TimelineSubmission& submission, const FenceRef& fence = FenceRef())
+		{
+			GRAPHICS_VERIFY(queueIndex < m_queues.size(), "Queue index is out of range");
+			GRAPHICS_VERIFY(submission.waitPoints.size() == submission.waitPointStages.size() &&
+				submission.waitSemaphores.size() == submission.waitSemaphoreStages.size(),
+				"Every wait needs its stages");
+
+			m_waitSemaphores.clear();
+			m_waitStages.clear();
+			m_waitValues.clear();
+			for (size_t i = 0; i < submission.waitPoints.size(); ++i)
+			{
+				const auto& point = submission.waitPoints[i];
+				GRAPHICS_VERIFY(point.queue < m_queues.size(), "Queue index is out of range");
+				m_waitSemaphores.push_back(m_queues[point.queue].semaphore);
+				m_waitStages.push_back(submission.waitPointStages[i]);
+				m_waitValues.push_back(point.value);
+			}
+			for (size_t i = 0; i < submission.waitSemaphores.size(); ++i)
+			{
+				m_waitSemaphores.push_back(submission.waitSemaphores[i]);
+				m_waitStages.push_back(submission.waitSemaphoreStages[i]);
+				m_waitValues.push_back(0);
+			}
+
+			auto& timeline = m_queues[queueIndex];
+			TimelinePoint point{ queueIndex, timeline.submitted + 1 };
+			m_signalSemaphores.assign(1, timeline.semaphore);
+			m_signalValues.assign(1, point.value);
+			for (const auto& semaphore : submission.signalSemaphores)
+			{
+				m_signalSemaphores.push_back(semaphore);
+				m_signalValues.push_back(0);
+			}
+
+			TimelineSemaphoreSubmitInfo timelineValues(m_waitValues, m_signalValues);
+			QueueSubmitInfo submitInfo(submission.commandBuffers, m_waitStages, m_waitSemaphores, m_signalSemaphores);
+			submitInfo.setTimelineValues(timelineValues);
+			queue.submit(functions, submitInfo, fence);
+
+			timeline.submitted = point.value;
+			return point;
+		}
+
+		// point that retires once everything submitted to the queue so far has finished
+		TimelinePoint getLastSubmitted(uint32_t queue) const { return { queue, m_queues[queue].submitted }; };
+
+		// answers from the cached counter value and only asks the device when that is not enough
+		bool isComplete(const DeviceFunctionTable& functions, const DeviceRef& device, const TimelinePoint& point)
+		{
+			auto& timeline = m_queues[point.queue];
+			if (point.value <= timeline.completed)
+				return true;
+			timeline.completed = std::max(timeline.completed, timeline.semaphore.getCounterValue(functions, device));
+			return point.value <= timeline.completed;
+		}
+
+		// refreshes and returns the counter value of the queue's timeline, e.g. for DeletionQueue::collect
+		uint64_t getCompletedValue(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t queue)
+		{
+			auto& timeline = m_queues[queue];
+			timeline.completed = std::max(timeline.completed, timeline.semaphore.getCounterValue(functions, device));
+			return timeline.completed;
+		}
+
+		// cached answer only, may report work as pending that already finished
+		bool isKnownComplete(const TimelinePoint& point) const { return point.value <= m_queues[point.queue].completed; };
+
+		// returns false when the timeout (in nanoseconds) ran out first
+		bool wait(const DeviceFunctionTable& functions, const DeviceRef& device, const TimelinePoint& point,
+			uint64_t timeout = std::numeric_limits<uint64_t>::max())
+		{
+			auto& timeline = m_queues[point.queue];
+			GRAPHICS_VERIFY(point.value <= timeline.submitted, "Waiting for a value that was never submitted");
+			if (point.value <= timeline.completed)
+				return true;
+			if (!timeline.semaphore.wait(functions, device, point.value, timeout))
+				return false;
+			timeline.completed = point.value;
+			return true;
+		}
+
+		// waits for all submitted work, a waitIdle limited to the tracked queues
+		void waitAll(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			for (uint32_t queue = 0; queue < m_queues.size(); ++queue)
+				wait(functions, device, getLastSubmitted(queue));
+		}
+
+		SemaphoreRef getSemaphore(uint32_t queue) const { return m_queues[queue].semaphore; };
+		uint32_t getFrameSlot() const { return m_frameSlot; };
+		uint32_t getFramesInFlight() const { return static_cast<uint32_t>(m_frameValues.size()); };
+		uint64_t getFrameNumber() const { return m_frameNumber; };
+	};
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/SwapChain.h"
+#include "Graphics/HandleTypes/RenderPass.h"
+#include "Graphics/Utility/Structs.h"
+#include "Graphics/Utility/Utility.h"
+#include "DeletionQueue.h"
+
+#include <chrono>
+#include <optional>
+
+namespace Graphics::FrameManagement
+{
+	// Recreates a Utility::SwapChainData without waiting for the device. The new swap chain is created with the
+	// old one as oldSwapchain, new views, frame buffers and depth buffer are built next to the old ones and
+	// everything old is handed to a DeletionQueue at a value that retires after the last frame using it.
+	// Resize events are debounced so dragging a window edge recreates once the size settled instead of every event.
+	class SwapChainRecreator
+	{
+		std::optional<Extent2D> m_pendingExtent;
+		std::chrono::steady_clock::time_point m_lastRequest;
+		std::chrono::steady_clock::duration m_debounceDelay = std::chrono::milliseconds(50);
+		bool m_outOfDate = false;
+		uint32_t m_recreationCount = 0;
+
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		SwapChainRecreator() = default;
+		explicit SwapChainRecreator(Clock::duration debounceDelay) : m_debounceDelay(debounceDelay) {};
+
+		void setDebounceDelay(Clock::duration debounceDelay) { m_debounceDelay = debounceDelay; };
+
+		// call on every resize event, only the last extent of a burst is used
+		void requestResize(const Extent2D& extent, Clock::time_point now = Clock::now())
+		{
+			m_pendingExtent = extent;
+			m_lastRequest = now;
+		}
+
+		// acquire or present returned OutOfDate, the swap chain can not be used anymore and is recreated
+		// on the next update without waiting for the debounce delay
+		void markOutOfDate(const Extent2D& extent)
+		{
+			m_pendingExtent = extent;
+			m_outOfDate = true;
+		}
+
+		bool isPending() const { return m_pendingExtent.has_value(); };
+		bool isOutOfDate() const { return m_outOfDate; };
+
+		// recreates data when a pending resize settled, returns true when it did. retireValue has to complete
+		// after every frame that rendered to or presented the current images, e.g. FrameScheduler::getLastSubmitted.
+		// renderPass may be empty for swap chains used with dynamic rendering, no frame buffers are created then.
+		bool update(const DeviceFunctionTable& functions, const DeviceRef& device, Utility::SwapChainData& data,
+			const RenderPassRef& renderPass, DeletionQueue& deletionQueue, uint64_t retireValue,
+			Clock::time_point now = Clock::now())
+		{
+			if (!m_pendingExtent)
+				return false;
+			if (!m_outOfDate && now - m_lastRequest < m_debounceDelay)
+				return false;
+			// minimized windows report a zero extent, a swap chain can not be created for it
+			if (m_pendingExtent->width == 0 || m_pendingExtent->height == 0)
+				return false;
+
+			recreate(functions, device, data, renderPass, deletionQueue, retireValue, *m_pendingExtent);
+			m_pendingExtent.reset();
+			m_outOfDate = false;
+			++m_recreationCount;
+			return true;
+		}
+
+		uint32_t getRecreationCount() const { return m_recreationCount; };
+
+		// the non debounced part of update, usable on its own
+		static void recreate(const DeviceFunctionTable& functions, const DeviceRef& device, Utility::SwapChainData& data,
+			const RenderPassRef& renderPass, DeletionQueue& deletionQueue, uint64_t retireValue, const Extent2D& extent)
+		{
+			data.swapChainInfo.setImageExtent(extent);
+			SwapChain retiredSwapChain;
+			data.swapChain.recreate(functions, device, data.swapChainInfo, retiredSwapChain);
+			data.swapChainImages = data.swapChain.getImages(functions, device);
+			deletionQueue.enqueue(retireValue, std::move(retiredSwapChain));
+
+			Utility::recreateSwapChainImageResources(data, functions, device, renderPass, extent,
+				&deletionQueue, retireValue);
+		}
+	};
+}
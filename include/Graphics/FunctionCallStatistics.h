@@ -0,0 +1,146 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <ostream>
+
+namespace Graphics {
+
+    struct FunctionCallEntry {
+        const char* name = nullptr;
+        uint64_t callCount = 0;
+        std::chrono::nanoseconds totalTime{ 0 };
+
+        std::chrono::nanoseconds getAverageTime() const {
+            return callCount == 0 ? std::chrono::nanoseconds(0) : totalTime / static_cast<int64_t>(callCount);
+        }
+    };
+
+    // Call counts and wall time per function of one function enum, filled by FunctionTable::execute when
+    // GRAPHICS_ENABLE_CALL_STATISTICS is defined. Every thread counts into its own array indexed by the enum value,
+    // only its own thread writes it, so counting needs no read-modify-write. The arrays are registered once
+    // per thread and folded into the retired totals when the thread exits.
+    template<typename FunctionEnum>
+    class FunctionCallStatistics
+    {
+        static constexpr size_t s_count = static_cast<size_t>(FunctionEnum::Num);
+
+        struct Counter {
+            std::atomic<uint64_t> calls = 0;
+            std::atomic<uint64_t> nanoseconds = 0;
+        };
+
+        struct Totals {
+            std::array<uint64_t, s_count> calls = {};
+            std::array<uint64_t, s_count> nanoseconds = {};
+        };
+
+        struct ThreadCounters {
+            std::array<Counter, s_count> counters;
+
+            ThreadCounters() {
+                std::lock_guard lock(s_mutex);
+                s_threads.push_back(this);
+            }
+
+            ~ThreadCounters() {
+                std::lock_guard lock(s_mutex);
+                for (size_t i = 0; i < s_count; ++i) {
+                    s_retired.calls[i] += counters[i].calls.load(std::memory_order_relaxed);
+                    s_retired.nanoseconds[i] += counters[i].nanoseconds.load(std::memory_order_relaxed);
+                }
+                std::erase(s_threads, this);
+            }
+        };
+
+        static inline std::mutex s_mutex;
+        static inline std::vector<ThreadCounters*> s_threads;
+        static inline Totals s_retired;
+
+        static ThreadCounters& getThreadCounters() {
+            thread_local ThreadCounters counters;
+            return counters;
+        }
+
+    public:
+        FunctionCallStatistics() = delete;
+
+        static void record(size_t function, std::chrono::nanoseconds duration) {
+            auto& counter = getThreadCounters().counters[function];
+            counter.calls.store(counter.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            counter.nanoseconds.store(counter.nanoseconds.load(std::memory_order_relaxed) +
+                static_cast<uint64_t>(duration.count()), std::memory_order_relaxed);
+        }
+
+        // names are indexed by the enum value, functions that were never called are left out,
+        // the rest is sorted by total time, the most expensive first
+        static std::vector<FunctionCallEntry> getReport(const std::array<const char*, s_count>& names) {
+            Totals totals;
+            {
+                std::lock_guard lock(s_mutex);
+                totals = s_retired;
+                for (const auto* thread : s_threads) {
+                    for (size_t i = 0; i < s_count; ++i) {
+                        totals.calls[i] += thread->counters[i].calls.load(std::memory_order_relaxed);
+                        totals.nanoseconds[i] += thread->counters[i].nanoseconds.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            std::vector<FunctionCallEntry> report;
+            for (size_t i = 0; i < s_count; ++i) {
+                if (totals.calls[i] == 0)
+                    continue;
+                report.push_back({ names[i], totals.calls[i],
+                    std::chrono::nanoseconds(static_cast<int64_t>(totals.nanoseconds[i])) });
+            }
+            std::sort(report.begin(), report.end(), [](const FunctionCallEntry& a, const FunctionCallEntry& b) {
+                return a.totalTime > b.totalTime;
+            });
+            return report;
+        }
+
+        // counts of running threads are cleared by their owners' next store racing with this one at worst,
+        // which only loses that single call
+        static void reset() {
+            std::lock_guard lock(s_mutex);
+            s_retired = Totals{};
+            for (auto* thread : s_threads) {
+                for (auto& counter : thread->counters) {
+                    counter.calls.store(0, std::memory_order_relaxed);
+                    counter.nanoseconds.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        static void writeReport(std::ostream& stream, const std::vector<FunctionCallEntry>& report) {
+            for (const auto& entry : report) {
+                stream << entry.name << ": " << entry.callCount << " calls, "
+                    << std::chrono::duration<double, std::milli>(entry.totalTime).count() << " ms total, "
+                    << std::chrono::duration<double, std::micro>(entry.getAverageTime()).count() << " us average\n";
+            }
+        }
+    };
+
+    // measures one call from construction to destruction
+    template<typename FunctionEnum>
+    class FunctionCallTimer
+    {
+        size_t m_function;
+        std::chrono::steady_clock::time_point m_start;
+
+    public:
+        explicit FunctionCallTimer(size_t function) : m_function(function), m_start(std::chrono::steady_clock::now()) {};
+
+        FunctionCallTimer(const FunctionCallTimer&) = delete;
+        FunctionCallTimer& operator=(const FunctionCallTimer&) = delete;
+
+        ~FunctionCallTimer() {
+            FunctionCallStatistics<FunctionEnum>::record(m_function,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start));
+        }
+    };
+}
@@ -1,5 +1,10 @@
 #pragma once
 #include <array>
+#include "Common.h"
+#include "FunctionCallStatistics.h"
+#ifdef GRAPHICS_ENABLE_CAPTURE
+#include "ApiCapture.h"
+#endif
 
 namespace Graphics {
 
@@ -68,6 +73,10 @@ namespace Graphics {
         GetProcAddrType m_getProcAddr;
 
     public:
+        using FunctionEnumType = FunctionEnum;
+
+        template<FunctionEnum func>
+        using FunctionType = typename FunctionTraits<func>::Type;
 
         FunctionTable() = default;
         FunctionTable(GetProcAddrType getProcAddr) : m_getProcAddr(getProcAddr) {};
@@ -99,11 +108,13 @@ namespace Graphics {
             execute(Args&&... args) const {
             static_assert(IsInvocableWithConvertibleArgs_v<typename FunctionTraits<func>::Type, Args...>,
                 "Arguments are not convertible to function parameter types");
-#ifdef _DEBUG
-            if (!isLoaded<func>()) {
-                throw std::runtime_error(std::string("Vulkan function not loaded: ") +
-                    FunctionTraits<func>::name);
-            }
+            GRAPHICS_VERIFY_FULL(isLoaded<func>(), std::string("Vulkan function not loaded: ") + FunctionTraits<func>::name);
+#ifdef GRAPHICS_ENABLE_CALL_STATISTICS
+            FunctionCallTimer<FunctionEnum> timer(static_cast<size_t>(func));
+#endif
+#ifdef GRAPHICS_ENABLE_CAPTURE
+            if (ApiCapture::isCapturing())
+                return ApiCapture::invoke(getName<func>(), get<func>(), std::forward<Args>(args)...);
 #endif
             return get<func>()(std::forward<Args>(args)...);
         }
@@ -123,5 +134,21 @@ namespace Graphics {
         static constexpr const char* getName() {
             return FunctionTraits<func>::name;
         }
+
+        static constexpr std::array<const char*, static_cast<size_t>(FunctionEnum::Num)> getNames() {
+            return []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<const char*, sizeof...(Is)>{ FunctionTraits<static_cast<FunctionEnum>(Is)>::name... };
+            }(std::make_index_sequence<static_cast<size_t>(FunctionEnum::Num)>{});
+        }
+
+        // calls of every table with this function enum on all threads, sorted by total time,
+        // empty unless GRAPHICS_ENABLE_CALL_STATISTICS is defined
+        static std::vector<FunctionCallEntry> getCallReport() {
+            return FunctionCallStatistics<FunctionEnum>::getReport(getNames());
+        }
+
+        static void resetCallStatistics() {
+            FunctionCallStatistics<FunctionEnum>::reset();
+        }
     };
 }
\ No newline at end of file
@@ -14,9 +14,11 @@
 #include "HandleTypes/PhysicalDevice.h"
 #include "HandleTypes/PhysicalDeviceCache.h"
 #include "HandleTypes/Pipeline.h"
+#include "HandleTypes/PipelineCache.h"
 #include "HandleTypes/Queue.h"
 #include "HandleTypes/RenderPass.h"
 #include "HandleTypes/Sampler.h"
+#include "HandleTypes/QueryPool.h"
 #include "HandleTypes/Semaphore.h"
 #include "HandleTypes/ShaderModule.h"
 #include "HandleTypes/Surface.h"
@@ -24,6 +26,35 @@
 
 #include "MemoryManagement/MemoryPool.h"
 
+#include "FrameManagement/FrameCommandAllocator.h"
+#include "FrameManagement/FrameScheduler.h"
+#include "FrameManagement/FrameContextManager.h"
+#include "FrameManagement/DeletionQueue.h"
+#include "FrameManagement/SwapChainRecreator.h"
+#include "FrameManagement/FramePacer.h"
+
+#include "Synchronization/ResourceStateTracker.h"
+#include "Synchronization/BarrierBatch.h"
+
+#include "Submission/SubmissionThread.h"
+
+#include "Profiling/GpuProfiler.h"
+#include "Profiling/PipelineStatisticsProfiler.h"
+#include "Profiling/CpuProfiler.h"
+
+#include "Recording/StateCachingRecorder.h"
+#include "Recording/RenderQueue.h"
+#include "Recording/InstanceBatcher.h"
+#include "Recording/IndirectDrawScene.h"
+
+#include "Culling/FrustumCuller.h"
+#include "Culling/HiZOcclusionCuller.h"
+
+#include "RenderGraph/RenderGraph.h"
+
+#include "Headless/OffscreenSwapChain.h"
+#include "Headless/FrameBenchmark.h"
+
 #include "PlatformManagement/IOEvents.h"
 #include "PlatformManagement/Window.h"
 #include "PlatformManagement/WindowEvents.h"
@@ -31,6 +62,7 @@
 #include "Utility/Utility.h"
 #include "Utility/PixelData2D.h"
 #include "Utility/BufferDataBuilders.h"
+#include "Utility/MpscQueue.h"
 
 #include "Wrappers/InstanceWrapper.h"
 #include "Wrappers/DeviceWrapper.h"
@@ -64,6 +64,9 @@ namespace Graphics
         using Base = StructBase<VkBufferMemoryBarrier, BufferMemoryBarrier>;
     public:
         using Base::Base;
+
+        static inline const auto s_queueFamilyIgnored = VK_QUEUE_FAMILY_IGNORED;
+
         BufferMemoryBarrier(const BufferRef& buffer, Flags::Access srcAccessMask, Flags::Access dstAccessMask,
             uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex,
             DeviceSize offset, DeviceSize size) : Base()
@@ -106,6 +109,66 @@ namespace Graphics
         }
     };
 
+    class BufferMemoryBarrier2 : public StructBase<VkBufferMemoryBarrier2, BufferMemoryBarrier2>
+    {
+        using Base = StructBase<VkBufferMemoryBarrier2, BufferMemoryBarrier2>;
+    public:
+        using Base::Base;
+
+        static inline const auto s_queueFamilyIgnored = VK_QUEUE_FAMILY_IGNORED;
+
+        BufferMemoryBarrier2(const BufferRef& buffer,
+            Flags::PipelineStage2 srcStageMask, Flags::Access2 srcAccessMask,
+            Flags::PipelineStage2 dstStageMask, Flags::Access2 dstAccessMask,
+            DeviceSize offset = 0, DeviceSize size = VK_WHOLE_SIZE,
+            uint32_t srcQueueFamilyIndex = s_queueFamilyIgnored,
+            uint32_t dstQueueFamilyIndex = s_queueFamilyIgnored) : Base()
+        {
+            this->srcStageMask = srcStageMask;
+            this->srcAccessMask = srcAccessMask;
+            this->dstStageMask = dstStageMask;
+            this->dstAccessMask = dstAccessMask;
+            this->srcQueueFamilyIndex = srcQueueFamilyIndex;
+            this->dstQueueFamilyIndex = dstQueueFamilyIndex;
+            this->buffer = buffer;
+            this->offset = offset;
+            this->size = size;
+        }
+        BufferMemoryBarrier2& setSrcStageMask(Flags::PipelineStage2 srcStageMask) {
+            this->srcStageMask = srcStageMask;
+            return *this;
+        }
+        BufferMemoryBarrier2& setSrcAccessMask(Flags::Access2 srcAccessMask) {
+            this->srcAccessMask = srcAccessMask;
+            return *this;
+        }
+        BufferMemoryBarrier2& setDstStageMask(Flags::PipelineStage2 dstStageMask) {
+            this->dstStageMask = dstStageMask;
+            return *this;
+        }
+        BufferMemoryBarrier2& setDstAccessMask(Flags::Access2 dstAccessMask) {
+            this->dstAccessMask = dstAccessMask;
+            return *this;
+        }
+        BufferMemoryBarrier2& setQueueFamilyIndices(uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex) {
+            this->srcQueueFamilyIndex = srcQueueFamilyIndex;
+            this->dstQueueFamilyIndex = dstQueueFamilyIndex;
+            return *this;
+        }
+        BufferMemoryBarrier2& setBuffer(const BufferRef& buffer) {
+            this->buffer = buffer;
+            return *this;
+        }
+        BufferMemoryBarrier2& setOffset(DeviceSize offset) {
+            this->offset = offset;
+            return *this;
+        }
+        BufferMemoryBarrier2& setSize(DeviceSize size) {
+            this->size = size;
+            return *this;
+        }
+    };
+
     class BufferImageCopy : public StructBase<VkBufferImageCopy, BufferImageCopy>
     {
         using Base = StructBase<VkBufferImageCopy, BufferImageCopy>;
@@ -9,6 +9,7 @@
 #include "Buffer.h"
 #include "Memory.h"
 #include "Image.h"
+#include "QueryPool.h"
 
 namespace Graphics
 {
@@ -99,6 +100,52 @@ namespace Graphics
         }
     };
 
+    class DependencyInfo : public StructBase<VkDependencyInfo, DependencyInfo>
+    {
+        using Base = StructBase<VkDependencyInfo, DependencyInfo>;
+    public:
+        using Base::Base;
+
+        // the barriers are referenced, not copied, and have to outlive the DependencyInfo
+        DependencyInfo(std::span<const MemoryBarrier2> memoryBarriers,
+            std::span<const BufferMemoryBarrier2> bufferMemoryBarriers,
+            std::span<const ImageMemoryBarrier2> imageMemoryBarriers,
+            Flags::Dependency dependencyFlags = Flags::Dependency::Bits::None) : Base()
+        {
+            this->dependencyFlags = dependencyFlags;
+            setMemoryBarriers(memoryBarriers);
+            setBufferMemoryBarriers(bufferMemoryBarriers);
+            setImageMemoryBarriers(imageMemoryBarriers);
+        }
+
+        DependencyInfo& setDependencyFlags(Flags::Dependency dependencyFlags)
+        {
+            this->dependencyFlags = dependencyFlags;
+            return *this;
+        }
+
+        DependencyInfo& setMemoryBarriers(std::span<const MemoryBarrier2> memoryBarriers)
+        {
+            this->memoryBarrierCount = static_cast<uint32_t>(memoryBarriers.size());
+            this->pMemoryBarriers = MemoryBarrier2::underlyingCast(memoryBarriers.data());
+            return *this;
+        }
+
+        DependencyInfo& setBufferMemoryBarriers(std::span<const BufferMemoryBarrier2> bufferMemoryBarriers)
+        {
+            this->bufferMemoryBarrierCount = static_cast<uint32_t>(bufferMemoryBarriers.size());
+            this->pBufferMemoryBarriers = BufferMemoryBarrier2::underlyingCast(bufferMemoryBarriers.data());
+            return *this;
+        }
+
+        DependencyInfo& setImageMemoryBarriers(std::span<const ImageMemoryBarrier2> imageMemoryBarriers)
+        {
+            this->imageMemoryBarrierCount = static_cast<uint32_t>(imageMemoryBarriers.size());
+            this->pImageMemoryBarriers = ImageMemoryBarrier2::underlyingCast(imageMemoryBarriers.data());
+            return *this;
+        }
+    };
+
 	class CommandPool;
     class CommandPoolRef;
 
@@ -122,6 +169,9 @@ namespace Graphics
         void beginRenderPass(const DeviceFunctionTable& functions, const RenderPassBeginInfo& beginInfo,
             SubpassContents subpassContents = SubpassContents::Inline);
 
+        // needs vkCmdBeginRenderingKHR to be loaded
+        void beginRendering(const DeviceFunctionTable& functions, const RenderingInfo& renderingInfo);
+
         void bindPipeline(const DeviceFunctionTable& functions,
             const PipelineRef& pipeline, PipelineBindPoint bindPoint);
 
@@ -199,7 +249,21 @@ namespace Graphics
         void drawIndirect(const DeviceFunctionTable& functions, const BufferRef& buffer,
             DeviceSize offset, uint32_t drawCount, uint32_t stride);
 
+        void drawIndexedIndirect(const DeviceFunctionTable& functions, const BufferRef& buffer,
+            DeviceSize offset, uint32_t drawCount, uint32_t stride = sizeof(DrawIndexedCommand));
+
+        // needs VK_KHR_draw_indirect_count or Vulkan 1.2
+        void drawIndirectCount(const DeviceFunctionTable& functions, const BufferRef& buffer,
+            DeviceSize offset, const BufferRef& countBuffer, DeviceSize countBufferOffset,
+            uint32_t maxDrawCount, uint32_t stride = sizeof(DrawCommand));
+
+        // needs VK_KHR_draw_indirect_count or Vulkan 1.2
+        void drawIndexedIndirectCount(const DeviceFunctionTable& functions, const BufferRef& buffer,
+            DeviceSize offset, const BufferRef& countBuffer, DeviceSize countBufferOffset,
+            uint32_t maxDrawCount, uint32_t stride = sizeof(DrawIndexedCommand));
+
         void endRenderPass(const DeviceFunctionTable& functions);
+        void endRendering(const DeviceFunctionTable& functions);
         Result stopRecord(const DeviceFunctionTable& functions);
         Result reset(const DeviceFunctionTable& functions,
             Flags::CommandBufferReset flags = Flags::CommandBufferReset::Bits::None);
@@ -207,6 +271,11 @@ namespace Graphics
         void dispatch(const DeviceFunctionTable& functions,
             uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
 
+        void dispatchIndirect(const DeviceFunctionTable& functions, const BufferRef& buffer, DeviceSize offset);
+
+        void fillBuffer(const DeviceFunctionTable& functions, const BufferRef& dstBuffer,
+            DeviceSize dstOffset, DeviceSize size, uint32_t data);
+
         Result begin(const DeviceFunctionTable& functions, const CommandBufferBeginInfo& beginInfo);
         Result end(const DeviceFunctionTable& functions);
 
@@ -216,6 +285,20 @@ namespace Graphics
             std::span<const BufferMemoryBarrier> bufferMemoryBarriers,
             std::span<const ImageMemoryBarrier> imageMemoryBarriers);
 
+        // synchronization2 barrier with stage masks per barrier, needs vkCmdPipelineBarrier2KHR to be loaded
+        void pipelineBarrier2(const DeviceFunctionTable& functions, const DependencyInfo& dependencyInfo);
+
+        // a query of one type and pool may only be active once at a time, begin and end have to be in the same subpass
+        void beginQuery(const DeviceFunctionTable& functions, const QueryPoolRef& queryPool, uint32_t query,
+            Flags::QueryControl flags = Flags::QueryControl::Bits::None);
+        void endQuery(const DeviceFunctionTable& functions, const QueryPoolRef& queryPool, uint32_t query);
+        // queries have to be reset before they are written again, outside of a render pass
+        void resetQueryPool(const DeviceFunctionTable& functions, const QueryPoolRef& queryPool,
+            uint32_t firstQuery, uint32_t queryCount);
+        // the timestamp is written once all previous commands completed the given stage
+        void writeTimestamp(const DeviceFunctionTable& functions, Flags::PipelineStage::Bits stage,
+            const QueryPoolRef& queryPool, uint32_t query);
+
 	};
 }
 
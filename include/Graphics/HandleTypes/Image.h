@@ -304,6 +304,84 @@ namespace Graphics
         }
     };
 
+    class ImageMemoryBarrier2 : public StructBase<VkImageMemoryBarrier2, ImageMemoryBarrier2> {
+        using Base = StructBase<VkImageMemoryBarrier2, ImageMemoryBarrier2>;
+    public:
+        using Base::Base;
+
+        static inline const auto s_queueFamilyIgnored = VK_QUEUE_FAMILY_IGNORED;
+
+        ImageMemoryBarrier2(const ImageRef& image,
+            Flags::PipelineStage2 srcStageMask, Flags::Access2 srcAccessMask,
+            Flags::PipelineStage2 dstStageMask, Flags::Access2 dstAccessMask,
+            ImageLayout oldLayout = ImageLayout::Undefined,
+            ImageLayout newLayout = ImageLayout::Undefined,
+            const ImageSubresourceRange& subresourceRange = ImageSubresourceRange(),
+            uint32_t srcQueueFamilyIndex = s_queueFamilyIgnored,
+            uint32_t dstQueueFamilyIndex = s_queueFamilyIgnored) : Base() {
+            this->srcStageMask = srcStageMask;
+            this->srcAccessMask = srcAccessMask;
+            this->dstStageMask = dstStageMask;
+            this->dstAccessMask = dstAccessMask;
+            this->oldLayout = convertCEnum(oldLayout);
+            this->newLayout = convertCEnum(newLayout);
+            this->srcQueueFamilyIndex = srcQueueFamilyIndex;
+            this->dstQueueFamilyIndex = dstQueueFamilyIndex;
+            this->image = image;
+            this->subresourceRange = subresourceRange.getStruct();
+        }
+
+        ImageMemoryBarrier2& setSrcStageMask(Flags::PipelineStage2 srcStageMask) {
+            this->srcStageMask = srcStageMask;
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setSrcAccessMask(Flags::Access2 srcAccessMask) {
+            this->srcAccessMask = srcAccessMask;
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setDstStageMask(Flags::PipelineStage2 dstStageMask) {
+            this->dstStageMask = dstStageMask;
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setDstAccessMask(Flags::Access2 dstAccessMask) {
+            this->dstAccessMask = dstAccessMask;
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setOldLayout(ImageLayout oldLayout) {
+            this->oldLayout = convertCEnum(oldLayout);
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setNewLayout(ImageLayout newLayout) {
+            this->newLayout = convertCEnum(newLayout);
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setQueueFamilyIndices(uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex) {
+            this->srcQueueFamilyIndex = srcQueueFamilyIndex;
+            this->dstQueueFamilyIndex = dstQueueFamilyIndex;
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setImage(const ImageRef& image) {
+            this->image = image;
+            return *this;
+        }
+
+        ImageMemoryBarrier2& setSubresourceRange(const ImageSubresourceRange& subresourceRange) {
+            this->subresourceRange = subresourceRange;
+            return *this;
+        }
+
+        ImageSubresourceRange& getSubresourceRange() {
+            return *reinterpret_cast<ImageSubresourceRange*>(&this->subresourceRange);
+        }
+    };
+
     class ImageSubresourceLayers : public StructBase<VkImageSubresourceLayers, ImageSubresourceLayers> {
         using Base = StructBase<VkImageSubresourceLayers, ImageSubresourceLayers>;
     public:
@@ -119,6 +119,36 @@ namespace Graphics
         }
     };
 
+    class MemoryBarrier2 : public StructBase<VkMemoryBarrier2, MemoryBarrier2>
+    {
+        using Base = StructBase<VkMemoryBarrier2, MemoryBarrier2>;
+    public:
+        using Base::Base;
+        MemoryBarrier2(Flags::PipelineStage2 srcStageMask, Flags::Access2 srcAccessMask,
+            Flags::PipelineStage2 dstStageMask, Flags::Access2 dstAccessMask) : Base() {
+            this->srcStageMask = srcStageMask;
+            this->srcAccessMask = srcAccessMask;
+            this->dstStageMask = dstStageMask;
+            this->dstAccessMask = dstAccessMask;
+        }
+        MemoryBarrier2& setSrcStageMask(Flags::PipelineStage2 srcStageMask) {
+            this->srcStageMask = srcStageMask;
+            return *this;
+        }
+        MemoryBarrier2& setSrcAccessMask(Flags::Access2 srcAccessMask) {
+            this->srcAccessMask = srcAccessMask;
+            return *this;
+        }
+        MemoryBarrier2& setDstStageMask(Flags::PipelineStage2 dstStageMask) {
+            this->dstStageMask = dstStageMask;
+            return *this;
+        }
+        MemoryBarrier2& setDstAccessMask(Flags::Access2 dstAccessMask) {
+            this->dstAccessMask = dstAccessMask;
+            return *this;
+        }
+    };
+
     class MemoryMapping {
         friend class Memory;
     private:
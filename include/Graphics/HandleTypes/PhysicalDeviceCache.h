@@ -5,6 +5,7 @@
 #include "Instance.h"
 #include "PhysicalDevice.h"
 #include "Queue.h"
+#include "PipelineCache.h"
 #include "../TaskTables/QueuePropertyEnum.h"
 #include "../TaskTables/PropertyEnum.h"
 #include "../TaskTables/FeatureEnum.h"
@@ -78,6 +79,12 @@ namespace Graphics
 		SearchResult getFittingDevice(
 			const DeviceRequirements& requirements) const;
 
+		// cached data of an enumerated device, nullptr for a device the cache does not know
+		const Data* getData(const PhysicalDevice& device) const;
+
+		// what a pipeline cache file has to match to be used on device
+		PipelineCacheIdentity getPipelineCacheIdentity(const PhysicalDevice& device) const;
+
 		void checkDeviceSuitability(SearchResult& result,
 			const InstanceFunctionTable& functions, const Surface& surface, 
 			const std::pair<PhysicalDevice, PhysicalDeviceCache::Data>& data,
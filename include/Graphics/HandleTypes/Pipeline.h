@@ -6,6 +6,7 @@
 #include "RenderPass.h"
 #include "ShaderModule.h"
 #include "DescriptorSet.h"
+#include "PipelineCache.h"
 
 namespace Graphics
 {
@@ -669,6 +670,40 @@ namespace Graphics
 		}
 	};
 
+	// attachment formats of a pipeline used with dynamic rendering, replaces the render pass and subpass
+	class PipelineRenderingCreateInfo : public StructBase<VkPipelineRenderingCreateInfo, PipelineRenderingCreateInfo>
+	{
+		using Base = StructBase<VkPipelineRenderingCreateInfo, PipelineRenderingCreateInfo>;
+	public:
+		using Base::Base;
+
+		PipelineRenderingCreateInfo(std::span<const PixelFormat> colorAttachmentFormats,
+			PixelFormat depthAttachmentFormat = PixelFormat::Undefined,
+			PixelFormat stencilAttachmentFormat = PixelFormat::Undefined, uint32_t viewMask = 0) : Base() {
+			setColorAttachmentFormats(colorAttachmentFormats);
+			this->depthAttachmentFormat = convertCEnum(depthAttachmentFormat);
+			this->stencilAttachmentFormat = convertCEnum(stencilAttachmentFormat);
+			this->viewMask = viewMask;
+		}
+		PipelineRenderingCreateInfo& setColorAttachmentFormats(std::span<const PixelFormat> colorAttachmentFormats) {
+			this->colorAttachmentCount = static_cast<uint32_t>(colorAttachmentFormats.size());
+			this->pColorAttachmentFormats = reinterpret_cast<const VkFormat*>(colorAttachmentFormats.data());
+			return *this;
+		}
+		PipelineRenderingCreateInfo& setDepthAttachmentFormat(PixelFormat depthAttachmentFormat) {
+			this->depthAttachmentFormat = convertCEnum(depthAttachmentFormat);
+			return *this;
+		}
+		PipelineRenderingCreateInfo& setStencilAttachmentFormat(PixelFormat stencilAttachmentFormat) {
+			this->stencilAttachmentFormat = convertCEnum(stencilAttachmentFormat);
+			return *this;
+		}
+		PipelineRenderingCreateInfo& setViewMask(uint32_t viewMask) {
+			this->viewMask = viewMask;
+			return *this;
+		}
+	};
+
 	class PipelineCreateInfo : public StructBase<VkGraphicsPipelineCreateInfo, PipelineCreateInfo>
 	{
 		using Base = StructBase<VkGraphicsPipelineCreateInfo, PipelineCreateInfo>;
@@ -731,6 +766,13 @@ namespace Graphics
 			this->subpass = subpass;
 			return *this;
 		}
+		// dynamic rendering instead of a render pass, the formats are referenced and have to outlive the create info
+		constexpr PipelineCreateInfo& setRenderingInfo(const PipelineRenderingCreateInfo& renderingInfo) {
+			this->pNext = renderingInfo.getUnderlyingPointer();
+			this->renderPass = VK_NULL_HANDLE;
+			this->subpass = 0;
+			return *this;
+		}
 		constexpr PipelineCreateInfo& setBasePipelineHandle(const PipelineRef& basePipeline) {
 			this->basePipelineHandle = basePipeline.getHandle();
 			return *this;
@@ -748,10 +790,64 @@ namespace Graphics
 		using Base::Base;
 
 		void create(const DeviceFunctionTable& functions,
-			const DeviceRef& device, const PipelineCreateInfo& createInfo);
+			const DeviceRef& device, const PipelineCreateInfo& createInfo,
+			const PipelineCacheRef& cache = PipelineCacheRef());
 		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device);
 
 		static std::vector<Pipeline> create(const DeviceFunctionTable& functions,
-			const DeviceRef& device, std::span<const PipelineCreateInfo> createInfos);
+			const DeviceRef& device, std::span<const PipelineCreateInfo> createInfos,
+			const PipelineCacheRef& cache = PipelineCacheRef());
+	};
+
+	class ComputePipelineCreateInfo : public StructBase<VkComputePipelineCreateInfo, ComputePipelineCreateInfo>
+	{
+		using Base = StructBase<VkComputePipelineCreateInfo, ComputePipelineCreateInfo>;
+	public:
+		using Base::Base;
+
+		ComputePipelineCreateInfo(const PipelineShaderStageCreateInfo& stage, const PipelineLayoutRef& layout,
+			Flags::PipelineCreate flags = Flags::PipelineCreate::Bits::None) : Base() {
+			this->stage = stage.getStruct();
+			this->layout = layout.getHandle();
+			this->flags = flags;
+			this->basePipelineIndex = -1;
+		}
+		ComputePipelineCreateInfo& setFlags(Flags::PipelineCreate flags) {
+			this->flags = flags;
+			return *this;
+		}
+		ComputePipelineCreateInfo& setStage(const PipelineShaderStageCreateInfo& stage) {
+			this->stage = stage.getStruct();
+			return *this;
+		}
+		ComputePipelineCreateInfo& setLayout(const PipelineLayoutRef& layout) {
+			this->layout = layout.getHandle();
+			return *this;
+		}
+		ComputePipelineCreateInfo& setBasePipelineHandle(const PipelineRef& basePipeline) {
+			this->basePipelineHandle = basePipeline.getHandle();
+			return *this;
+		}
+		ComputePipelineCreateInfo& setBasePipelineIndex(int32_t basePipelineIndex) {
+			this->basePipelineIndex = basePipelineIndex;
+			return *this;
+		}
+	};
+
+	// shares PipelineRef with graphics pipelines, bound with PipelineBindPoint::Compute
+	class ComputePipeline : public VerificatorComponent<VkPipeline, PipelineRef>
+	{
+		using Base = VerificatorComponent<VkPipeline, PipelineRef>;
+	public:
+		using Base::Base;
+
+		void create(const DeviceFunctionTable& functions,
+			const DeviceRef& device, const ComputePipelineCreateInfo& createInfo,
+			const PipelineCacheRef& cache = PipelineCacheRef());
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device);
+
+		static std::vector<ComputePipeline> create(const DeviceFunctionTable& functions,
+			const DeviceRef& device, std::span<const ComputePipelineCreateInfo> createInfos,
+			const PipelineCacheRef& cache = PipelineCacheRef());
 	};
 }
@@ -0,0 +1,97 @@
+#pragma once
+#include "../Common.h"
+#include "../Structs.h"
+#include "../DeviceFunctionTable.h"
+#include "Device.h"
+
+#include <span>
+#include <array>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+namespace Graphics
+{
+	// the fields of a pipeline cache header that decide whether a device can use the data
+	struct PipelineCacheIdentity
+	{
+		uint32_t vendorId = 0;
+		uint32_t deviceId = 0;
+		std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUuid = {};
+
+		PipelineCacheIdentity() = default;
+		PipelineCacheIdentity(const VkPhysicalDeviceProperties& properties) :
+			vendorId(properties.vendorID), deviceId(properties.deviceID)
+		{
+			std::copy(std::begin(properties.pipelineCacheUUID), std::end(properties.pipelineCacheUUID),
+				pipelineCacheUuid.begin());
+		}
+
+		bool operator==(const PipelineCacheIdentity&) const = default;
+	};
+
+	class PipelineCacheRef : public BaseComponent<VkPipelineCache, PipelineCacheRef>
+	{
+		using Base = BaseComponent<VkPipelineCache, PipelineCacheRef>;
+	public:
+		using Base::Base;
+		static inline const std::string s_typeName = "PipelineCache";
+
+		std::vector<uint8_t> getData(const DeviceFunctionTable& functions, const DeviceRef& device) const;
+
+		// adds the pipelines of sources, e.g. caches filled by worker threads, the sources stay valid
+		void merge(const DeviceFunctionTable& functions, const DeviceRef& device,
+			std::span<const PipelineCacheRef> sources) const;
+
+		// writes the data to a uniquely named file next to path, syncs it to the disk and renames it over path,
+		// so neither a crash nor a concurrent save leaves a torn cache
+		bool saveToFile(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const std::filesystem::path& path) const;
+	};
+
+	class PipelineCacheCreateInfo : public StructBase<VkPipelineCacheCreateInfo, PipelineCacheCreateInfo>
+	{
+		using Base = StructBase<VkPipelineCacheCreateInfo, PipelineCacheCreateInfo>;
+	public:
+		using Base::Base;
+
+		// initialData has to outlive the create call
+		PipelineCacheCreateInfo(std::span<const uint8_t> initialData = {},
+			Flags::PipelineCacheCreate flags = Flags::PipelineCacheCreate::Bits::None) : Base()
+		{
+			this->flags = flags;
+			this->initialDataSize = initialData.size();
+			this->pInitialData = initialData.data();
+		}
+
+		PipelineCacheCreateInfo& setInitialData(std::span<const uint8_t> initialData) {
+			this->initialDataSize = initialData.size();
+			this->pInitialData = initialData.data();
+			return *this;
+		}
+
+		PipelineCacheCreateInfo& setFlags(Flags::PipelineCacheCreate flags) {
+			this->flags = flags;
+			return *this;
+		}
+	};
+
+	class PipelineCache : public VerificatorComponent<VkPipelineCache, PipelineCacheRef>
+	{
+		using Base = VerificatorComponent<VkPipelineCache, PipelineCacheRef>;
+	public:
+		using Base::Base;
+
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PipelineCacheCreateInfo& createInfo = PipelineCacheCreateInfo());
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device);
+
+		// creates the cache from the file at path when its header matches identity, otherwise empty.
+		// Returns whether the file was used, a missing, truncated or foreign file is not an error.
+		bool createFromFile(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const std::filesystem::path& path, const PipelineCacheIdentity& identity);
+
+		// checks the VkPipelineCacheHeaderVersionOne at the start of data
+		static bool isCompatible(std::span<const uint8_t> data, const PipelineCacheIdentity& identity);
+	};
+}
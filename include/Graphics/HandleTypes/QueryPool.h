@@ -0,0 +1,69 @@
+#pragma once
+#include "../Common.h"
+#include "../Structs.h"
+#include "../DeviceFunctionTable.h"
+#include "Device.h"
+
+#include <span>
+
+namespace Graphics
+{
+	class QueryPoolRef : public BaseComponent<VkQueryPool, QueryPoolRef>
+	{
+		using Base = BaseComponent<VkQueryPool, QueryPoolRef>;
+	public:
+		using Base::Base;
+		static inline const std::string s_typeName = "QueryPool";
+
+		// returns NotReady when a query is not available yet and Wait is not set, data is only valid on Success.
+		// stride is in bytes, with Result64 every query takes one uint64_t, plus one with WithAvailability
+		Result getResults(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t firstQuery,
+			uint32_t queryCount, std::span<uint64_t> data, DeviceSize stride = sizeof(uint64_t),
+			Flags::QueryResult flags = Flags::QueryResult::Bits::Result64) const;
+	};
+
+	class QueryPoolCreateInfo : public StructBase<VkQueryPoolCreateInfo, QueryPoolCreateInfo>
+	{
+		using Base = StructBase<VkQueryPoolCreateInfo, QueryPoolCreateInfo>;
+	public:
+		using Base::Base;
+
+		QueryPoolCreateInfo(QueryType queryType, uint32_t queryCount,
+			Flags::QueryPipelineStatistic pipelineStatistics = Flags::QueryPipelineStatistic::Bits::None)
+			: Base()
+		{
+			this->queryType = static_cast<VkQueryType>(queryType);
+			this->queryCount = queryCount;
+			this->pipelineStatistics = pipelineStatistics;
+		}
+
+		QueryPoolCreateInfo& setQueryType(QueryType queryType) {
+			this->queryType = static_cast<VkQueryType>(queryType);
+			return *this;
+		}
+
+		QueryPoolCreateInfo& setQueryCount(uint32_t queryCount) {
+			this->queryCount = queryCount;
+			return *this;
+		}
+
+		QueryPoolCreateInfo& setPipelineStatistics(Flags::QueryPipelineStatistic pipelineStatistics) {
+			this->pipelineStatistics = pipelineStatistics;
+			return *this;
+		}
+
+		QueryType getQueryType() const { return static_cast<QueryType>(this->queryType); };
+		uint32_t getQueryCount() const { return this->queryCount; };
+		Flags::QueryPipelineStatistic getPipelineStatistics() const { return this->pipelineStatistics; };
+	};
+
+	class QueryPool : public VerificatorComponent<VkQueryPool, QueryPoolRef>
+	{
+		using Base = VerificatorComponent<VkQueryPool, QueryPoolRef>;
+	public:
+		using Base::Base;
+
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device, const QueryPoolCreateInfo& createInfo);
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device);
+	};
+}
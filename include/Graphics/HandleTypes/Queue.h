@@ -9,6 +9,31 @@
 
 namespace Graphics
 {
+    // semaphore values of a QueueSubmitInfo, one per wait and signal semaphore, ignored for binary semaphores
+    class TimelineSemaphoreSubmitInfo : public StructBase<VkTimelineSemaphoreSubmitInfo, TimelineSemaphoreSubmitInfo>
+    {
+        using Base = StructBase<VkTimelineSemaphoreSubmitInfo, TimelineSemaphoreSubmitInfo>;
+    public:
+        using Base::Base;
+
+        TimelineSemaphoreSubmitInfo(std::span<const uint64_t> waitValues, std::span<const uint64_t> signalValues) : Base() {
+            setWaitValues(waitValues);
+            setSignalValues(signalValues);
+        }
+
+        TimelineSemaphoreSubmitInfo& setWaitValues(std::span<const uint64_t> waitValues) {
+            this->waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+            this->pWaitSemaphoreValues = waitValues.data();
+            return *this;
+        }
+
+        TimelineSemaphoreSubmitInfo& setSignalValues(std::span<const uint64_t> signalValues) {
+            this->signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+            this->pSignalSemaphoreValues = signalValues.data();
+            return *this;
+        }
+    };
+
     class QueueSubmitInfo : public StructBase<VkSubmitInfo, QueueSubmitInfo>
     {
         using Base = StructBase<VkSubmitInfo, QueueSubmitInfo>;
@@ -64,6 +89,115 @@ namespace Graphics
             this->pCommandBuffers = CommandBuffer::underlyingCast(&commandBuffers);
             return *this;
         }
+
+        // the values are referenced and have to outlive the submit info
+        QueueSubmitInfo& setTimelineValues(const TimelineSemaphoreSubmitInfo& timelineValues) {
+            GRAPHICS_VERIFY(timelineValues.waitSemaphoreValueCount == this->waitSemaphoreCount &&
+                timelineValues.signalSemaphoreValueCount == this->signalSemaphoreCount,
+                "Timeline values must match the wait and signal semaphores");
+            this->pNext = timelineValues.getUnderlyingPointer();
+            return *this;
+        }
+    };
+
+    class SemaphoreSubmitInfo : public StructBase<VkSemaphoreSubmitInfo, SemaphoreSubmitInfo>
+    {
+        using Base = StructBase<VkSemaphoreSubmitInfo, SemaphoreSubmitInfo>;
+    public:
+        using Base::Base;
+
+        // value is ignored for binary semaphores
+        SemaphoreSubmitInfo(const SemaphoreRef& semaphore, Flags::PipelineStage2 stageMask,
+            uint64_t value = 0, uint32_t deviceIndex = 0) : Base() {
+            this->semaphore = semaphore.getHandle();
+            this->stageMask = stageMask;
+            this->value = value;
+            this->deviceIndex = deviceIndex;
+        }
+
+        SemaphoreSubmitInfo& setSemaphore(const SemaphoreRef& semaphore) {
+            this->semaphore = semaphore.getHandle();
+            return *this;
+        }
+
+        SemaphoreSubmitInfo& setStageMask(Flags::PipelineStage2 stageMask) {
+            this->stageMask = stageMask;
+            return *this;
+        }
+
+        SemaphoreSubmitInfo& setValue(uint64_t value) {
+            this->value = value;
+            return *this;
+        }
+    };
+
+    class CommandBufferSubmitInfo : public StructBase<VkCommandBufferSubmitInfo, CommandBufferSubmitInfo>
+    {
+        using Base = StructBase<VkCommandBufferSubmitInfo, CommandBufferSubmitInfo>;
+    public:
+        using Base::Base;
+
+        CommandBufferSubmitInfo(const CommandBuffer& commandBuffer, uint32_t deviceMask = 0) : Base() {
+            this->commandBuffer = commandBuffer.getHandle();
+            this->deviceMask = deviceMask;
+        }
+
+        CommandBufferSubmitInfo& setCommandBuffer(const CommandBuffer& commandBuffer) {
+            this->commandBuffer = commandBuffer.getHandle();
+            return *this;
+        }
+    };
+
+    // synchronization2 submit, every wait and signal carries its own stage mask
+    class QueueSubmitInfo2 : public StructBase<VkSubmitInfo2, QueueSubmitInfo2>
+    {
+        using Base = StructBase<VkSubmitInfo2, QueueSubmitInfo2>;
+    public:
+        using Base::Base;
+
+        QueueSubmitInfo2(std::span<const CommandBufferSubmitInfo> commandBuffers,
+            std::span<const SemaphoreSubmitInfo> waitSemaphores = {},
+            std::span<const SemaphoreSubmitInfo> signalSemaphores = {}) : Base() {
+            setCommandBuffers(commandBuffers);
+            setWaitSemaphores(waitSemaphores);
+            setSignalSemaphores(signalSemaphores);
+        }
+
+        QueueSubmitInfo2& setCommandBuffers(std::span<const CommandBufferSubmitInfo> commandBuffers) {
+            this->commandBufferInfoCount = static_cast<uint32_t>(commandBuffers.size());
+            this->pCommandBufferInfos = CommandBufferSubmitInfo::underlyingCast(commandBuffers.data());
+            return *this;
+        }
+
+        QueueSubmitInfo2& setWaitSemaphores(std::span<const SemaphoreSubmitInfo> waitSemaphores) {
+            this->waitSemaphoreInfoCount = static_cast<uint32_t>(waitSemaphores.size());
+            this->pWaitSemaphoreInfos = SemaphoreSubmitInfo::underlyingCast(waitSemaphores.data());
+            return *this;
+        }
+
+        QueueSubmitInfo2& setSignalSemaphores(std::span<const SemaphoreSubmitInfo> signalSemaphores) {
+            this->signalSemaphoreInfoCount = static_cast<uint32_t>(signalSemaphores.size());
+            this->pSignalSemaphoreInfos = SemaphoreSubmitInfo::underlyingCast(signalSemaphores.data());
+            return *this;
+        }
+    };
+
+    // VK_KHR_present_id, one id per swap chain of the present, waited for with SwapChainRef::waitForPresent
+    class PresentIdInfo : public StructBase<VkPresentIdKHR, PresentIdInfo>
+    {
+        using Base = StructBase<VkPresentIdKHR, PresentIdInfo>;
+    public:
+        using Base::Base;
+
+        PresentIdInfo(std::span<const uint64_t> presentIds) : Base() {
+            setPresentIds(presentIds);
+        }
+
+        PresentIdInfo& setPresentIds(std::span<const uint64_t> presentIds) {
+            this->swapchainCount = static_cast<uint32_t>(presentIds.size());
+            this->pPresentIds = presentIds.data();
+            return *this;
+        }
     };
 
     class QueuePresentInfo : public StructBase<VkPresentInfoKHR, QueuePresentInfo>
@@ -107,6 +241,14 @@ namespace Graphics
             this->pImageIndices = imageIndices.data();
             return *this;
         }
+
+        // the ids are referenced and have to outlive the present info
+        QueuePresentInfo& setPresentIds(const PresentIdInfo& presentIds) {
+            GRAPHICS_VERIFY(presentIds.swapchainCount == this->swapchainCount,
+                "There has to be one present id per swap chain");
+            this->pNext = presentIds.getUnderlyingPointer();
+            return *this;
+        }
     };
 
     class Queue : public BaseComponent<VkQueue, Queue>
@@ -127,6 +269,15 @@ namespace Graphics
             const QueueSubmitInfo& submitInfo,
             const FenceRef& fence) const;
 
+        // needs vkQueueSubmit2KHR to be loaded
+        void submit2(const DeviceFunctionTable& functions,
+            std::span<const QueueSubmitInfo2> submitInfos,
+            const FenceRef& fence) const;
+
+        void submit2(const DeviceFunctionTable& functions,
+            const QueueSubmitInfo2& submitInfo,
+            const FenceRef& fence) const;
+
         Result present(const DeviceFunctionTable& functions,
             const QueuePresentInfo& presentInfo) const;
     };
@@ -4,6 +4,7 @@
 #include "../DeviceFunctionTable.h"
 #include "Fence.h"
 #include "Semaphore.h"
+#include "Image.h"
 
 namespace Graphics
 {
@@ -230,6 +231,99 @@ namespace Graphics
         RenderPassBeginInfo& setRenderArea(const Rect2D& renderArea);
     };
 
+    // VK_KHR_dynamic_rendering attachment, takes the place of an Attachment, its reference and the frame buffer entry
+    class RenderingAttachmentInfo : public StructBase<VkRenderingAttachmentInfo, RenderingAttachmentInfo>
+    {
+        using Base = StructBase<VkRenderingAttachmentInfo, RenderingAttachmentInfo>;
+    public:
+        using Base::Base;
+
+        RenderingAttachmentInfo(const ImageViewRef& imageView, ImageLayout imageLayout,
+            AttachmentLoadOp loadOp = AttachmentLoadOp::DontCare,
+            AttachmentStoreOp storeOp = AttachmentStoreOp::Store,
+            const ClearValue& clearValue = ClearValue()) : Base()
+        {
+            this->imageView = imageView.getHandle();
+            this->imageLayout = convertCEnum(imageLayout);
+            this->loadOp = convertCEnum(loadOp);
+            this->storeOp = convertCEnum(storeOp);
+            this->clearValue = clearValue;
+            this->resolveMode = VK_RESOLVE_MODE_NONE;
+        }
+        RenderingAttachmentInfo& setImageView(const ImageViewRef& imageView, ImageLayout imageLayout) {
+            this->imageView = imageView.getHandle();
+            this->imageLayout = convertCEnum(imageLayout);
+            return *this;
+        }
+        RenderingAttachmentInfo& setLoadOp(AttachmentLoadOp loadOp) {
+            this->loadOp = convertCEnum(loadOp);
+            return *this;
+        }
+        RenderingAttachmentInfo& setStoreOp(AttachmentStoreOp storeOp) {
+            this->storeOp = convertCEnum(storeOp);
+            return *this;
+        }
+        RenderingAttachmentInfo& setClearValue(const ClearValue& clearValue) {
+            this->clearValue = clearValue;
+            return *this;
+        }
+        // multisampled attachments are resolved into resolveImageView at the end of rendering
+        RenderingAttachmentInfo& setResolve(const ImageViewRef& resolveImageView, ImageLayout resolveImageLayout,
+            Flags::ResolveMode::Bits resolveMode = Flags::ResolveMode::Bits::Average) {
+            this->resolveImageView = resolveImageView.getHandle();
+            this->resolveImageLayout = convertCEnum(resolveImageLayout);
+            this->resolveMode = static_cast<VkResolveModeFlagBits>(resolveMode);
+            return *this;
+        }
+    };
+
+    // begins rendering straight into image views, no RenderPass or FrameBuffer objects are involved
+    class RenderingInfo : public StructBase<VkRenderingInfo, RenderingInfo>
+    {
+        using Base = StructBase<VkRenderingInfo, RenderingInfo>;
+    public:
+        using Base::Base;
+
+        RenderingInfo(const Rect2D& renderArea, std::span<const RenderingAttachmentInfo> colorAttachments,
+            uint32_t layerCount = 1, Flags::Rendering flags = Flags::Rendering::Bits::None) : Base()
+        {
+            this->renderArea = renderArea;
+            this->layerCount = layerCount;
+            this->flags = flags;
+            setColorAttachments(colorAttachments);
+        }
+        RenderingInfo& setRenderArea(const Rect2D& renderArea) {
+            this->renderArea = renderArea;
+            return *this;
+        }
+        RenderingInfo& setLayerCount(uint32_t layerCount) {
+            this->layerCount = layerCount;
+            return *this;
+        }
+        RenderingInfo& setViewMask(uint32_t viewMask) {
+            this->viewMask = viewMask;
+            return *this;
+        }
+        RenderingInfo& setFlags(Flags::Rendering flags) {
+            this->flags = flags;
+            return *this;
+        }
+        RenderingInfo& setColorAttachments(std::span<const RenderingAttachmentInfo> colorAttachments) {
+            this->colorAttachmentCount = colorAttachments.size();
+            this->pColorAttachments = RenderingAttachmentInfo::underlyingCast(colorAttachments.data());
+            return *this;
+        }
+        // the attachments are referenced and have to outlive the rendering info
+        RenderingInfo& setDepthAttachment(const RenderingAttachmentInfo& depthAttachment) {
+            this->pDepthAttachment = depthAttachment.getUnderlyingPointer();
+            return *this;
+        }
+        RenderingInfo& setStencilAttachment(const RenderingAttachmentInfo& stencilAttachment) {
+            this->pStencilAttachment = stencilAttachment.getUnderlyingPointer();
+            return *this;
+        }
+    };
+
     class RenderPassCreateInfo : public StructBase<VkRenderPassCreateInfo, RenderPassCreateInfo>
     {
         using Base = StructBase<VkRenderPassCreateInfo, RenderPassCreateInfo>;
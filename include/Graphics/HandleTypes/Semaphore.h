@@ -13,6 +13,32 @@ namespace Graphics
 	public:
 		using Base::Base;
 		static inline const std::string s_typeName = "Semaphore";
+
+		// timeline semaphores only
+		uint64_t getCounterValue(const DeviceFunctionTable& functions, const DeviceRef& device) const;
+		void signal(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t value) const;
+		// returns false when the timeout (in nanoseconds) ran out before the value was reached
+		bool wait(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t value,
+			uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+	};
+
+	class SemaphoreTypeCreateInfo : public StructBase<VkSemaphoreTypeCreateInfo, SemaphoreTypeCreateInfo>
+	{
+		using Base = StructBase<VkSemaphoreTypeCreateInfo, SemaphoreTypeCreateInfo>;
+	public:
+		using Base::Base;
+		SemaphoreTypeCreateInfo(SemaphoreType type = SemaphoreType::Timeline, uint64_t initialValue = 0) : Base() {
+			this->semaphoreType = convertCEnum(type);
+			this->initialValue = initialValue;
+		}
+		SemaphoreTypeCreateInfo& setSemaphoreType(SemaphoreType type) {
+			this->semaphoreType = convertCEnum(type);
+			return *this;
+		}
+		SemaphoreTypeCreateInfo& setInitialValue(uint64_t initialValue) {
+			this->initialValue = initialValue;
+			return *this;
+		}
 	};
 
 	class SemaphoreCreateInfo : public StructBase<VkSemaphoreCreateInfo, SemaphoreCreateInfo>
@@ -30,6 +56,44 @@ namespace Graphics
 		Flags::SemaphoreCreate getFlags() const {
 			return this->flags;
 		}
+		// the type info is referenced and has to outlive the create info
+		SemaphoreCreateInfo& setTypeInfo(const SemaphoreTypeCreateInfo& typeInfo) {
+			this->pNext = typeInfo.getUnderlyingPointer();
+			return *this;
+		}
+	};
+
+	class SemaphoreWaitInfo : public StructBase<VkSemaphoreWaitInfo, SemaphoreWaitInfo>
+	{
+		using Base = StructBase<VkSemaphoreWaitInfo, SemaphoreWaitInfo>;
+	public:
+		using Base::Base;
+		// without Any the wait returns once every semaphore reached its value
+		SemaphoreWaitInfo(std::span<const SemaphoreRef> semaphores, std::span<const uint64_t> values,
+			Flags::SemaphoreWait flags = Flags::SemaphoreWait::Bits::None) : Base() {
+			this->flags = flags;
+			this->semaphoreCount = static_cast<uint32_t>(semaphores.size());
+			this->pSemaphores = SemaphoreRef::underlyingCast(semaphores.data());
+			this->pValues = values.data();
+		}
+		SemaphoreWaitInfo& setFlags(Flags::SemaphoreWait flags) {
+			this->flags = flags;
+			return *this;
+		}
+		Flags::SemaphoreWait getFlags() const {
+			return this->flags;
+		}
+	};
+
+	class SemaphoreSignalInfo : public StructBase<VkSemaphoreSignalInfo, SemaphoreSignalInfo>
+	{
+		using Base = StructBase<VkSemaphoreSignalInfo, SemaphoreSignalInfo>;
+	public:
+		using Base::Base;
+		SemaphoreSignalInfo(const SemaphoreRef& semaphore, uint64_t value) : Base() {
+			this->semaphore = semaphore.getHandle();
+			this->value = value;
+		}
 	};
 
     class Semaphore : public VerificatorComponent<VkSemaphore, SemaphoreRef>
@@ -40,6 +104,15 @@ namespace Graphics
 
 		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
 			const SemaphoreCreateInfo& createInfo = SemaphoreCreateInfo()); // SemaphoreCreateInfo is currently useless, as there are no flags defined
+        void createTimeline(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t initialValue = 0);
         void destroy(const DeviceFunctionTable& functions, const DeviceRef& device);
+
+        using SemaphoreRef::wait;
+
+        // waits for every (or with waitAll unset any) semaphore to reach its value,
+        // returns false when the timeout ran out first
+        static bool wait(const DeviceFunctionTable& functions, const DeviceRef& device,
+            std::span<const SemaphoreRef> semaphores, std::span<const uint64_t> values,
+            uint64_t timeout = std::numeric_limits<uint64_t>::max(), bool waitAll = true);
     };
 }
@@ -71,6 +71,9 @@ namespace Graphics
         using Base::Base;
 
         void create(const InstanceFunctionTable& functions, const InstanceRef& instance, const Platform::Window& window);
+        // needs VK_EXT_headless_surface, swap chains of the surface are never displayed,
+        // e.g. to run the render loop on machines without a display
+        void createHeadless(const InstanceFunctionTable& functions, const InstanceRef& instance);
         void destroy(const InstanceFunctionTable& functions, const InstanceRef& instance);
     };
 }
@@ -22,6 +22,10 @@ namespace Graphics {
         static inline const std::string s_typeName = "SwapChain";
 
         std::vector<ImageRef> getImages(const DeviceFunctionTable& functions, const DeviceRef& device) const;
+
+        // needs VK_KHR_present_wait, returns Timeout when the present was not displayed within timeout nanoseconds
+        Result waitForPresent(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t presentId,
+            uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
     };
 
     class SwapChainCreateInfo : public StructBase<VkSwapchainCreateInfoKHR, SwapChainCreateInfo>
@@ -210,6 +214,11 @@ namespace Graphics {
         void recreate(const DeviceFunctionTable& functions, const DeviceRef& device,
             SwapChainCreateInfo& createInfo);
 
+		//like recreate, but the old swap chain is moved into retired instead of being destroyed,
+		//so it can stay alive until the frames presenting to it are done
+        void recreate(const DeviceFunctionTable& functions, const DeviceRef& device,
+            SwapChainCreateInfo& createInfo, SwapChain& retired);
+
         Result acquireNextImage(const DeviceFunctionTable& functions, const DeviceRef& device,
             const SemaphoreRef& semaphore, const FenceRef& fence, uint32_t& imageIndex,
             uint32_t timeout = std::numeric_limits<uint32_t>::max());        
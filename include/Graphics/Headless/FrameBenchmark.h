@@ -0,0 +1,115 @@
+#pragma once
+#include "Graphics/Common.h"
+
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+#include <cmath>
+
+namespace Graphics::Headless
+{
+	struct FrameBenchmarkResult
+	{
+		uint32_t frameCount = 0;
+		std::chrono::nanoseconds total{ 0 };
+		std::chrono::nanoseconds mean{ 0 };
+		std::chrono::nanoseconds min{ 0 };
+		std::chrono::nanoseconds max{ 0 };
+		std::chrono::nanoseconds p50{ 0 };
+		std::chrono::nanoseconds p90{ 0 };
+		std::chrono::nanoseconds p95{ 0 };
+		std::chrono::nanoseconds p99{ 0 };
+		// every measured frame in render order
+		std::vector<std::chrono::nanoseconds> frameTimes;
+
+		// one line per value in milliseconds, stable to diff between runs
+		void writeReport(std::ostream& stream) const
+		{
+			auto write = [&](const char* name, std::chrono::nanoseconds value) {
+				stream << name << ": " << std::chrono::duration<double, std::milli>(value).count() << " ms\n";
+			};
+			stream << "frames: " << frameCount << "\n";
+			write("total", total);
+			write("mean", mean);
+			write("min", min);
+			write("p50", p50);
+			write("p90", p90);
+			write("p95", p95);
+			write("p99", p99);
+			write("max", max);
+		}
+	};
+
+	// Renders a fixed number of frames through a callback and reports CPU frame time percentiles.
+	// The warm up frames are rendered but not measured, they absorb pipeline creation and first use costs.
+	// Together with OffscreenSwapChain or a headless surface the whole render loop runs without a display, e.g. on lavapipe.
+	class FrameBenchmark
+	{
+		uint32_t m_warmupFrames = 10;
+		uint32_t m_measuredFrames = 500;
+
+	public:
+		using FrameFunction = std::function<void(uint32_t frameIndex)>;
+
+		FrameBenchmark() = default;
+		FrameBenchmark(uint32_t measuredFrames, uint32_t warmupFrames = 10) :
+			m_warmupFrames(warmupFrames), m_measuredFrames(measuredFrames) {};
+
+		void setWarmupFrames(uint32_t warmupFrames) { m_warmupFrames = warmupFrames; };
+		void setMeasuredFrames(uint32_t measuredFrames) { m_measuredFrames = measuredFrames; };
+
+		// renderFrame has to do all of a frame's CPU work, including waiting for the frame in flight it reuses,
+		// so the measured time includes GPU back pressure like a real run does
+		FrameBenchmarkResult run(const FrameFunction& renderFrame) const
+		{
+			using Clock = std::chrono::steady_clock;
+
+			uint32_t frame = 0;
+			for (; frame < m_warmupFrames; ++frame)
+				renderFrame(frame);
+
+			std::vector<std::chrono::nanoseconds> frameTimes;
+			frameTimes.reserve(m_measuredFrames);
+			auto previous = Clock::now();
+			for (uint32_t i = 0; i < m_measuredFrames; ++i, ++frame)
+			{
+				renderFrame(frame);
+				auto now = Clock::now();
+				frameTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - previous));
+				previous = now;
+			}
+			return evaluate(std::move(frameTimes));
+		}
+
+		static FrameBenchmarkResult evaluate(std::vector<std::chrono::nanoseconds> frameTimes)
+		{
+			FrameBenchmarkResult result;
+			result.frameCount = static_cast<uint32_t>(frameTimes.size());
+			result.frameTimes = frameTimes;
+			if (frameTimes.empty())
+				return result;
+
+			std::sort(frameTimes.begin(), frameTimes.end());
+			result.total = std::accumulate(frameTimes.begin(), frameTimes.end(), std::chrono::nanoseconds(0));
+			result.mean = result.total / static_cast<int64_t>(frameTimes.size());
+			result.min = frameTimes.front();
+			result.max = frameTimes.back();
+			result.p50 = percentile(frameTimes, 0.50);
+			result.p90 = percentile(frameTimes, 0.90);
+			result.p95 = percentile(frameTimes, 0.95);
+			result.p99 = percentile(frameTimes, 0.99);
+			return result;
+		}
+
+		// nearest rank percentile of sorted values
+		static std::chrono::nanoseconds percentile(const std::vector<std::chrono::nanoseconds>& sorted, double fraction)
+		{
+			GRAPHICS_VERIFY(!sorted.empty(), "Percentile of an empty set");
+			size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+			return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+		}
+	};
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Flags.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/Image.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Semaphore.h"
+#include "Graphics/HandleTypes/Queue.h"
+#include "Graphics/Utility/Utility.h"
+
+#include <vector>
+#include <array>
+#include <span>
+
+namespace Graphics::Headless
+{
+	// Stands in for a SwapChain where no surface can be created, not even with VK_EXT_headless_surface.
+	// The images are plain device local images handed out round robin. Acquire and present keep the semaphore
+	// protocol of a real swap chain with empty submissions, so the render loop does not need a separate path.
+	class OffscreenSwapChain
+	{
+		std::vector<Image> m_images;
+		std::vector<Memory> m_memories;
+		std::vector<ImageView> m_views;
+		PixelFormat m_format = PixelFormat::Undefined;
+		Extent2D m_extent;
+		uint32_t m_nextImage = 0;
+
+	public:
+		OffscreenSwapChain() = default;
+
+		OffscreenSwapChain(const OffscreenSwapChain&) = delete;
+		OffscreenSwapChain& operator=(const OffscreenSwapChain&) = delete;
+
+		~OffscreenSwapChain() { GRAPHICS_VERIFY(m_images.empty(), "OffscreenSwapChain was not destroyed"); };
+
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, const Extent2D& extent,
+			PixelFormat format = PixelFormat::B8G8R8A8Srgb, uint32_t imageCount = 2,
+			Flags::ImageUsage usage = Flags::ImageUsage::Bits::ColorAttachment | Flags::ImageUsage::Bits::TransferSrc)
+		{
+			GRAPHICS_VERIFY(m_images.empty(), "Trying to create a valid OffscreenSwapChain");
+			GRAPHICS_VERIFY(imageCount > 0, "OffscreenSwapChain needs at least one image");
+
+			m_format = format;
+			m_extent = extent;
+			m_nextImage = 0;
+			m_images.resize(imageCount);
+			m_memories.resize(imageCount);
+			m_views.resize(imageCount);
+			for (uint32_t i = 0; i < imageCount; ++i)
+			{
+				m_images[i].create(functions, device, ImageCreateInfo(ImageType::Image2D, format, Extent3D(extent, 1),
+					1, 1, Flags::SampleCount::Bits::SC1, ImageTiling::Optimal, usage));
+				auto requirements = m_images[i].getMemoryRequirements(device, functions);
+				m_memories[i].create(functions, device, MemoryAllocateInfo(requirements.getSize(),
+					Utility::findMemoryTypeFirstFit(memoryProperties, requirements.getMemoryTypeBits(),
+						Flags::MemoryProperty::Bits::DeviceLocal)));
+				m_memories[i].bindImage(functions, device, m_images[i]);
+				m_views[i].create(device, functions, ImageViewCreateInfo(m_images[i], ImageViewType::T2D, format,
+					ComponentMapping(), ImageSubresourceRange(Flags::ImageAspect::Bits::Color, 0, 1)));
+			}
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			for (size_t i = 0; i < m_images.size(); ++i)
+			{
+				m_views[i].destroy(device, functions);
+				m_images[i].destroy(functions, device);
+				m_memories[i].destroy(functions, device);
+			}
+			m_views.clear();
+			m_images.clear();
+			m_memories.clear();
+		}
+
+		// hands out the next image and signals semaphore like vkAcquireNextImageKHR would
+		Result acquireNextImage(const DeviceFunctionTable& functions, const Queue& queue,
+			const SemaphoreRef& semaphore, uint32_t& imageIndex)
+		{
+			imageIndex = m_nextImage;
+			m_nextImage = (m_nextImage + 1) % static_cast<uint32_t>(m_images.size());
+
+			std::array<SemaphoreRef, 1> signalSemaphores = { semaphore };
+			queue.submit(functions, QueueSubmitInfo({}, {}, std::span<const SemaphoreRef>(), signalSemaphores), FenceRef());
+			return Result::Success;
+		}
+
+		// consumes the render finished semaphore like vkQueuePresentKHR would, nothing is displayed
+		Result present(const DeviceFunctionTable& functions, const Queue& queue, const SemaphoreRef& waitSemaphore)
+		{
+			std::array<SemaphoreRef, 1> waitSemaphores = { waitSemaphore };
+			std::array<Flags::PipelineStage, 1> waitStages = { Flags::PipelineStage::Bits::AllCommands };
+			queue.submit(functions, QueueSubmitInfo({}, waitStages, waitSemaphores, std::span<const SemaphoreRef>()), FenceRef());
+			return Result::Success;
+		}
+
+		std::vector<ImageRef> getImages() const { return { m_images.begin(), m_images.end() }; };
+		ImageRef getImage(uint32_t index) const { return m_images[index]; };
+		ImageViewRef getImageView(uint32_t index) const { return m_views[index]; };
+		uint32_t getImageCount() const { return static_cast<uint32_t>(m_images.size()); };
+		PixelFormat getFormat() const { return m_format; };
+		const Extent2D& getExtent() const { return m_extent; };
+	};
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Utility/MpscQueue.h"
+#include "GpuProfiler.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <atomic>
+#include <ostream>
+#include <iomanip>
+#include <utility>
+#include <source_location>
+
+// zones are only recorded with GRAPHICS_ENABLE_PROFILING, otherwise the macros expand to nothing
+#if defined(GRAPHICS_ENABLE_PROFILING)
+#define GRAPHICS_PROFILE_CONCAT_INNER(a, b) a##b
+#define GRAPHICS_PROFILE_CONCAT(a, b) GRAPHICS_PROFILE_CONCAT_INNER(a, b)
+// name has to outlive the profiler, e.g. a string literal
+#define GRAPHICS_PROFILE_SCOPE(name) \
+	Graphics::Profiling::CpuZone GRAPHICS_PROFILE_CONCAT(__GRAPHICS_PROFILE_ZONE__, __LINE__)(name)
+#define GRAPHICS_PROFILE_FUNCTION() GRAPHICS_PROFILE_SCOPE(std::source_location::current().function_name())
+#define GRAPHICS_PROFILE_THREAD(name) Graphics::Profiling::CpuProfiler::setThreadName(name)
+#else
+#define GRAPHICS_PROFILE_SCOPE(name)
+#define GRAPHICS_PROFILE_FUNCTION()
+#define GRAPHICS_PROFILE_THREAD(name)
+#endif
+
+namespace Graphics::Profiling
+{
+	struct TraceEvent
+	{
+		const char* name = nullptr;
+		// nanoseconds since CpuProfiler::getEpoch
+		int64_t start = 0;
+		int64_t duration = 0;
+		uint32_t threadId = 0;
+	};
+
+	// Collects CPU zones from any thread into Chrome trace_event JSON, viewable in chrome://tracing or Perfetto.
+	// Every thread appends to its own buffer without synchronization, full buffers are handed to the collecting
+	// thread through a lock free queue. Buffers of a thread that rarely fills one are handed over by flushThread
+	// or when the thread exits. collect, addGpuFrame and writeChromeTrace belong to one collecting thread.
+	class CpuProfiler
+	{
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr size_t s_bufferCapacity = 4096;
+		static constexpr uint32_t s_gpuThreadId = 0;
+
+		struct ThreadName {
+			uint32_t threadId;
+			std::string name;
+		};
+
+		struct GpuEvent {
+			std::string name;
+			int64_t start;
+			int64_t duration;
+		};
+
+		struct ThreadBuffer
+		{
+			uint32_t threadId = s_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+			std::vector<TraceEvent> events;
+
+			ThreadBuffer() { events.reserve(s_bufferCapacity); };
+			~ThreadBuffer() { flush(); };
+
+			void flush()
+			{
+				if (events.empty())
+					return;
+				s_flushed.push(std::move(events));
+				events = {};
+				events.reserve(s_bufferCapacity);
+			}
+		};
+
+		static inline const Clock::time_point s_epoch = Clock::now();
+		static inline std::atomic<bool> s_enabled = true;
+		static inline std::atomic<uint32_t> s_nextThreadId = s_gpuThreadId + 1;
+		static inline Utility::MpscQueue<std::vector<TraceEvent>> s_flushed;
+		static inline Utility::MpscQueue<ThreadName> s_threadNames;
+
+		// only touched by the collecting thread
+		static inline std::vector<std::vector<TraceEvent>> s_collected;
+		static inline std::vector<ThreadName> s_collectedNames;
+		static inline std::vector<GpuEvent> s_gpuEvents;
+
+		static ThreadBuffer& getThreadBuffer()
+		{
+			thread_local ThreadBuffer buffer;
+			return buffer;
+		}
+
+	public:
+		CpuProfiler() = delete;
+
+		static Clock::time_point getEpoch() { return s_epoch; };
+		static int64_t toTraceTime(Clock::time_point time)
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(time - s_epoch).count();
+		}
+
+		// zones started while disabled are not recorded, recording is enabled by default
+		static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); };
+		static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); };
+
+		static void record(const char* name, Clock::time_point start, Clock::time_point end)
+		{
+			auto& buffer = getThreadBuffer();
+			buffer.events.push_back({ name, toTraceTime(start),
+				std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), buffer.threadId });
+			if (buffer.events.size() >= s_bufferCapacity)
+				buffer.flush();
+		}
+
+		// hands the calling thread's zones to the collecting thread, e.g. once per frame
+		static void flushThread() { getThreadBuffer().flush(); };
+
+		// shown as the track name of the calling thread
+		static void setThreadName(std::string name)
+		{
+			s_threadNames.push({ getThreadBuffer().threadId, std::move(name) });
+		}
+
+		// takes over the GPU scopes GpuProfiler::beginFrame just resolved, they go on their own GPU track.
+		// The clocks are not calibrated, the frame is placed at the CPU time it was recorded at.
+		static void addGpuFrame(const GpuProfiler& profiler)
+		{
+			int64_t anchor = toTraceTime(profiler.getLastFrameCpuTime());
+			for (const auto& event : profiler.getLastFrameEvents())
+				s_gpuEvents.push_back({ profiler.getTimings()[event.nameIndex].name,
+					anchor + event.begin.count(), (event.end - event.begin).count() });
+		}
+
+		// moves everything flushed so far to the collecting thread
+		static void collect()
+		{
+			s_flushed.popAll(s_collected);
+			s_threadNames.popAll(s_collectedNames);
+		}
+
+		static void clear()
+		{
+			collect();
+			s_collected.clear();
+			s_gpuEvents.clear();
+		}
+
+		static size_t getCollectedCount()
+		{
+			size_t count = s_gpuEvents.size();
+			for (const auto& events : s_collected)
+				count += events.size();
+			return count;
+		}
+
+		// writes all collected zones as complete events, timestamps are microseconds with nanosecond fraction
+		static void writeChromeTrace(std::ostream& stream)
+		{
+			collect();
+
+			bool first = true;
+			auto separator = [&]() {
+				stream << (first ? "\n" : ",\n");
+				first = false;
+			};
+			auto writeTime = [&](int64_t nanoseconds) {
+				stream << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+			};
+			auto writeEvent = [&](std::string_view name, const char* category, int64_t start, int64_t duration,
+				uint32_t threadId) {
+				separator();
+				stream << "{\"name\":\"";
+				writeEscaped(stream, name);
+				stream << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":";
+				writeTime(start);
+				stream << ",\"dur\":";
+				writeTime(duration);
+				stream << ",\"pid\":0,\"tid\":" << threadId << "}";
+			};
+			auto writeThreadName = [&](uint32_t threadId, std::string_view name) {
+				separator();
+				stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadId << ",\"args\":{\"name\":\"";
+				writeEscaped(stream, name);
+				stream << "\"}}";
+			};
+
+			stream << "{\"traceEvents\":[";
+			writeThreadName(s_gpuThreadId, "GPU");
+			for (const auto& threadName : s_collectedNames)
+				writeThreadName(threadName.threadId, threadName.name);
+			for (const auto& events : s_collected)
+				for (const auto& event : events)
+					writeEvent(event.name, "cpu", event.start, event.duration, event.threadId);
+			for (const auto& event : s_gpuEvents)
+				writeEvent(event.name, "gpu", event.start, event.duration, s_gpuThreadId);
+			stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+		}
+
+	private:
+		static void writeEscaped(std::ostream& stream, std::string_view text)
+		{
+			for (char character : text)
+			{
+				switch (character)
+				{
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\t': stream << "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(character) >= 0x20)
+						stream << character;
+				}
+			}
+		}
+	};
+
+	// records the time between construction and destruction as one zone
+	class CpuZone
+	{
+		const char* m_name = nullptr;
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		explicit CpuZone(const char* name)
+		{
+			if (!CpuProfiler::isEnabled())
+				return;
+			m_name = name;
+			m_start = std::chrono::steady_clock::now();
+		}
+
+		CpuZone(const CpuZone&) = delete;
+		CpuZone& operator=(const CpuZone&) = delete;
+
+		~CpuZone()
+		{
+			if (m_name)
+				CpuProfiler::record(m_name, m_start, std::chrono::steady_clock::now());
+		}
+	};
+}
@@ -0,0 +1,265 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Flags.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/QueryPool.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <span>
+
+namespace Graphics::Profiling
+{
+	struct GpuScopeTiming
+	{
+		std::string name;
+		// nesting level of the first scope with the name in the last resolved frame
+		uint32_t depth = 0;
+		std::chrono::nanoseconds last{ 0 };
+		std::chrono::nanoseconds average{ 0 };
+		std::chrono::nanoseconds min{ 0 };
+		std::chrono::nanoseconds max{ 0 };
+		uint64_t sampleCount = 0;
+	};
+
+	// one scope of the last resolved frame, times are relative to the first timestamp of that frame
+	struct GpuScopeEvent
+	{
+		// index into GpuProfiler::getTimings
+		uint32_t nameIndex = 0;
+		uint32_t depth = 0;
+		std::chrono::nanoseconds begin{ 0 };
+		std::chrono::nanoseconds end{ 0 };
+	};
+
+	// Measures GPU time of named scopes with timestamp queries. Every frame slot owns a range of one query pool,
+	// the range is read back when the slot is reused, i.e. after the frame fence of that slot was waited for,
+	// so reading never stalls and results are framesInFlight frames old.
+	// Scopes may nest and repeat, all scopes with the same name in one frame are summed to one sample.
+	class GpuProfiler
+	{
+		struct RecordedScope {
+			uint32_t nameIndex;
+			uint32_t depth;
+		};
+
+		struct FrameSlot {
+			std::vector<RecordedScope> scopes;
+			std::chrono::steady_clock::time_point cpuTime;
+			bool recorded = false;
+		};
+
+		QueryPool m_queryPool;
+		std::vector<FrameSlot> m_frames;
+		uint32_t m_maxScopesPerFrame = 0;
+		uint32_t m_currentFrame = 0;
+		uint32_t m_depth = 0;
+		double m_timestampPeriod = 1.0;
+		uint64_t m_timestampMask = std::numeric_limits<uint64_t>::max();
+
+		std::unordered_map<std::string, uint32_t> m_nameIndices;
+		std::vector<GpuScopeTiming> m_timings;
+		std::vector<uint64_t> m_readback;
+		std::vector<std::chrono::nanoseconds> m_frameSums;
+		std::chrono::nanoseconds m_lastFrameTime{ 0 };
+		std::vector<GpuScopeEvent> m_lastFrameEvents;
+		std::chrono::steady_clock::time_point m_lastFrameCpuTime;
+		uint64_t m_droppedScopes = 0;
+
+	public:
+		// writes the begin timestamp on construction and the end timestamp on destruction
+		class Scope
+		{
+			GpuProfiler* m_profiler = nullptr;
+			const DeviceFunctionTable* m_functions = nullptr;
+			CommandBuffer* m_commandBuffer = nullptr;
+			uint32_t m_query = 0;
+
+		public:
+			Scope() = default;
+			Scope(GpuProfiler& profiler, const DeviceFunctionTable& functions, CommandBuffer& commandBuffer, uint32_t query) :
+				m_profiler(&profiler), m_functions(&functions), m_commandBuffer(&commandBuffer), m_query(query) {};
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+			Scope(Scope&& other) noexcept :
+				m_profiler(std::exchange(other.m_profiler, nullptr)), m_functions(other.m_functions),
+				m_commandBuffer(other.m_commandBuffer), m_query(other.m_query) {};
+			Scope& operator=(Scope&&) = delete;
+
+			~Scope() { end(); };
+
+			// ends the scope before the end of the C++ scope
+			void end()
+			{
+				if (!m_profiler)
+					return;
+				m_commandBuffer->writeTimestamp(*m_functions, Flags::PipelineStage::Bits::BottomOfPipe,
+					m_profiler->m_queryPool, m_query + 1);
+				--m_profiler->m_depth;
+				m_profiler = nullptr;
+			}
+		};
+
+		GpuProfiler() = default;
+
+		GpuProfiler(const GpuProfiler&) = delete;
+		GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+		~GpuProfiler() { GRAPHICS_VERIFY(!m_queryPool.isValid(), "GpuProfiler was not destroyed"); };
+
+		// timestampPeriod is the nanoseconds per tick from the device limits, timestampValidBits comes from the
+		// properties of the queue family the scopes are recorded on, zero means it does not support timestamps
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device, float timestampPeriod,
+			uint32_t framesInFlight, uint32_t maxScopesPerFrame = 64, uint32_t timestampValidBits = 64)
+		{
+			GRAPHICS_VERIFY(!m_queryPool.isValid(), "Trying to create a valid GpuProfiler");
+			GRAPHICS_VERIFY(framesInFlight > 0 && maxScopesPerFrame > 0, "GpuProfiler needs at least one frame and scope");
+			GRAPHICS_VERIFY(timestampValidBits > 0, "The queue family does not support timestamps");
+
+			m_queryPool.create(functions, device, QueryPoolCreateInfo(QueryType::Timestamp, framesInFlight * maxScopesPerFrame * 2));
+			m_frames.assign(framesInFlight, FrameSlot{});
+			m_maxScopesPerFrame = maxScopesPerFrame;
+			m_currentFrame = 0;
+			m_depth = 0;
+			m_timestampPeriod = timestampPeriod;
+			m_timestampMask = timestampValidBits >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << timestampValidBits) - 1;
+			m_readback.resize(size_t(maxScopesPerFrame) * 2);
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			m_queryPool.destroy(functions, device);
+			m_frames.clear();
+		}
+
+		// call at the start of the frame's first command buffer, outside of a render pass and after the
+		// previous submission of frameSlot completed. Resolves that submission and resets its queries.
+		void beginFrame(const DeviceFunctionTable& functions, const DeviceRef& device, CommandBuffer& commandBuffer,
+			uint32_t frameSlot)
+		{
+			GRAPHICS_VERIFY(frameSlot < m_frames.size(), "Frame slot out of range");
+			GRAPHICS_VERIFY(m_depth == 0, "A GPU scope of the previous frame was not ended");
+
+			m_lastFrameEvents.clear();
+			resolve(functions, device, frameSlot);
+
+			m_currentFrame = frameSlot;
+			m_frames[frameSlot].scopes.clear();
+			m_frames[frameSlot].cpuTime = std::chrono::steady_clock::now();
+			m_frames[frameSlot].recorded = true;
+			commandBuffer.resetQueryPool(functions, m_queryPool, getFirstQuery(frameSlot), m_maxScopesPerFrame * 2);
+		}
+
+		// scopes beyond maxScopesPerFrame are not measured and only counted as dropped
+		[[nodiscard]] Scope scope(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer, std::string_view name)
+		{
+			auto& frame = m_frames[m_currentFrame];
+			if (frame.scopes.size() >= m_maxScopesPerFrame)
+			{
+				++m_droppedScopes;
+				return Scope();
+			}
+
+			uint32_t query = getFirstQuery(m_currentFrame) + static_cast<uint32_t>(frame.scopes.size()) * 2;
+			frame.scopes.push_back({ getNameIndex(name), m_depth++ });
+			commandBuffer.writeTimestamp(functions, Flags::PipelineStage::Bits::TopOfPipe, m_queryPool, query);
+			return Scope(*this, functions, commandBuffer, query);
+		}
+
+		// one entry per scope name in the order the names were first used
+		const std::vector<GpuScopeTiming>& getTimings() const { return m_timings; };
+		// from the first begin to the last end timestamp of the last resolved frame
+		std::chrono::nanoseconds getLastFrameTime() const { return m_lastFrameTime; };
+		uint64_t getDroppedScopeCount() const { return m_droppedScopes; };
+		// scopes resolved by the last beginFrame, empty when it did not resolve a frame
+		const std::vector<GpuScopeEvent>& getLastFrameEvents() const { return m_lastFrameEvents; };
+		// CPU time beginFrame recorded the resolved frame at, GPU and CPU clocks are not calibrated
+		// so this is the closest CPU anchor for the events
+		std::chrono::steady_clock::time_point getLastFrameCpuTime() const { return m_lastFrameCpuTime; };
+
+		void resetStatistics()
+		{
+			for (auto& timing : m_timings)
+				timing = GpuScopeTiming{ std::move(timing.name) };
+			m_lastFrameTime = std::chrono::nanoseconds(0);
+			m_droppedScopes = 0;
+		}
+
+	private:
+		uint32_t getFirstQuery(uint32_t frameSlot) const { return frameSlot * m_maxScopesPerFrame * 2; };
+
+		uint32_t getNameIndex(std::string_view name)
+		{
+			auto [it, inserted] = m_nameIndices.try_emplace(std::string(name), static_cast<uint32_t>(m_timings.size()));
+			if (inserted)
+			{
+				m_timings.push_back(GpuScopeTiming{ it->first });
+				m_frameSums.push_back(std::chrono::nanoseconds(0));
+			}
+			return it->second;
+		}
+
+		std::chrono::nanoseconds toDuration(uint64_t begin, uint64_t end) const
+		{
+			uint64_t ticks = (end - begin) & m_timestampMask;
+			return std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(ticks) * m_timestampPeriod));
+		}
+
+		void resolve(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t frameSlot)
+		{
+			auto& frame = m_frames[frameSlot];
+			if (!frame.recorded || frame.scopes.empty())
+				return;
+
+			uint32_t queryCount = static_cast<uint32_t>(frame.scopes.size()) * 2;
+			// no wait flag, a frame that is not available is dropped instead of stalling the CPU
+			auto result = m_queryPool.getResults(functions, device, getFirstQuery(frameSlot), queryCount,
+				std::span<uint64_t>(m_readback.data(), queryCount));
+			if (result != Result::Success)
+				return;
+
+			std::fill(m_frameSums.begin(), m_frameSums.end(), std::chrono::nanoseconds(0));
+			std::vector<bool> seen(m_timings.size(), false);
+			uint64_t frameBegin = m_readback[0];
+			uint64_t frameTicks = 0;
+			for (size_t i = 0; i < frame.scopes.size(); ++i)
+			{
+				const auto& scope = frame.scopes[i];
+				uint64_t begin = m_readback[i * 2];
+				uint64_t end = m_readback[i * 2 + 1];
+				m_frameSums[scope.nameIndex] += toDuration(begin, end);
+				if (!seen[scope.nameIndex])
+					m_timings[scope.nameIndex].depth = scope.depth;
+				seen[scope.nameIndex] = true;
+				frameTicks = std::max(frameTicks, (end - frameBegin) & m_timestampMask);
+				m_lastFrameEvents.push_back({ scope.nameIndex, scope.depth,
+					toDuration(frameBegin, begin), toDuration(frameBegin, end) });
+			}
+			m_lastFrameTime = toDuration(0, frameTicks);
+			m_lastFrameCpuTime = frame.cpuTime;
+
+			for (size_t i = 0; i < m_timings.size(); ++i)
+			{
+				if (!seen[i])
+					continue;
+				auto& timing = m_timings[i];
+				auto sample = m_frameSums[i];
+				timing.last = sample;
+				timing.min = timing.sampleCount == 0 ? sample : std::min(timing.min, sample);
+				timing.max = timing.sampleCount == 0 ? sample : std::max(timing.max, sample);
+				// exponential moving average, smooths single frame spikes while following changes within a few frames
+				timing.average = timing.sampleCount == 0 ? sample : (timing.average * 15 + sample) / 16;
+				++timing.sampleCount;
+			}
+		}
+	};
+}
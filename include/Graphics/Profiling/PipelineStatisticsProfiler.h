@@ -0,0 +1,271 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Flags.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Device.h"
+#include "Graphics/HandleTypes/QueryPool.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <span>
+#include <utility>
+#include <algorithm>
+
+namespace Graphics::Profiling
+{
+	// counters of one draw group, summed over all of its scopes in a frame except pixelCount
+	struct PipelineStatistics
+	{
+		uint64_t inputAssemblyVertices = 0;
+		uint64_t inputAssemblyPrimitives = 0;
+		uint64_t vertexShaderInvocations = 0;
+		uint64_t clippingInvocations = 0;
+		uint64_t clippingPrimitives = 0;
+		uint64_t fragmentShaderInvocations = 0;
+		// covered render target pixels as given to the scope, the base of fragmentsPerPixel.
+		// Scopes of one group usually render to the same area, so combining keeps the largest area instead
+		// of summing it. A group drawn to several distinct targets in a frame should use one name per target
+		uint64_t pixelCount = 0;
+
+		// overdraw, 1 means every covered pixel was shaded once
+		double fragmentsPerPixel() const {
+			return pixelCount == 0 ? 0.0 : double(fragmentShaderInvocations) / double(pixelCount);
+		}
+
+		// input assembly reads one vertex per index, so this is the post transform cache miss rate,
+		// 1 means no vertex was reused. For triangle lists it is a third of the ACMR (invocations per
+		// triangle), ~0.17-0.23 is typical for well optimized meshes
+		double vertexInvocationsPerIndex() const {
+			return inputAssemblyVertices == 0 ? 0.0 : double(vertexShaderInvocations) / double(inputAssemblyVertices);
+		}
+
+		// share of primitives removed by clipping and culling before rasterization
+		double rejectedPrimitiveRatio() const {
+			return clippingInvocations == 0 ? 0.0 : 1.0 - double(clippingPrimitives) / double(clippingInvocations);
+		}
+
+		PipelineStatistics& operator+=(const PipelineStatistics& other)
+		{
+			inputAssemblyVertices += other.inputAssemblyVertices;
+			inputAssemblyPrimitives += other.inputAssemblyPrimitives;
+			vertexShaderInvocations += other.vertexShaderInvocations;
+			clippingInvocations += other.clippingInvocations;
+			clippingPrimitives += other.clippingPrimitives;
+			fragmentShaderInvocations += other.fragmentShaderInvocations;
+			pixelCount = std::max(pixelCount, other.pixelCount);
+			return *this;
+		}
+	};
+
+	struct DrawGroupStatistics
+	{
+		std::string name;
+		PipelineStatistics statistics;
+		// number of frames resolved for this group so far, 0 while no result arrived yet
+		uint64_t resolvedFrames = 0;
+	};
+
+	// Counts pipeline statistics of named draw groups with one pipeline statistics query per scope. Like GpuProfiler
+	// every frame slot owns a range of one query pool that is read back without waiting when the slot is reused.
+	// Needs the pipelineStatisticsQuery device feature. Queries of one pool can not be active at the same time,
+	// so unlike timestamp scopes these scopes must not nest.
+	class PipelineStatisticsProfiler
+	{
+		static constexpr uint32_t s_counterCount = 6;
+
+		struct RecordedScope {
+			uint32_t nameIndex;
+			uint64_t pixelCount;
+		};
+
+		struct FrameSlot {
+			std::vector<RecordedScope> scopes;
+			bool recorded = false;
+		};
+
+		QueryPool m_queryPool;
+		std::vector<FrameSlot> m_frames;
+		uint32_t m_maxScopesPerFrame = 0;
+		uint32_t m_currentFrame = 0;
+		bool m_scopeActive = false;
+
+		std::unordered_map<std::string, uint32_t> m_nameIndices;
+		std::vector<DrawGroupStatistics> m_groups;
+		std::vector<uint64_t> m_readback;
+		uint64_t m_droppedScopes = 0;
+
+	public:
+		// ends the query on destruction
+		class Scope
+		{
+			PipelineStatisticsProfiler* m_profiler = nullptr;
+			const DeviceFunctionTable* m_functions = nullptr;
+			CommandBuffer* m_commandBuffer = nullptr;
+			uint32_t m_query = 0;
+
+		public:
+			Scope() = default;
+			Scope(PipelineStatisticsProfiler& profiler, const DeviceFunctionTable& functions,
+				CommandBuffer& commandBuffer, uint32_t query) :
+				m_profiler(&profiler), m_functions(&functions), m_commandBuffer(&commandBuffer), m_query(query) {};
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+			Scope(Scope&& other) noexcept :
+				m_profiler(std::exchange(other.m_profiler, nullptr)), m_functions(other.m_functions),
+				m_commandBuffer(other.m_commandBuffer), m_query(other.m_query) {};
+			Scope& operator=(Scope&&) = delete;
+
+			~Scope() { end(); };
+
+			void end()
+			{
+				if (!m_profiler)
+					return;
+				m_commandBuffer->endQuery(*m_functions, m_profiler->m_queryPool, m_query);
+				m_profiler->m_scopeActive = false;
+				m_profiler = nullptr;
+			}
+		};
+
+		// the counters written per query, results come in bit order
+		static constexpr Flags::QueryPipelineStatistic s_statistics =
+			Flags::QueryPipelineStatistic::Bits::InputAssemblyVertices |
+			Flags::QueryPipelineStatistic::Bits::InputAssemblyPrimitives |
+			Flags::QueryPipelineStatistic::Bits::VertexShaderInvocations |
+			Flags::QueryPipelineStatistic::Bits::ClippingInvocations |
+			Flags::QueryPipelineStatistic::Bits::ClippingPrimitives |
+			Flags::QueryPipelineStatistic::Bits::FragmentShaderInvocations;
+
+		PipelineStatisticsProfiler() = default;
+
+		PipelineStatisticsProfiler(const PipelineStatisticsProfiler&) = delete;
+		PipelineStatisticsProfiler& operator=(const PipelineStatisticsProfiler&) = delete;
+
+		~PipelineStatisticsProfiler() { GRAPHICS_VERIFY(!m_queryPool.isValid(), "PipelineStatisticsProfiler was not destroyed"); };
+
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t framesInFlight,
+			uint32_t maxScopesPerFrame = 32)
+		{
+			GRAPHICS_VERIFY(!m_queryPool.isValid(), "Trying to create a valid PipelineStatisticsProfiler");
+			GRAPHICS_VERIFY(framesInFlight > 0 && maxScopesPerFrame > 0,
+				"PipelineStatisticsProfiler needs at least one frame and scope");
+
+			m_queryPool.create(functions, device, QueryPoolCreateInfo(QueryType::PipelineStatistics,
+				framesInFlight * maxScopesPerFrame, s_statistics));
+			m_frames.assign(framesInFlight, FrameSlot{});
+			m_maxScopesPerFrame = maxScopesPerFrame;
+			m_currentFrame = 0;
+			m_scopeActive = false;
+			m_readback.resize(size_t(maxScopesPerFrame) * s_counterCount);
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			m_queryPool.destroy(functions, device);
+			m_frames.clear();
+		}
+
+		// call at the start of the frame's first command buffer, outside of a render pass and after the
+		// previous submission of frameSlot completed. Resolves that submission and resets its queries.
+		void beginFrame(const DeviceFunctionTable& functions, const DeviceRef& device, CommandBuffer& commandBuffer,
+			uint32_t frameSlot)
+		{
+			GRAPHICS_VERIFY(frameSlot < m_frames.size(), "Frame slot out of range");
+			GRAPHICS_VERIFY(!m_scopeActive, "A statistics scope of the previous frame was not ended");
+
+			resolve(functions, device, frameSlot);
+
+			m_currentFrame = frameSlot;
+			m_frames[frameSlot].scopes.clear();
+			m_frames[frameSlot].recorded = true;
+			commandBuffer.resetQueryPool(functions, m_queryPool, getFirstQuery(frameSlot), m_maxScopesPerFrame);
+		}
+
+		// pixelCount is the area the group renders to, usually the render area, and only used for fragmentsPerPixel
+		[[nodiscard]] Scope scope(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer,
+			std::string_view name, uint64_t pixelCount = 0)
+		{
+			GRAPHICS_VERIFY(!m_scopeActive, "Pipeline statistics scopes can not nest");
+			auto& frame = m_frames[m_currentFrame];
+			if (frame.scopes.size() >= m_maxScopesPerFrame)
+			{
+				++m_droppedScopes;
+				return Scope();
+			}
+
+			uint32_t query = getFirstQuery(m_currentFrame) + static_cast<uint32_t>(frame.scopes.size());
+			frame.scopes.push_back({ getNameIndex(name), pixelCount });
+			m_scopeActive = true;
+			commandBuffer.beginQuery(functions, m_queryPool, query);
+			return Scope(*this, functions, commandBuffer, query);
+		}
+
+		// one entry per group name in the order the names were first used, holds the last resolved frame
+		const std::vector<DrawGroupStatistics>& getGroups() const { return m_groups; };
+		uint64_t getDroppedScopeCount() const { return m_droppedScopes; };
+
+		// last resolved statistics of all groups together, pixelCount is the largest area of any group
+		PipelineStatistics getTotal() const
+		{
+			PipelineStatistics total;
+			for (const auto& group : m_groups)
+				total += group.statistics;
+			return total;
+		}
+
+	private:
+		uint32_t getFirstQuery(uint32_t frameSlot) const { return frameSlot * m_maxScopesPerFrame; };
+
+		uint32_t getNameIndex(std::string_view name)
+		{
+			auto [it, inserted] = m_nameIndices.try_emplace(std::string(name), static_cast<uint32_t>(m_groups.size()));
+			if (inserted)
+				m_groups.push_back(DrawGroupStatistics{ it->first });
+			return it->second;
+		}
+
+		void resolve(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t frameSlot)
+		{
+			auto& frame = m_frames[frameSlot];
+			if (!frame.recorded || frame.scopes.empty())
+				return;
+
+			uint32_t queryCount = static_cast<uint32_t>(frame.scopes.size());
+			// no wait flag, a frame that is not available is dropped instead of stalling the CPU
+			auto result = m_queryPool.getResults(functions, device, getFirstQuery(frameSlot), queryCount,
+				std::span<uint64_t>(m_readback.data(), size_t(queryCount) * s_counterCount),
+				sizeof(uint64_t) * s_counterCount);
+			if (result != Result::Success)
+				return;
+
+			std::vector<PipelineStatistics> frameStatistics(m_groups.size());
+			std::vector<bool> seen(m_groups.size(), false);
+			for (size_t i = 0; i < frame.scopes.size(); ++i)
+			{
+				const uint64_t* counters = m_readback.data() + i * s_counterCount;
+				PipelineStatistics statistics;
+				statistics.inputAssemblyVertices = counters[0];
+				statistics.inputAssemblyPrimitives = counters[1];
+				statistics.vertexShaderInvocations = counters[2];
+				statistics.clippingInvocations = counters[3];
+				statistics.clippingPrimitives = counters[4];
+				statistics.fragmentShaderInvocations = counters[5];
+				statistics.pixelCount = frame.scopes[i].pixelCount;
+				frameStatistics[frame.scopes[i].nameIndex] += statistics;
+				seen[frame.scopes[i].nameIndex] = true;
+			}
+
+			for (size_t i = 0; i < m_groups.size(); ++i)
+			{
+				if (!seen[i])
+					continue;
+				m_groups[i].statistics = frameStatistics[i];
+				++m_groups[i].resolvedFrames;
+			}
+		}
+	};
+}
@@ -0,0 +1,250 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Pipeline.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+#include "Graphics/Utility/Utility.h"
+#include "StateCachingRecorder.h"
+
+#include <vector>
+
+namespace Graphics::Recording
+{
+	// Scene submission through multi-draw indirect. Every material owns a fixed range of
+	// DrawIndexedCommand slots in an indirect buffer, objects occupy one slot each and
+	// the whole material is drawn with a single drawIndexedIndirect(Count) call.
+	// The indirect buffer is kept per frame in flight and only slots that changed are rewritten.
+	class IndirectDrawScene
+	{
+	public:
+		using ObjectHandle = uint32_t;
+		static constexpr ObjectHandle s_invalidObject = std::numeric_limits<ObjectHandle>::max();
+
+		struct Material {
+			PipelineRef pipeline;
+			PipelineLayoutRef layout;
+			// left unset when the material has no descriptor set
+			DescriptorSet descriptorSet;
+			uint32_t setIndex = 0;
+
+			// all meshes of a material must live in these buffers, drawn through vertexOffset/firstIndex
+			BufferRef vertexBuffer;
+			DeviceSize vertexBufferOffset = 0;
+			BufferRef indexBuffer;
+			DeviceSize indexBufferOffset = 0;
+			IndexType indexType = IndexType::Uint32;
+		};
+
+	private:
+		struct MaterialData {
+			Material material;
+			std::vector<DrawIndexedCommand> commands;
+			// owning object of every used slot, needed to compact on removal
+			std::vector<ObjectHandle> slotObjects;
+		};
+
+		struct ObjectData {
+			uint32_t material;
+			uint32_t slot;
+		};
+
+		struct FrameData {
+			Buffer buffer;
+			Memory memory;
+			MemoryMapping mapping;
+			// global slot indices (material * capacity + slot) that still need to be written
+			std::vector<uint32_t> dirtySlots;
+		};
+
+		std::vector<MaterialData> m_materials;
+		std::vector<ObjectData> m_objects;
+		std::vector<ObjectHandle> m_freeObjects;
+		std::vector<FrameData> m_frames;
+
+		uint32_t m_maxMaterials = 0;
+		uint32_t m_maxDrawsPerMaterial = 0;
+		bool m_useDrawCount = false;
+
+	public:
+		IndirectDrawScene() = default;
+
+		IndirectDrawScene(const IndirectDrawScene&) = delete;
+		IndirectDrawScene& operator=(const IndirectDrawScene&) = delete;
+
+		~IndirectDrawScene() { GRAPHICS_VERIFY(m_frames.empty(), "IndirectDrawScene was not destroyed"); };
+
+		// drawIndexedIndirectCount is used when preferDrawCount is set and the function was loaded
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, uint32_t framesInFlight,
+			uint32_t maxMaterials, uint32_t maxDrawsPerMaterial, bool preferDrawCount = true)
+		{
+			GRAPHICS_VERIFY(m_frames.empty(), "Trying to create a valid IndirectDrawScene");
+			m_maxMaterials = maxMaterials;
+			m_maxDrawsPerMaterial = maxDrawsPerMaterial;
+			m_useDrawCount = preferDrawCount && functions.isLoaded<DeviceFunction::CmdDrawIndexedIndirectCountKHR>();
+
+			m_frames.resize(framesInFlight);
+			for (auto& frame : m_frames)
+			{
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, frame.buffer, frame.memory,
+					getCommandOffset(maxMaterials, 0), Flags::BufferUsage::Bits::IndirectBuffer,
+					Flags::MemoryProperty::Bits::HostVisibleCoherent);
+				frame.mapping = frame.memory.map(functions, device);
+			}
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			for (auto& frame : m_frames)
+			{
+				frame.memory.unmap(functions, device, frame.mapping);
+				frame.buffer.destroy(functions, device);
+				frame.memory.destroy(functions, device);
+			}
+			m_frames.clear();
+		}
+
+		uint32_t addMaterial(const Material& material)
+		{
+			if (m_materials.size() == m_maxMaterials)
+				throw std::runtime_error("Material count exceeds IndirectDrawScene capacity");
+			GRAPHICS_VERIFY(material.indexBuffer.isSet(), "Indirect scene materials must be indexed");
+
+			m_materials.push_back({ material, {}, {} });
+			m_materials.back().commands.reserve(m_maxDrawsPerMaterial);
+			m_materials.back().slotObjects.reserve(m_maxDrawsPerMaterial);
+			return static_cast<uint32_t>(m_materials.size() - 1);
+		}
+
+		ObjectHandle addObject(uint32_t material, const DrawIndexedCommand& command)
+		{
+			GRAPHICS_VERIFY(material < m_materials.size(), "Unknown material");
+			auto& data = m_materials[material];
+			if (data.commands.size() == m_maxDrawsPerMaterial)
+				throw std::runtime_error("Draw count exceeds IndirectDrawScene material capacity");
+
+			ObjectHandle handle;
+			if (!m_freeObjects.empty())
+			{
+				handle = m_freeObjects.back();
+				m_freeObjects.pop_back();
+			}
+			else
+			{
+				handle = static_cast<ObjectHandle>(m_objects.size());
+				m_objects.push_back({});
+			}
+
+			uint32_t slot = static_cast<uint32_t>(data.commands.size());
+			data.commands.push_back(command);
+			data.slotObjects.push_back(handle);
+			m_objects[handle] = { material, slot };
+			markDirty(material, slot);
+			return handle;
+		}
+
+		void updateObject(ObjectHandle handle, const DrawIndexedCommand& command)
+		{
+			const auto& object = getObject(handle);
+			m_materials[object.material].commands[object.slot] = command;
+			markDirty(object.material, object.slot);
+		}
+
+		// the last slot of the material is moved into the freed one to keep the range compact
+		void removeObject(ObjectHandle handle)
+		{
+			auto object = getObject(handle);
+			auto& data = m_materials[object.material];
+			uint32_t last = static_cast<uint32_t>(data.commands.size() - 1);
+
+			if (object.slot != last)
+			{
+				data.commands[object.slot] = data.commands[last];
+				data.slotObjects[object.slot] = data.slotObjects[last];
+				m_objects[data.slotObjects[object.slot]].slot = object.slot;
+				markDirty(object.material, object.slot);
+			}
+			data.commands.pop_back();
+			data.slotObjects.pop_back();
+
+			m_objects[handle] = { std::numeric_limits<uint32_t>::max(), 0 };
+			m_freeObjects.push_back(handle);
+		}
+
+		// uploads the slots changed since this frame's buffer was last written and
+		// draws every material with a single multi-draw indirect call
+		void record(const DeviceFunctionTable& functions, StateCachingRecorder& recorder, uint32_t frameIndex)
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frames.size(), "Frame index is out of range");
+			auto& frame = m_frames[frameIndex];
+
+			auto* counts = frame.mapping.get<uint32_t>(0);
+			for (uint32_t material = 0; material < m_materials.size(); ++material)
+				counts[material] = static_cast<uint32_t>(m_materials[material].commands.size());
+
+			for (auto globalSlot : frame.dirtySlots)
+			{
+				uint32_t material = globalSlot / m_maxDrawsPerMaterial;
+				uint32_t slot = globalSlot % m_maxDrawsPerMaterial;
+				const auto& commands = m_materials[material].commands;
+				// slots freed after being marked dirty are outside of the drawn range
+				if (slot < commands.size())
+					*frame.mapping.get<DrawIndexedCommand>(getCommandOffset(material, slot)) = commands[slot];
+			}
+			frame.dirtySlots.clear();
+
+			for (uint32_t materialIndex = 0; materialIndex < m_materials.size(); ++materialIndex)
+			{
+				const auto& data = m_materials[materialIndex];
+				if (data.commands.empty())
+					continue;
+
+				const auto& material = data.material;
+				recorder.bindPipeline(functions, material.pipeline, PipelineBindPoint::Graphics);
+				if (material.descriptorSet.isSet())
+					recorder.bindDescriptorSets(functions, PipelineBindPoint::Graphics, material.layout,
+						material.setIndex, std::span<const DescriptorSet>(&material.descriptorSet, 1));
+				if (material.vertexBuffer.isSet())
+					recorder.bindVertexBuffers(functions, 0, std::span<const BufferRef>(&material.vertexBuffer, 1),
+						std::span<const DeviceSize>(&material.vertexBufferOffset, 1));
+				recorder.bindIndexBuffer(functions, material.indexBuffer, material.indexBufferOffset, material.indexType);
+
+				auto& commandBuffer = recorder.getCommandBuffer();
+				if (m_useDrawCount)
+					commandBuffer.drawIndexedIndirectCount(functions, frame.buffer, getCommandOffset(materialIndex, 0),
+						frame.buffer, sizeof(uint32_t) * materialIndex, m_maxDrawsPerMaterial);
+				else
+					commandBuffer.drawIndexedIndirect(functions, frame.buffer, getCommandOffset(materialIndex, 0),
+						static_cast<uint32_t>(data.commands.size()));
+			}
+		}
+
+		// the indirect buffer of a frame, the draw count of material i is stored at offset 4 * i
+		BufferRef getIndirectBuffer(uint32_t frameIndex) const { return m_frames[frameIndex].buffer; };
+		DeviceSize getCommandOffset(uint32_t material, uint32_t slot) const {
+			DeviceSize countsSize = sizeof(uint32_t) * m_maxMaterials;
+			return countsSize + sizeof(DrawIndexedCommand) * (static_cast<DeviceSize>(material) * m_maxDrawsPerMaterial + slot);
+		}
+
+		bool usesDrawCount() const { return m_useDrawCount; };
+		size_t getMaterialCount() const { return m_materials.size(); };
+		size_t getDrawCount(uint32_t material) const { return m_materials[material].commands.size(); };
+
+	private:
+		const ObjectData& getObject(ObjectHandle handle) const {
+			GRAPHICS_VERIFY(handle < m_objects.size() && m_objects[handle].material < m_materials.size(),
+				"Invalid object handle");
+			return m_objects[handle];
+		}
+
+		// every frame buffer has to pick up the change before the slot is clean again
+		void markDirty(uint32_t material, uint32_t slot) {
+			for (auto& frame : m_frames)
+				frame.dirtySlots.push_back(material * m_maxDrawsPerMaterial + slot);
+		}
+	};
+}
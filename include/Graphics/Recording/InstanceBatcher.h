@@ -0,0 +1,235 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Pipeline.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+#include "Graphics/Utility/Utility.h"
+#include "Graphics/Utility/BufferDataBuilders.h"
+#include "StateCachingRecorder.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace Graphics::Recording
+{
+	// Groups objects sharing a mesh and a material and draws every group with a single
+	// instanced drawIndexed. Transforms and ids are written into a per-frame host visible
+	// instance buffer read through the VertexDefinitionModelTransform (binding 2)
+	// and VertexDefinitionId (binding 3) instance rate bindings.
+	class InstanceBatcher
+	{
+	public:
+		static constexpr uint32_t s_maxMeshVertexBindings = 2;
+		static constexpr uint32_t s_transformBinding = Utility::VertexDefinitionModelTransform::s_bindings[0].binding;
+		static constexpr uint32_t s_idBinding = Utility::VertexDefinitionId::s_bindings[0].binding;
+
+		struct Mesh {
+			// per vertex bindings starting at binding 0
+			std::array<BufferRef, s_maxMeshVertexBindings> vertexBuffers{};
+			std::array<DeviceSize, s_maxMeshVertexBindings> vertexBufferOffsets{};
+			uint32_t vertexBindingCount = 1;
+
+			BufferRef indexBuffer;
+			DeviceSize indexBufferOffset = 0;
+			IndexType indexType = IndexType::Uint32;
+
+			uint32_t indexCount = 0;
+			uint32_t firstIndex = 0;
+			int32_t vertexOffset = 0;
+		};
+
+		struct Material {
+			PipelineRef pipeline;
+			PipelineLayoutRef layout;
+			// left unset when the material has no descriptor set
+			DescriptorSet descriptorSet;
+			uint32_t setIndex = 0;
+		};
+
+	private:
+		using TransformType = Utility::VertexDefinitionModelTransform::Type;
+		using IdType = Utility::VertexDefinitionId::Type;
+
+		struct Instance {
+			uint32_t group;
+			uint32_t id;
+			TransformType transform;
+		};
+
+		struct Group {
+			uint32_t mesh;
+			uint32_t material;
+			uint32_t instanceCount;
+			uint32_t firstInstance;
+		};
+
+		struct FrameInstanceData {
+			Buffer buffer;
+			Memory memory;
+			MemoryMapping mapping;
+		};
+
+		std::vector<Mesh> m_meshes;
+		std::vector<Material> m_materials;
+
+		std::vector<Instance> m_instances;
+		std::vector<Group> m_groups;
+		// (material << 32 | mesh) -> index into m_groups
+		std::unordered_map<uint64_t, uint32_t> m_groupLookup;
+
+		std::vector<FrameInstanceData> m_frames;
+		uint32_t m_instanceCapacity = 0;
+		uint32_t m_lastDrawCount = 0;
+
+	public:
+		InstanceBatcher() = default;
+
+		InstanceBatcher(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, uint32_t framesInFlight, uint32_t instanceCapacity)
+		{
+			create(functions, device, memoryProperties, framesInFlight, instanceCapacity);
+		}
+
+		InstanceBatcher(const InstanceBatcher&) = delete;
+		InstanceBatcher& operator=(const InstanceBatcher&) = delete;
+
+		~InstanceBatcher() { GRAPHICS_VERIFY(m_frames.empty(), "InstanceBatcher was not destroyed"); };
+
+		void create(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, uint32_t framesInFlight, uint32_t instanceCapacity)
+		{
+			GRAPHICS_VERIFY(m_frames.empty(), "Trying to create a valid InstanceBatcher");
+			m_instanceCapacity = instanceCapacity;
+			m_frames.resize(framesInFlight);
+
+			for (auto& frame : m_frames)
+			{
+				Utility::initBufferMemoryPairFirstFit(functions, device, memoryProperties, frame.buffer, frame.memory,
+					getIdOffset() + sizeof(IdType) * instanceCapacity, Flags::BufferUsage::Bits::VertexBuffer,
+					Flags::MemoryProperty::Bits::HostVisibleCoherent);
+				frame.mapping = frame.memory.map(functions, device);
+			}
+		}
+
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			for (auto& frame : m_frames)
+			{
+				frame.memory.unmap(functions, device, frame.mapping);
+				frame.buffer.destroy(functions, device);
+				frame.memory.destroy(functions, device);
+			}
+			m_frames.clear();
+		}
+
+		uint32_t registerMesh(const Mesh& mesh) {
+			GRAPHICS_VERIFY(mesh.indexBuffer.isSet(), "Batched meshes must be indexed");
+			GRAPHICS_VERIFY(mesh.vertexBindingCount <= s_maxMeshVertexBindings, "Too many mesh vertex bindings");
+			m_meshes.push_back(mesh);
+			return static_cast<uint32_t>(m_meshes.size() - 1);
+		}
+
+		uint32_t registerMaterial(const Material& material) {
+			m_materials.push_back(material);
+			return static_cast<uint32_t>(m_materials.size() - 1);
+		}
+
+		void add(uint32_t mesh, uint32_t material, const TransformType& transform, IdType id)
+		{
+			GRAPHICS_VERIFY(mesh < m_meshes.size() && material < m_materials.size(), "Unknown mesh or material");
+			if (m_instances.size() == m_instanceCapacity)
+				throw std::runtime_error("Instance count exceeds instance buffer capacity");
+
+			uint64_t key = (uint64_t(material) << 32) | mesh;
+			auto [it, inserted] = m_groupLookup.try_emplace(key, static_cast<uint32_t>(m_groups.size()));
+			if (inserted)
+				m_groups.push_back({ mesh, material, 0, 0 });
+
+			++m_groups[it->second].instanceCount;
+			m_instances.push_back({ it->second, id, transform });
+		}
+
+		// writes the instance data of this frame and records one draw per group.
+		// The buffer of frameIndex must no longer be in use by the GPU.
+		void flush(const DeviceFunctionTable& functions, StateCachingRecorder& recorder, uint32_t frameIndex)
+		{
+			GRAPHICS_VERIFY(frameIndex < m_frames.size(), "Frame index is out of range");
+			auto& frame = m_frames[frameIndex];
+
+			// draw groups sharing a material next to each other
+			std::vector<uint32_t> order(m_groups.size());
+			for (uint32_t i = 0; i < order.size(); ++i)
+				order[i] = i;
+			std::sort(order.begin(), order.end(), [this](uint32_t left, uint32_t right) {
+				const auto& l = m_groups[left];
+				const auto& r = m_groups[right];
+				return l.material != r.material ? l.material < r.material : l.mesh < r.mesh;
+			});
+
+			uint32_t firstInstance = 0;
+			for (auto groupIndex : order)
+			{
+				auto& group = m_groups[groupIndex];
+				group.firstInstance = firstInstance;
+				firstInstance += group.instanceCount;
+				// reused as the write cursor below
+				group.instanceCount = 0;
+			}
+
+			auto* transforms = frame.mapping.get<TransformType>(0);
+			auto* ids = frame.mapping.get<IdType>(getIdOffset());
+			for (const auto& instance : m_instances)
+			{
+				auto& group = m_groups[instance.group];
+				auto slot = group.firstInstance + group.instanceCount++;
+				transforms[slot] = instance.transform;
+				ids[slot] = instance.id;
+			}
+
+			if (!m_instances.empty())
+			{
+				std::array<BufferRef, 2> instanceBuffers = { frame.buffer.getReference(), frame.buffer.getReference() };
+				std::array<DeviceSize, 2> instanceOffsets = { 0, getIdOffset() };
+				static_assert(s_idBinding == s_transformBinding + 1);
+				recorder.bindVertexBuffers(functions, s_transformBinding, instanceBuffers, instanceOffsets);
+			}
+
+			for (auto groupIndex : order)
+			{
+				const auto& group = m_groups[groupIndex];
+				const auto& mesh = m_meshes[group.mesh];
+				const auto& material = m_materials[group.material];
+
+				recorder.bindPipeline(functions, material.pipeline, PipelineBindPoint::Graphics);
+				if (material.descriptorSet.isSet())
+					recorder.bindDescriptorSets(functions, PipelineBindPoint::Graphics, material.layout,
+						material.setIndex, std::span<const DescriptorSet>(&material.descriptorSet, 1));
+
+				recorder.bindVertexBuffers(functions, 0,
+					std::span<const BufferRef>(mesh.vertexBuffers.data(), mesh.vertexBindingCount),
+					std::span<const DeviceSize>(mesh.vertexBufferOffsets.data(), mesh.vertexBindingCount));
+				recorder.bindIndexBuffer(functions, mesh.indexBuffer, mesh.indexBufferOffset, mesh.indexType);
+
+				recorder.getCommandBuffer().drawIndexed(functions, mesh.indexCount, group.instanceCount,
+					mesh.firstIndex, static_cast<uint32_t>(mesh.vertexOffset), group.firstInstance);
+			}
+
+			m_lastDrawCount = static_cast<uint32_t>(m_groups.size());
+			m_instances.clear();
+			m_groups.clear();
+			m_groupLookup.clear();
+		}
+
+		// number of draws recorded by the last flush, one per unique mesh and material pair
+		uint32_t getLastDrawCount() const { return m_lastDrawCount; };
+		uint32_t getInstanceCapacity() const { return m_instanceCapacity; };
+		size_t getPendingInstanceCount() const { return m_instances.size(); };
+
+	private:
+		DeviceSize getIdOffset() const { return sizeof(TransformType) * m_instanceCapacity; };
+	};
+}
@@ -0,0 +1,234 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Pipeline.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+#include "StateCachingRecorder.h"
+
+#include <vector>
+#include <array>
+#include <algorithm>
+
+namespace Graphics::Recording
+{
+	// 64 bit draw sort key, most significant bits first:
+	//   opaque:      | pass 4 | 0 | pipeline 16 | material 16 | depth 24       | 3 unused |
+	//   translucent: | pass 4 | 1 | inverted depth 24 | pipeline 16 | material 16 | 3 unused |
+	// Ascending order draws passes in sequence, opaque before translucent, groups opaque draws
+	// by state and sorts them front-to-back, translucent draws are sorted back-to-front.
+	struct SortKey
+	{
+		static constexpr uint32_t s_passBits = 4;
+		static constexpr uint32_t s_pipelineBits = 16;
+		static constexpr uint32_t s_materialBits = 16;
+		static constexpr uint32_t s_depthBits = 24;
+
+		static constexpr uint32_t s_passShift = 60;
+		static constexpr uint32_t s_translucentShift = 59;
+
+		static constexpr uint64_t s_depthMax = (uint64_t(1) << s_depthBits) - 1;
+
+		// depth is expected to be normalized to [0, 1], 0 being closest to the camera.
+		// NaN and values below 0 map to 0, values above 1 and infinity to s_depthMax, the float to integer
+		// conversion would be undefined for them
+		static constexpr uint64_t quantizeDepth(float depth) {
+			if (!(depth > 0.0f))
+				return 0;
+			if (depth >= 1.0f)
+				return s_depthMax;
+			return std::min(static_cast<uint64_t>(depth * static_cast<float>(s_depthMax)), s_depthMax);
+		}
+
+		static constexpr uint64_t makeOpaque(uint32_t pass, uint16_t pipelineId, uint16_t materialId, float depth) {
+			return (uint64_t(pass & 0xF) << s_passShift)
+				| (uint64_t(pipelineId) << 43)
+				| (uint64_t(materialId) << 27)
+				| (quantizeDepth(depth) << 3);
+		}
+
+		static constexpr uint64_t makeTranslucent(uint32_t pass, uint16_t pipelineId, uint16_t materialId, float depth) {
+			return (uint64_t(pass & 0xF) << s_passShift)
+				| (uint64_t(1) << s_translucentShift)
+				| ((s_depthMax - quantizeDepth(depth)) << 35)
+				| (uint64_t(pipelineId) << 19)
+				| (uint64_t(materialId) << 3);
+		}
+
+		static constexpr uint32_t getPass(uint64_t key) { return static_cast<uint32_t>(key >> s_passShift); };
+		static constexpr bool isTranslucent(uint64_t key) { return (key >> s_translucentShift) & 1; };
+	};
+
+	struct DrawPacket
+	{
+		uint64_t sortKey = 0;
+
+		PipelineRef pipeline;
+		PipelineLayoutRef layout;
+
+		// material descriptor set, left unset when the draw has none
+		DescriptorSet materialSet;
+		uint32_t materialSetIndex = 0;
+
+		BufferRef vertexBuffer;
+		DeviceSize vertexBufferOffset = 0;
+
+		// indexed draws set an index buffer, otherwise the packet is drawn with vkCmdDraw
+		BufferRef indexBuffer;
+		DeviceSize indexBufferOffset = 0;
+		IndexType indexType = IndexType::Uint32;
+
+		// vertexCount or indexCount
+		uint32_t elementCount = 0;
+		uint32_t instanceCount = 1;
+		// firstVertex or firstIndex
+		uint32_t firstElement = 0;
+		int32_t vertexOffset = 0;
+		uint32_t firstInstance = 0;
+
+		bool isIndexed() const { return indexBuffer.isSet(); };
+	};
+
+	// Collects draw packets for a frame, radix sorts them by key and replays them
+	// through a StateCachingRecorder so consecutive draws sharing state do not rebind it.
+	class RenderQueue
+	{
+		struct SortEntry {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		std::vector<DrawPacket> m_packets;
+		std::vector<SortEntry> m_entries;
+		std::vector<SortEntry> m_scratch;
+		bool m_sorted = true;
+
+	public:
+		RenderQueue() = default;
+		RenderQueue(size_t expectedDrawCount) { reserve(expectedDrawCount); };
+
+		void reserve(size_t drawCount) {
+			m_packets.reserve(drawCount);
+			m_entries.reserve(drawCount);
+			m_scratch.reserve(drawCount);
+		}
+
+		void push(const DrawPacket& packet) {
+			m_entries.push_back({ packet.sortKey, static_cast<uint32_t>(m_packets.size()) });
+			m_packets.push_back(packet);
+			m_sorted = false;
+		}
+
+		// keeps the allocated capacity, intended to be called once per frame
+		void clear() {
+			m_packets.clear();
+			m_entries.clear();
+			m_sorted = true;
+		}
+
+		size_t size() const { return m_packets.size(); };
+		bool empty() const { return m_packets.empty(); };
+
+		// packet at the given position of the sorted order
+		const DrawPacket& getSorted(size_t position) const { return m_packets[m_entries[position].index]; };
+
+		void sort()
+		{
+			if (m_sorted)
+				return;
+
+			radixSort();
+			m_sorted = true;
+		}
+
+		// replays every packet in key order
+		void replay(const DeviceFunctionTable& functions, StateCachingRecorder& recorder)
+		{
+			sort();
+			replayRange(functions, recorder, 0, m_entries.size());
+		}
+
+		// replays only the packets of one pass, so passes can be recorded into different render passes
+		void replay(const DeviceFunctionTable& functions, StateCachingRecorder& recorder, uint32_t pass)
+		{
+			sort();
+			auto first = std::lower_bound(m_entries.begin(), m_entries.end(), uint64_t(pass) << SortKey::s_passShift,
+				[](const SortEntry& entry, uint64_t key) { return entry.key < key; });
+			auto last = std::find_if(first, m_entries.end(),
+				[pass](const SortEntry& entry) { return SortKey::getPass(entry.key) != pass; });
+
+			replayRange(functions, recorder, first - m_entries.begin(), last - m_entries.begin());
+		}
+
+	private:
+		void replayRange(const DeviceFunctionTable& functions, StateCachingRecorder& recorder,
+			size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				const auto& packet = m_packets[m_entries[i].index];
+
+				recorder.bindPipeline(functions, packet.pipeline, PipelineBindPoint::Graphics);
+				if (packet.materialSet.isSet())
+					recorder.bindDescriptorSets(functions, PipelineBindPoint::Graphics, packet.layout,
+						packet.materialSetIndex, std::span<const DescriptorSet>(&packet.materialSet, 1));
+				if (packet.vertexBuffer.isSet())
+					recorder.bindVertexBuffers(functions, 0, std::span<const BufferRef>(&packet.vertexBuffer, 1),
+						std::span<const DeviceSize>(&packet.vertexBufferOffset, 1));
+
+				auto& commandBuffer = recorder.getCommandBuffer();
+				if (packet.isIndexed())
+				{
+					recorder.bindIndexBuffer(functions, packet.indexBuffer, packet.indexBufferOffset, packet.indexType);
+					commandBuffer.drawIndexed(functions, packet.elementCount, packet.instanceCount,
+						packet.firstElement, static_cast<uint32_t>(packet.vertexOffset), packet.firstInstance);
+				}
+				else
+				{
+					commandBuffer.draw(functions, packet.elementCount, packet.instanceCount,
+						packet.firstElement, packet.firstInstance);
+				}
+			}
+		}
+
+		// LSD radix sort over 8 bit digits. Only the small (key, index) entries are moved,
+		// digits that are identical for every key are skipped.
+		void radixSort()
+		{
+			const size_t count = m_entries.size();
+			if (count < 2)
+				return;
+
+			std::array<std::array<uint32_t, 256>, 8> histograms{};
+			for (const auto& entry : m_entries)
+				for (uint32_t digit = 0; digit < 8; ++digit)
+					++histograms[digit][(entry.key >> (digit * 8)) & 0xFF];
+
+			m_scratch.resize(count);
+			auto* source = &m_entries;
+			auto* destination = &m_scratch;
+
+			for (uint32_t digit = 0; digit < 8; ++digit)
+			{
+				auto& histogram = histograms[digit];
+				uint32_t firstByte = (source->front().key >> (digit * 8)) & 0xFF;
+				if (histogram[firstByte] == count)
+					continue;
+
+				uint32_t offset = 0;
+				for (auto& bucket : histogram)
+					offset += std::exchange(bucket, offset);
+
+				for (const auto& entry : *source)
+					(*destination)[histogram[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
+
+				std::swap(source, destination);
+			}
+
+			if (source != &m_entries)
+				std::swap(m_entries, m_scratch);
+		}
+	};
+}
@@ -0,0 +1,321 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/HandleTypes/DescriptorSet.h"
+
+#include <array>
+#include <cstring>
+
+namespace Graphics::Recording
+{
+	// Thin layer over a CommandBuffer that remembers the currently bound state
+	// and drops binds that would not change anything.
+	// Everything that is not a bind is recorded directly through getCommandBuffer().
+	class StateCachingRecorder
+	{
+	public:
+		enum class StateCommand : uint32_t {
+			BindPipeline,
+			BindDescriptorSets,
+			BindVertexBuffers,
+			BindIndexBuffer,
+			SetViewports,
+			SetScissors,
+			Num
+		};
+
+		struct Statistics {
+			std::array<uint32_t, static_cast<size_t>(StateCommand::Num)> issued{};
+			std::array<uint32_t, static_cast<size_t>(StateCommand::Num)> elided{};
+
+			uint32_t getIssued(StateCommand command) const { return issued[static_cast<size_t>(command)]; };
+			uint32_t getElided(StateCommand command) const { return elided[static_cast<size_t>(command)]; };
+
+			uint32_t getTotalIssued() const {
+				uint32_t total = 0;
+				for (auto count : issued)
+					total += count;
+				return total;
+			}
+
+			uint32_t getTotalElided() const {
+				uint32_t total = 0;
+				for (auto count : elided)
+					total += count;
+				return total;
+			}
+		};
+
+		// cached slots, binds outside of these ranges are always forwarded
+		static constexpr uint32_t s_maxDescriptorSets = 8;
+		static constexpr uint32_t s_maxVertexBindings = 16;
+		static constexpr uint32_t s_maxViewports = 16;
+
+	private:
+		struct BindPointState {
+			VkPipeline pipeline = VK_NULL_HANDLE;
+			VkPipelineLayout layout = VK_NULL_HANDLE;
+			std::array<VkDescriptorSet, s_maxDescriptorSets> descriptorSets{};
+		};
+
+		struct VertexBinding {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			DeviceSize offset = 0;
+		};
+
+		// only graphics and compute are cached, other bind points are forwarded
+		std::array<BindPointState, 2> m_bindPoints{};
+		std::array<VertexBinding, s_maxVertexBindings> m_vertexBindings{};
+
+		VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+		size_t m_indexOffset = 0;
+		IndexType m_indexType = IndexType::Uint32;
+
+		std::array<VkViewport, s_maxViewports> m_viewports{};
+		std::array<VkRect2D, s_maxViewports> m_scissors{};
+		uint32_t m_viewportMask = 0;
+		uint32_t m_scissorMask = 0;
+
+		CommandBuffer m_commandBuffer;
+		Statistics m_statistics;
+
+	public:
+		StateCachingRecorder() = default;
+		StateCachingRecorder(const CommandBuffer& commandBuffer) : m_commandBuffer(commandBuffer) {};
+
+		// starts tracking a new command buffer, the cached state does not carry over between buffers
+		void setCommandBuffer(const CommandBuffer& commandBuffer) {
+			m_commandBuffer = commandBuffer;
+			invalidate();
+		}
+
+		CommandBuffer& getCommandBuffer() { return m_commandBuffer; };
+		const CommandBuffer& getCommandBuffer() const { return m_commandBuffer; };
+
+		// forgets every cached binding, must be called whenever state is changed behind the recorder's back
+		// (direct calls on the command buffer, executing secondary buffers, begin of recording)
+		void invalidate() {
+			m_bindPoints = {};
+			m_vertexBindings = {};
+			m_indexBuffer = VK_NULL_HANDLE;
+			m_indexOffset = 0;
+			m_indexType = IndexType::Uint32;
+			m_viewportMask = 0;
+			m_scissorMask = 0;
+		}
+
+		const Statistics& getStatistics() const { return m_statistics; };
+
+		// intended to be called once per frame after the statistics were read
+		void resetStatistics() { m_statistics = {}; };
+
+		void bindPipeline(const DeviceFunctionTable& functions,
+			const PipelineRef& pipeline, PipelineBindPoint bindPoint)
+		{
+			auto* state = getBindPointState(bindPoint);
+			if (state && state->pipeline == pipeline.getHandle())
+			{
+				elide(StateCommand::BindPipeline);
+				return;
+			}
+
+			m_commandBuffer.bindPipeline(functions, pipeline, bindPoint);
+			issue(StateCommand::BindPipeline);
+
+			if (!state)
+				return;
+			state->pipeline = pipeline.getHandle();
+
+			// pipelines with static viewport or scissor state overwrite the dynamic one
+			if (bindPoint == PipelineBindPoint::Graphics)
+			{
+				m_viewportMask = 0;
+				m_scissorMask = 0;
+			}
+		}
+
+		void bindDescriptorSets(const DeviceFunctionTable& functions, PipelineBindPoint pipelineBindPoint,
+			const PipelineLayoutRef& pipelineLayout, uint32_t firstSet, std::span<const DescriptorSet> descriptorSets,
+			std::span<const uint32_t> dynamicOffsets = {})
+		{
+			auto* state = getBindPointState(pipelineBindPoint);
+			bool cacheable = state && dynamicOffsets.empty() &&
+				firstSet + descriptorSets.size() <= s_maxDescriptorSets;
+
+			if (!cacheable)
+			{
+				m_commandBuffer.bindDescriptorSets(functions, pipelineBindPoint, pipelineLayout,
+					firstSet, descriptorSets, dynamicOffsets);
+				issue(StateCommand::BindDescriptorSets);
+				if (state)
+				{
+					// dynamic offsets are not tracked, the sets are no longer known
+					state->layout = pipelineLayout.getHandle();
+					state->descriptorSets = {};
+				}
+				return;
+			}
+
+			if (state->layout != pipelineLayout.getHandle())
+			{
+				state->layout = pipelineLayout.getHandle();
+				state->descriptorSets = {};
+			}
+
+			// only rebind the smallest contiguous range that actually changes
+			size_t first = 0;
+			size_t last = descriptorSets.size();
+			while (first < last && state->descriptorSets[firstSet + first] == descriptorSets[first].getHandle())
+				++first;
+			while (last > first && state->descriptorSets[firstSet + last - 1] == descriptorSets[last - 1].getHandle())
+				--last;
+
+			if (first == last)
+			{
+				elide(StateCommand::BindDescriptorSets);
+				return;
+			}
+
+			m_commandBuffer.bindDescriptorSets(functions, pipelineBindPoint, pipelineLayout,
+				firstSet + static_cast<uint32_t>(first), descriptorSets.subspan(first, last - first));
+			issue(StateCommand::BindDescriptorSets);
+
+			for (size_t i = first; i < last; ++i)
+				state->descriptorSets[firstSet + i] = descriptorSets[i].getHandle();
+		}
+
+		void bindVertexBuffers(const DeviceFunctionTable& functions, uint32_t firstBinding,
+			std::span<const BufferRef> buffers, std::span<const DeviceSize> offsets)
+		{
+			GRAPHICS_VERIFY(buffers.size() == offsets.size(), "Buffers and offsets sizes must match");
+			if (firstBinding + buffers.size() > s_maxVertexBindings)
+			{
+				m_commandBuffer.bindVertexBuffers(functions, firstBinding, buffers, offsets);
+				issue(StateCommand::BindVertexBuffers);
+				return;
+			}
+
+			auto matches = [&](size_t i) {
+				const auto& binding = m_vertexBindings[firstBinding + i];
+				return binding.buffer == buffers[i].getHandle() && binding.offset == offsets[i];
+			};
+
+			size_t first = 0;
+			size_t last = buffers.size();
+			while (first < last && matches(first))
+				++first;
+			while (last > first && matches(last - 1))
+				--last;
+
+			if (first == last)
+			{
+				elide(StateCommand::BindVertexBuffers);
+				return;
+			}
+
+			m_commandBuffer.bindVertexBuffers(functions, firstBinding + static_cast<uint32_t>(first),
+				buffers.subspan(first, last - first), offsets.subspan(first, last - first));
+			issue(StateCommand::BindVertexBuffers);
+
+			for (size_t i = first; i < last; ++i)
+				m_vertexBindings[firstBinding + i] = { buffers[i].getHandle(), offsets[i] };
+		}
+
+		void bindIndexBuffer(const DeviceFunctionTable& functions,
+			const BufferRef& buffer, size_t offset, IndexType indexType)
+		{
+			if (m_indexBuffer == buffer.getHandle() && m_indexOffset == offset && m_indexType == indexType)
+			{
+				elide(StateCommand::BindIndexBuffer);
+				return;
+			}
+
+			m_commandBuffer.bindIndexBuffer(functions, buffer, offset, indexType);
+			issue(StateCommand::BindIndexBuffer);
+
+			m_indexBuffer = buffer.getHandle();
+			m_indexOffset = offset;
+			m_indexType = indexType;
+		}
+
+		template<typename T>
+		void bindIndexBuffer(const DeviceFunctionTable& functions,
+			const BufferRef& buffer, size_t offset)
+		{
+			bindIndexBuffer(functions, buffer, offset, IndexTypeTraits_v<T>);
+		}
+
+		void setViewports(const DeviceFunctionTable& functions, uint32_t firstViewport,
+			std::span<const Viewport> viewports)
+		{
+			setRegions(StateCommand::SetViewports, m_viewports, m_viewportMask, firstViewport, viewports,
+				[&](uint32_t first, std::span<const Viewport> changed) {
+					m_commandBuffer.setViewports(functions, first, changed);
+				});
+		}
+
+		void setScissors(const DeviceFunctionTable& functions, uint32_t firstScissor,
+			std::span<const Scissor> scissors)
+		{
+			setRegions(StateCommand::SetScissors, m_scissors, m_scissorMask, firstScissor, scissors,
+				[&](uint32_t first, std::span<const Scissor> changed) {
+					m_commandBuffer.setScissors(functions, first, changed);
+				});
+		}
+
+	private:
+		BindPointState* getBindPointState(PipelineBindPoint bindPoint) {
+			switch (bindPoint)
+			{
+			case PipelineBindPoint::Graphics: return &m_bindPoints[0];
+			case PipelineBindPoint::Compute: return &m_bindPoints[1];
+			default: return nullptr;
+			}
+		}
+
+		void issue(StateCommand command) { ++m_statistics.issued[static_cast<size_t>(command)]; };
+		void elide(StateCommand command) { ++m_statistics.elided[static_cast<size_t>(command)]; };
+
+		template<typename C, typename T, typename Func>
+		void setRegions(StateCommand command, std::array<C, s_maxViewports>& cache, uint32_t& validMask,
+			uint32_t firstIndex, std::span<const T> regions, Func&& record)
+		{
+			if (firstIndex + regions.size() > s_maxViewports)
+			{
+				record(firstIndex, regions);
+				issue(command);
+				return;
+			}
+
+			auto matches = [&](size_t i) {
+				return (validMask & (1u << (firstIndex + i))) &&
+					std::memcmp(&cache[firstIndex + i], regions[i].getUnderlyingPointer(), sizeof(cache[0])) == 0;
+			};
+
+			size_t first = 0;
+			size_t last = regions.size();
+			while (first < last && matches(first))
+				++first;
+			while (last > first && matches(last - 1))
+				--last;
+
+			if (first == last)
+			{
+				elide(command);
+				return;
+			}
+
+			record(firstIndex + static_cast<uint32_t>(first), regions.subspan(first, last - first));
+			issue(command);
+
+			for (size_t i = first; i < last; ++i)
+			{
+				cache[firstIndex + i] = regions[i];
+				validMask |= 1u << (firstIndex + i);
+			}
+		}
+	};
+}
@@ -0,0 +1,970 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Image.h"
+#include "Graphics/HandleTypes/Semaphore.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/Synchronization/ResourceStateTracker.h"
+#include "Graphics/Utility/Utility.h"
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <bit>
+
+namespace Graphics::RenderGraph
+{
+	using Synchronization::ResourceUse;
+
+	enum class QueueType : uint32_t {
+		Graphics,
+		Compute,
+		Num
+	};
+
+	struct ResourceHandle
+	{
+		static constexpr uint32_t s_invalid = std::numeric_limits<uint32_t>::max();
+		uint32_t index = s_invalid;
+
+		bool isValid() const { return index != s_invalid; };
+		bool operator==(const ResourceHandle&) const = default;
+	};
+
+	struct TextureDesc
+	{
+		PixelFormat format = PixelFormat::R8G8B8A8Unorm;
+		uint32_t width = 1;
+		uint32_t height = 1;
+		uint32_t mipLevels = 1;
+		uint32_t arrayLayers = 1;
+		Flags::ImageAspect aspect = Flags::ImageAspect::Bits::Color;
+	};
+
+	struct BufferDesc
+	{
+		DeviceSize size = 0;
+	};
+
+	class Graph;
+
+	// what a pass callback can see while it is recorded
+	class PassContext
+	{
+		const Graph& m_graph;
+		CommandBuffer& m_commandBuffer;
+		uint32_t m_frameIndex;
+
+	public:
+		PassContext(const Graph& graph, CommandBuffer& commandBuffer, uint32_t frameIndex) :
+			m_graph(graph), m_commandBuffer(commandBuffer), m_frameIndex(frameIndex) {};
+
+		CommandBuffer& getCommandBuffer() { return m_commandBuffer; };
+		ImageRef getImage(ResourceHandle handle) const;
+		ImageViewRef getImageView(ResourceHandle handle) const;
+		BufferRef getBuffer(ResourceHandle handle) const;
+		const TextureDesc& getTextureDesc(ResourceHandle handle) const;
+	};
+
+	using ExecuteFunction = std::function<void(const DeviceFunctionTable& functions, PassContext& context)>;
+
+	// declares the resources a pass creates, reads and writes, only valid inside the setup callback
+	class PassBuilder
+	{
+		Graph& m_graph;
+		uint32_t m_pass;
+
+	public:
+		PassBuilder(Graph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {};
+
+		ResourceHandle createTexture(const std::string& name, const TextureDesc& desc);
+		ResourceHandle createBuffer(const std::string& name, const BufferDesc& desc);
+
+		// the use decides the barrier before the pass and the usage flags of transient resources,
+		// uses of one resource in the same pass are combined and must agree on the layout
+		ResourceHandle read(ResourceHandle resource, const ResourceUse& use);
+		ResourceHandle write(ResourceHandle resource, const ResourceUse& use);
+
+		// the pass is never culled, e.g. because it reads back to the host or writes a buffer
+		// that is not imported into the graph
+		void setSideEffect();
+
+	private:
+		void addAccess(ResourceHandle resource, const ResourceUse& use);
+	};
+
+	// one command buffer worth of passes on a single queue, submitted in the returned order
+	struct Submission
+	{
+		QueueType queue;
+		CommandBuffer commandBuffer;
+		std::vector<SemaphoreRef> waitSemaphores;
+		std::vector<Flags::PipelineStage> waitStages;
+		// left unset when no other submission waits on this one
+		SemaphoreRef signalSemaphore;
+	};
+
+	// Frame graph over virtual resources. Passes declare their accesses in a setup callback,
+	// compile() culls passes whose results are never used, orders the rest so work on the same
+	// queue stays together, splits them into per queue submissions connected by semaphores and
+	// places transient resources with disjoint lifetimes in the same memory.
+	// Every frame in flight owns its transient resources and semaphores, an execution of a frame index
+	// must only start after the previous submissions of that index completed, e.g. after its frame fence.
+	// execute() records the passes with barriers from a ResourceStateTracker.
+	// Render passes begun by pass callbacks must keep attachments in the declared layouts,
+	// transitions are done by the graph.
+	class Graph
+	{
+		friend class PassBuilder;
+		friend class PassContext;
+
+		static constexpr uint32_t s_none = std::numeric_limits<uint32_t>::max();
+
+		struct Access {
+			uint32_t resource;
+			ResourceUse use;
+		};
+
+		struct Pass {
+			std::string name;
+			QueueType queue;
+			ExecuteFunction execute;
+			std::vector<Access> accesses;
+			bool sideEffect = false;
+			bool culled = false;
+		};
+
+		enum class ResourceType {
+			Texture,
+			Buffer
+		};
+
+		struct Resource {
+			std::string name;
+			ResourceType type;
+			bool imported = false;
+			bool output = false;
+			TextureDesc texture;
+			BufferDesc buffer;
+
+			ImageRef image;
+			ImageViewRef view;
+			BufferRef bufferRef;
+
+			// imported resources start every execution in initialUse and end in finalUse when it is set
+			ResourceUse initialUse;
+			ResourceUse finalUse;
+			bool hasFinalUse = false;
+
+			// compiled data of transient resources
+			Flags::ImageUsage imageUsage;
+			Flags::BufferUsage bufferUsage;
+			uint32_t firstPosition = s_none;
+			uint32_t lastPosition = 0;
+			uint32_t queueMask = 0;
+			uint32_t heap = s_none;
+			DeviceSize offset = 0;
+			DeviceSize size = 0;
+			DeviceSize alignment = 1;
+			uint32_t memoryTypeBits = 0;
+			// stages of the resources sharing the memory in the same frame, waited for before the first use
+			Flags::PipelineStage aliasWaitStages;
+
+			// execution state
+			uint32_t lastQueue = s_none;
+			bool touched = false;
+		};
+
+		struct Batch {
+			QueueType queue;
+			std::vector<uint32_t> passes;
+			// latest batch of every other queue this batch depends on
+			std::vector<uint32_t> waitBatches;
+			std::vector<Flags::PipelineStage> waitStages;
+			// imported resources last used by this batch, their final use is recorded at its end
+			std::vector<uint32_t> finalResources;
+			bool signals = false;
+		};
+
+		struct Heap {
+			uint32_t memoryType;
+			DeviceSize size = 0;
+		};
+
+		// transient resources of one frame in flight, indexed like m_resources and m_heaps
+		struct FrameTransients {
+			std::vector<Memory> memories;
+			std::vector<Image> images;
+			std::vector<ImageView> views;
+			std::vector<Buffer> buffers;
+		};
+
+		std::vector<Pass> m_passes;
+		std::vector<Resource> m_resources;
+
+		std::vector<uint32_t> m_order;
+		std::vector<Batch> m_batches;
+		std::vector<Heap> m_heaps;
+		std::vector<FrameTransients> m_transients;
+		// [frame][batch]
+		std::vector<std::vector<Semaphore>> m_semaphores;
+
+		Synchronization::ResourceStateTracker m_tracker;
+		bool m_compiled = false;
+
+	public:
+		Graph() = default;
+
+		Graph(const Graph&) = delete;
+		Graph& operator=(const Graph&) = delete;
+
+		~Graph() { GRAPHICS_VERIFY(!m_compiled, "Render graph was not destroyed"); };
+
+		ResourceHandle importImage(const std::string& name, const ImageRef& image, const ImageViewRef& view,
+			const TextureDesc& desc, const ResourceUse& initialUse)
+		{
+			GRAPHICS_VERIFY(!m_compiled, "Resources can not be added to a compiled graph");
+			Resource resource;
+			resource.name = name;
+			resource.type = ResourceType::Texture;
+			resource.imported = true;
+			resource.texture = desc;
+			resource.image = image;
+			resource.view = view;
+			resource.initialUse = initialUse;
+			m_resources.push_back(std::move(resource));
+			return { static_cast<uint32_t>(m_resources.size() - 1) };
+		}
+
+		ResourceHandle importBuffer(const std::string& name, const BufferRef& buffer, DeviceSize size,
+			const ResourceUse& initialUse)
+		{
+			GRAPHICS_VERIFY(!m_compiled, "Resources can not be added to a compiled graph");
+			Resource resource;
+			resource.name = name;
+			resource.type = ResourceType::Buffer;
+			resource.imported = true;
+			resource.buffer.size = size;
+			resource.bufferRef = buffer;
+			resource.initialUse = initialUse;
+			m_resources.push_back(std::move(resource));
+			return { static_cast<uint32_t>(m_resources.size() - 1) };
+		}
+
+		// imported resources may change between executions, e.g. the acquired swap chain image
+		void setImportedImage(ResourceHandle handle, const ImageRef& image, const ImageViewRef& view)
+		{
+			auto& resource = getResource(handle);
+			GRAPHICS_VERIFY(resource.imported && resource.type == ResourceType::Texture, "Resource is not an imported image");
+			resource.image = image;
+			resource.view = view;
+		}
+
+		void setImportedBuffer(ResourceHandle handle, const BufferRef& buffer)
+		{
+			auto& resource = getResource(handle);
+			GRAPHICS_VERIFY(resource.imported && resource.type == ResourceType::Buffer, "Resource is not an imported buffer");
+			resource.bufferRef = buffer;
+		}
+
+		// use the imported resource is left in at the end of every execution, e.g. ResourceUse::present()
+		void setFinalUse(ResourceHandle handle, const ResourceUse& use)
+		{
+			auto& resource = getResource(handle);
+			GRAPHICS_VERIFY(resource.imported, "Only imported resources have a final use");
+			resource.finalUse = use;
+			resource.hasFinalUse = true;
+		}
+
+		// keeps the passes producing a transient resource alive even though nothing reads it
+		void markOutput(ResourceHandle handle) { getResource(handle).output = true; };
+
+		void addPass(const std::string& name, QueueType queue,
+			const std::function<void(PassBuilder& builder)>& setup, ExecuteFunction&& execute)
+		{
+			GRAPHICS_VERIFY(!m_compiled, "Passes can not be added to a compiled graph");
+			m_passes.push_back({ name, queue, std::move(execute), {} });
+			PassBuilder builder(*this, static_cast<uint32_t>(m_passes.size() - 1));
+			setup(builder);
+		}
+
+		// queueFamilies lists the families of the queues the submissions go to, transient resources
+		// are shared concurrently between them when more than one queue type is used
+		void compile(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, uint32_t framesInFlight,
+			std::span<const uint32_t> queueFamilies = {})
+		{
+			GRAPHICS_VERIFY(!m_compiled, "Render graph is already compiled");
+			cullPasses();
+			schedulePasses();
+			buildBatches();
+			computeLifetimes();
+			createTransients(functions, device, memoryProperties, framesInFlight, queueFamilies);
+
+			m_semaphores.resize(framesInFlight);
+			for (auto& frameSemaphores : m_semaphores)
+			{
+				frameSemaphores.resize(m_batches.size());
+				for (size_t batch = 0; batch < m_batches.size(); ++batch)
+					if (m_batches[batch].signals)
+						frameSemaphores[batch].create(functions, device);
+			}
+			m_compiled = true;
+		}
+
+		// records every pass, getCommandBuffer is called once per submission and has to return a
+		// command buffer in the recording state for that queue. Submissions must be submitted in order,
+		// the last one completes after every final use transition.
+		std::vector<Submission> execute(const DeviceFunctionTable& functions, uint32_t frameIndex,
+			const std::function<CommandBuffer(QueueType queue)>& getCommandBuffer)
+		{
+			GRAPHICS_VERIFY(m_compiled, "Render graph has to be compiled before it is executed");
+			GRAPHICS_VERIFY(frameIndex < m_semaphores.size(), "Frame index is out of range");
+
+			for (auto& resource : m_resources)
+			{
+				resource.lastQueue = s_none;
+				resource.touched = false;
+				if (!resource.imported)
+					continue;
+
+				if (resource.type == ResourceType::Texture)
+				{
+					m_tracker.registerImage(resource.image, resource.texture.aspect, resource.texture.mipLevels,
+						resource.texture.arrayLayers, resource.initialUse.layout);
+					m_tracker.assumeImage(resource.image, resource.initialUse);
+				}
+				else
+				{
+					m_tracker.registerBuffer(resource.bufferRef, resource.buffer.size);
+					m_tracker.assumeBuffer(resource.bufferRef, resource.initialUse);
+				}
+			}
+
+			std::vector<Submission> submissions;
+			submissions.reserve(m_batches.size());
+			for (uint32_t batchIndex = 0; batchIndex < m_batches.size(); ++batchIndex)
+			{
+				const auto& batch = m_batches[batchIndex];
+				Submission submission{ batch.queue, getCommandBuffer(batch.queue) };
+
+				for (size_t i = 0; i < batch.waitBatches.size(); ++i)
+				{
+					submission.waitSemaphores.push_back(m_semaphores[frameIndex][batch.waitBatches[i]]);
+					submission.waitStages.push_back(batch.waitStages[i]);
+				}
+				if (batch.signals)
+					submission.signalSemaphore = m_semaphores[frameIndex][batchIndex];
+
+				for (auto passIndex : batch.passes)
+				{
+					auto& pass = m_passes[passIndex];
+					for (const auto& access : pass.accesses)
+						requireAccess(m_resources[access.resource], access.use, batch.queue, frameIndex);
+					m_tracker.flush(functions, submission.commandBuffer);
+
+					PassContext context(*this, submission.commandBuffer, frameIndex);
+					pass.execute(functions, context);
+				}
+
+				// on the queue that used the resource last, buildBatches made the last submission wait for it
+				for (auto resource : batch.finalResources)
+					requireAccess(m_resources[resource], m_resources[resource].finalUse, batch.queue, frameIndex);
+				m_tracker.flush(functions, submission.commandBuffer);
+
+				submissions.push_back(std::move(submission));
+			}
+
+			for (auto& resource : m_resources)
+			{
+				if (!resource.imported)
+					continue;
+				if (resource.type == ResourceType::Texture)
+					m_tracker.unregisterImage(resource.image);
+				else
+					m_tracker.unregisterBuffer(resource.bufferRef);
+			}
+
+			return submissions;
+		}
+
+		// destroys everything compile() created, the graph can then be changed and compiled again
+		void destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+		{
+			if (!m_compiled)
+				return;
+
+			for (auto& frameSemaphores : m_semaphores)
+				for (auto& semaphore : frameSemaphores)
+					if (semaphore.isSet())
+						semaphore.destroy(functions, device);
+			m_semaphores.clear();
+
+			for (auto& frame : m_transients)
+			{
+				for (size_t i = 0; i < m_resources.size(); ++i)
+				{
+					if (frame.views[i].isSet())
+						frame.views[i].destroy(device, functions);
+					if (frame.images[i].isSet())
+					{
+						m_tracker.unregisterImage(frame.images[i]);
+						frame.images[i].destroy(functions, device);
+					}
+					if (frame.buffers[i].isSet())
+					{
+						m_tracker.unregisterBuffer(frame.buffers[i]);
+						frame.buffers[i].destroy(functions, device);
+					}
+				}
+				for (auto& memory : frame.memories)
+					memory.destroy(functions, device);
+			}
+			m_transients.clear();
+			m_heaps.clear();
+
+			m_order.clear();
+			m_batches.clear();
+			for (auto& pass : m_passes)
+				pass.culled = false;
+			m_compiled = false;
+		}
+
+		// drops all passes and resources, the graph has to be destroyed first
+		void clear()
+		{
+			GRAPHICS_VERIFY(!m_compiled, "Render graph has to be destroyed before it is cleared");
+			m_passes.clear();
+			m_resources.clear();
+		}
+
+		uint32_t getCulledPassCount() const {
+			return static_cast<uint32_t>(std::count_if(m_passes.begin(), m_passes.end(),
+				[](const Pass& pass) { return pass.culled; }));
+		}
+		uint32_t getSubmissionCount() const { return static_cast<uint32_t>(m_batches.size()); };
+		const std::vector<uint32_t>& getExecutionOrder() const { return m_order; };
+		const std::string& getPassName(uint32_t pass) const { return m_passes[pass].name; };
+
+		// memory actually allocated for transient resources of all frames in flight
+		DeviceSize getTransientMemorySize() const {
+			DeviceSize size = 0;
+			for (const auto& heap : m_heaps)
+				size += heap.size;
+			return size * m_transients.size();
+		}
+
+		// memory the transient resources of all frames in flight would need without aliasing
+		DeviceSize getUnaliasedMemorySize() const {
+			DeviceSize size = 0;
+			for (const auto& resource : m_resources)
+				if (resource.heap != s_none)
+					size += resource.size;
+			return size * m_transients.size();
+		}
+
+	private:
+		Resource& getResource(ResourceHandle handle) {
+			GRAPHICS_VERIFY(handle.index < m_resources.size(), "Invalid resource handle");
+			return m_resources[handle.index];
+		}
+
+		const Resource& getResource(ResourceHandle handle) const {
+			GRAPHICS_VERIFY(handle.index < m_resources.size(), "Invalid resource handle");
+			return m_resources[handle.index];
+		}
+
+		ImageRef getImage(const Resource& resource, uint32_t index, uint32_t frameIndex) const {
+			return resource.imported ? resource.image : m_transients[frameIndex].images[index].getReference();
+		}
+
+		BufferRef getBuffer(const Resource& resource, uint32_t index, uint32_t frameIndex) const {
+			return resource.imported ? resource.bufferRef : m_transients[frameIndex].buffers[index].getReference();
+		}
+
+		void requireAccess(Resource& resource, const ResourceUse& use, QueueType queue, uint32_t frameIndex)
+		{
+			uint32_t index = static_cast<uint32_t>(&resource - m_resources.data());
+			bool isTexture = resource.type == ResourceType::Texture;
+			ImageRef image = isTexture ? getImage(resource, index, frameIndex) : ImageRef();
+			BufferRef buffer = isTexture ? BufferRef() : getBuffer(resource, index, frameIndex);
+
+			// the semaphore wait already ordered the other queue's accesses, only the layout carries over
+			if (resource.lastQueue != s_none && resource.lastQueue != static_cast<uint32_t>(queue))
+			{
+				if (isTexture)
+					m_tracker.assumeImage(image, { Flags::PipelineStage::Bits::None,
+						Flags::Access::Bits::None, m_tracker.getLayout(image) });
+				else
+					m_tracker.assumeBuffer(buffer, { Flags::PipelineStage::Bits::None,
+						Flags::Access::Bits::None });
+			}
+
+			// transient contents never survive a frame, the memory may have been used by an aliased resource
+			bool discard = false;
+			if (!resource.imported && !resource.touched)
+			{
+				discard = true;
+				ResourceUse previous{ resource.aliasWaitStages, Flags::Access::Bits::None, ImageLayout::Undefined };
+				if (isTexture)
+					m_tracker.assumeImage(image, previous);
+				else
+					m_tracker.assumeBuffer(buffer, previous);
+			}
+
+			// every pass flushes its barriers before it is recorded and declares one use per resource
+			bool queued = isTexture ? m_tracker.requireImage(image, use, discard) :
+				m_tracker.requireBuffer(buffer, use);
+			GRAPHICS_VERIFY(queued, "Resource use conflicts with a use of the same pass");
+
+			resource.lastQueue = static_cast<uint32_t>(queue);
+			resource.touched = true;
+		}
+
+		// walks the passes backwards and keeps those that have side effects or produce something
+		// a kept pass, an imported resource or an output reads
+		void cullPasses()
+		{
+			std::vector<bool> live(m_resources.size());
+			for (size_t i = 0; i < m_resources.size(); ++i)
+				live[i] = m_resources[i].imported || m_resources[i].output;
+
+			for (size_t i = m_passes.size(); i-- > 0;)
+			{
+				auto& pass = m_passes[i];
+				bool needed = pass.sideEffect || std::any_of(pass.accesses.begin(), pass.accesses.end(),
+					[&](const Access& access) { return access.use.isWrite() && live[access.resource]; });
+				pass.culled = !needed;
+				if (pass.culled)
+					continue;
+
+				// a read and a write of one resource are merged into one access, the read still needs the producer
+				for (const auto& access : pass.accesses)
+					if (access.use.isRead() || m_resources[access.resource].imported)
+						live[access.resource] = true;
+			}
+		}
+
+		// Kahn's algorithm over read after write, write after read and write after write dependencies.
+		// Among the ready passes the earliest declared one on the current queue is preferred,
+		// which keeps the number of submissions and semaphores low.
+		void schedulePasses()
+		{
+			std::vector<std::vector<uint32_t>> dependents(m_passes.size());
+			std::vector<uint32_t> dependencyCount(m_passes.size());
+			std::vector<uint32_t> lastWriter(m_resources.size(), s_none);
+			std::vector<std::vector<uint32_t>> readers(m_resources.size());
+
+			auto addEdge = [&](uint32_t from, uint32_t to) {
+				if (from == s_none || from == to)
+					return;
+				auto& list = dependents[from];
+				if (std::find(list.begin(), list.end(), to) == list.end())
+				{
+					list.push_back(to);
+					++dependencyCount[to];
+				}
+			};
+
+			for (uint32_t pass = 0; pass < m_passes.size(); ++pass)
+			{
+				if (m_passes[pass].culled)
+					continue;
+				for (const auto& access : m_passes[pass].accesses)
+				{
+					addEdge(lastWriter[access.resource], pass);
+					if (access.use.isWrite())
+					{
+						for (auto reader : readers[access.resource])
+							addEdge(reader, pass);
+						readers[access.resource].clear();
+						lastWriter[access.resource] = pass;
+					}
+					else
+						readers[access.resource].push_back(pass);
+				}
+			}
+
+			std::vector<uint32_t> ready;
+			for (uint32_t pass = 0; pass < m_passes.size(); ++pass)
+				if (!m_passes[pass].culled && dependencyCount[pass] == 0)
+					ready.push_back(pass);
+
+			m_order.clear();
+			QueueType currentQueue = QueueType::Graphics;
+			while (!ready.empty())
+			{
+				auto next = std::min_element(ready.begin(), ready.end(), [&](uint32_t left, uint32_t right) {
+					bool leftSame = m_passes[left].queue == currentQueue;
+					bool rightSame = m_passes[right].queue == currentQueue;
+					return leftSame != rightSame ? leftSame : left < right;
+				});
+				uint32_t pass = *next;
+				ready.erase(next);
+
+				m_order.push_back(pass);
+				currentQueue = m_passes[pass].queue;
+				for (auto dependent : dependents[pass])
+					if (--dependencyCount[dependent] == 0)
+						ready.push_back(dependent);
+			}
+		}
+
+		void buildBatches()
+		{
+			m_batches.clear();
+			std::vector<uint32_t> passBatch(m_passes.size(), s_none);
+			for (auto pass : m_order)
+			{
+				if (m_batches.empty() || m_batches.back().queue != m_passes[pass].queue)
+					m_batches.push_back({ m_passes[pass].queue });
+				m_batches.back().passes.push_back(pass);
+				passBatch[pass] = static_cast<uint32_t>(m_batches.size() - 1);
+			}
+
+			// any earlier access on another queue has to be waited for, the latest batch of that queue covers all before it
+			std::vector<uint32_t> lastBatch(m_resources.size(), s_none);
+			for (uint32_t batchIndex = 0; batchIndex < m_batches.size(); ++batchIndex)
+			{
+				auto& batch = m_batches[batchIndex];
+				for (auto pass : batch.passes)
+				{
+					for (const auto& access : m_passes[pass].accesses)
+					{
+						uint32_t previous = lastBatch[access.resource];
+						lastBatch[access.resource] = batchIndex;
+						if (previous != s_none && m_batches[previous].queue != batch.queue)
+							addWait(batchIndex, previous, access.use.stages);
+					}
+				}
+			}
+
+			// final uses are recorded where the resource was used last, the last batch waits for them
+			// so that whoever waits for the last submission sees every resource in its final use
+			uint32_t finalBatch = static_cast<uint32_t>(m_batches.size() - 1);
+			for (uint32_t i = 0; i < m_resources.size() && !m_batches.empty(); ++i)
+			{
+				if (!m_resources[i].imported || !m_resources[i].hasFinalUse)
+					continue;
+				uint32_t batchIndex = lastBatch[i] == s_none ? finalBatch : lastBatch[i];
+				m_batches[batchIndex].finalResources.push_back(i);
+				if (m_batches[batchIndex].queue != m_batches[finalBatch].queue)
+					addWait(finalBatch, batchIndex, Flags::PipelineStage::Bits::AllCommands);
+			}
+
+			// a wait on an access that has no stages of its own, e.g. a pure layout transition
+			for (auto& batch : m_batches)
+				for (auto& stages : batch.waitStages)
+					if (stages == Flags::PipelineStage::Bits::None)
+						stages = Flags::PipelineStage::Bits::TopOfPipe;
+		}
+
+		// the latest batch of a queue covers all earlier ones of it, so one wait per queue is enough
+		void addWait(uint32_t batchIndex, uint32_t waitBatch, Flags::PipelineStage stages)
+		{
+			auto& batch = m_batches[batchIndex];
+			auto it = std::find_if(batch.waitBatches.begin(), batch.waitBatches.end(),
+				[&](uint32_t wait) { return m_batches[wait].queue == m_batches[waitBatch].queue; });
+			if (it == batch.waitBatches.end())
+			{
+				batch.waitBatches.push_back(waitBatch);
+				batch.waitStages.push_back(stages);
+			}
+			else
+			{
+				*it = std::max(*it, waitBatch);
+				batch.waitStages[it - batch.waitBatches.begin()] |= stages;
+			}
+			m_batches[waitBatch].signals = true;
+		}
+
+		void computeLifetimes()
+		{
+			for (uint32_t position = 0; position < m_order.size(); ++position)
+			{
+				const auto& pass = m_passes[m_order[position]];
+				for (const auto& access : pass.accesses)
+				{
+					auto& resource = m_resources[access.resource];
+					resource.firstPosition = std::min(resource.firstPosition, position);
+					resource.lastPosition = std::max(resource.lastPosition, position);
+					resource.queueMask |= 1u << static_cast<uint32_t>(pass.queue);
+					resource.aliasWaitStages |= access.use.stages;
+					if (resource.type == ResourceType::Texture)
+						resource.imageUsage |= getImageUsage(access.use);
+					else
+						resource.bufferUsage |= getBufferUsage(access.use);
+				}
+			}
+		}
+
+		void createTransients(const DeviceFunctionTable& functions, const DeviceRef& device,
+			const PhysicalDeviceMemoryProperties& memoryProperties, uint32_t framesInFlight,
+			std::span<const uint32_t> queueFamilies)
+		{
+			m_transients.resize(framesInFlight);
+			for (auto& frame : m_transients)
+			{
+				frame.images.resize(m_resources.size());
+				frame.views.resize(m_resources.size());
+				frame.buffers.resize(m_resources.size());
+			}
+
+			uint32_t usedQueues = 0;
+			for (const auto& resource : m_resources)
+				usedQueues |= resource.queueMask;
+			bool concurrent = std::popcount(usedQueues) > 1 && queueFamilies.size() > 1;
+			SharingMode sharingMode = concurrent ? SharingMode::Concurrent : SharingMode::Exclusive;
+
+			std::vector<uint32_t> transients;
+			for (uint32_t i = 0; i < m_resources.size(); ++i)
+			{
+				auto& resource = m_resources[i];
+				if (resource.imported || resource.firstPosition == s_none)
+					continue;
+				transients.push_back(i);
+
+				// the copies of all frames are created alike, the first one decides the placement
+				MemoryRequirements requirements;
+				for (auto& frame : m_transients)
+				{
+					if (resource.type == ResourceType::Texture)
+					{
+						const auto& desc = resource.texture;
+						ImageCreateInfo createInfo(ImageType::Image2D, desc.format, Extent3D(Extent2D(desc.width, desc.height), 1),
+							desc.mipLevels, desc.arrayLayers, Flags::SampleCount::Bits::SC1, ImageTiling::Optimal,
+							resource.imageUsage, sharingMode);
+						if (concurrent)
+							createInfo.setQueueFamilyIndices(queueFamilies);
+						frame.images[i].create(functions, device, createInfo);
+						requirements = frame.images[i].getMemoryRequirements(device, functions);
+					}
+					else
+					{
+						BufferCreateInfo createInfo(resource.buffer.size, resource.bufferUsage, sharingMode);
+						if (concurrent)
+							createInfo.setQueueFamilyIndices(queueFamilies);
+						frame.buffers[i].create(functions, device, createInfo);
+						requirements = frame.buffers[i].getMemoryRequirements(functions, device);
+					}
+				}
+				resource.size = requirements.getSize();
+				resource.alignment = requirements.getAlignment();
+				resource.memoryTypeBits = requirements.getMemoryTypeBits();
+			}
+
+			placeTransients(memoryProperties, transients);
+
+			for (auto& frame : m_transients)
+			{
+				frame.memories.resize(m_heaps.size());
+				for (size_t heap = 0; heap < m_heaps.size(); ++heap)
+					frame.memories[heap].create(functions, device, MemoryAllocateInfo(m_heaps[heap].size, m_heaps[heap].memoryType));
+
+				for (auto i : transients)
+				{
+					auto& resource = m_resources[i];
+					auto& memory = frame.memories[resource.heap];
+					if (resource.type == ResourceType::Texture)
+					{
+						const auto& desc = resource.texture;
+						memory.bindImage(functions, device, frame.images[i], resource.offset);
+						frame.views[i].create(device, functions, ImageViewCreateInfo(frame.images[i],
+							desc.arrayLayers > 1 ? ImageViewType::T2DArray : ImageViewType::T2D, desc.format, ComponentMapping(),
+							ImageSubresourceRange(desc.aspect, 0, desc.mipLevels, 0, desc.arrayLayers)));
+						m_tracker.registerImage(frame.images[i], desc.aspect, desc.mipLevels, desc.arrayLayers);
+					}
+					else
+					{
+						memory.bindBuffer(functions, device, frame.buffers[i], resource.offset);
+						m_tracker.registerBuffer(frame.buffers[i], resource.buffer.size);
+					}
+				}
+			}
+		}
+
+		// Greedy placement, largest first: every resource goes to the lowest offset of its heap that does not
+		// overlap a resource alive at the same time. Resources used on different queues never share memory.
+		void placeTransients(const PhysicalDeviceMemoryProperties& memoryProperties, std::vector<uint32_t> transients)
+		{
+			std::sort(transients.begin(), transients.end(), [this](uint32_t left, uint32_t right) {
+				return m_resources[left].size > m_resources[right].size;
+			});
+
+			std::vector<uint32_t> placed;
+			for (auto index : transients)
+			{
+				auto& resource = m_resources[index];
+				uint32_t memoryType = Utility::findMemoryTypeFirstFit(memoryProperties, resource.memoryTypeBits,
+					Flags::MemoryProperty::Bits::DeviceLocal);
+
+				auto heapIt = std::find_if(m_heaps.begin(), m_heaps.end(),
+					[memoryType](const Heap& heap) { return heap.memoryType == memoryType; });
+				if (heapIt == m_heaps.end())
+				{
+					m_heaps.push_back({ memoryType });
+					heapIt = m_heaps.end() - 1;
+				}
+				resource.heap = static_cast<uint32_t>(heapIt - m_heaps.begin());
+
+				auto conflicts = [&](const Resource& other) {
+					if (other.heap != resource.heap)
+						return false;
+					bool sameQueue = other.queueMask == resource.queueMask && std::popcount(other.queueMask) == 1;
+					bool disjoint = other.lastPosition < resource.firstPosition || resource.lastPosition < other.firstPosition;
+					return !(sameQueue && disjoint);
+				};
+
+				// candidate offsets are the start of the heap and the end of every conflicting resource
+				std::vector<DeviceSize> candidates = { 0 };
+				for (auto other : placed)
+					if (conflicts(m_resources[other]))
+						candidates.push_back(m_resources[other].offset + m_resources[other].size);
+				std::sort(candidates.begin(), candidates.end());
+
+				for (auto candidate : candidates)
+				{
+					DeviceSize offset = (candidate + resource.alignment - 1) / resource.alignment * resource.alignment;
+					bool fits = std::none_of(placed.begin(), placed.end(), [&](uint32_t other) {
+						const auto& o = m_resources[other];
+						return conflicts(o) && offset < o.offset + o.size && o.offset < offset + resource.size;
+					});
+					if (fits)
+					{
+						resource.offset = offset;
+						break;
+					}
+				}
+				heapIt->size = std::max(heapIt->size, resource.offset + resource.size);
+				placed.push_back(index);
+			}
+
+			// memory shared with other resources of the frame must wait for all of their stages
+			for (auto index : placed)
+			{
+				auto& resource = m_resources[index];
+				for (auto other : placed)
+				{
+					const auto& o = m_resources[other];
+					if (o.heap == resource.heap && resource.offset < o.offset + o.size && o.offset < resource.offset + resource.size)
+						resource.aliasWaitStages |= o.aliasWaitStages;
+				}
+			}
+		}
+
+		static Flags::ImageUsage getImageUsage(const ResourceUse& use)
+		{
+			switch (use.layout)
+			{
+			case ImageLayout::ColorAttachmentOptimal: return Flags::ImageUsage::Bits::ColorAttachment;
+			case ImageLayout::DepthStencilAttachmentOptimal: return Flags::ImageUsage::Bits::DepthStencilAttachment;
+			case ImageLayout::DepthStencilReadOnlyOptimal:
+				return Flags::ImageUsage::Bits::DepthStencilAttachment | Flags::ImageUsage::Bits::Sampled;
+			case ImageLayout::ShaderReadOnlyOptimal: return Flags::ImageUsage::Bits::Sampled;
+			case ImageLayout::TransferSrcOptimal: return Flags::ImageUsage::Bits::TransferSrc;
+			case ImageLayout::TransferDstOptimal: return Flags::ImageUsage::Bits::TransferDst;
+			case ImageLayout::General: return Flags::ImageUsage::Bits::Storage;
+			default: return Flags::ImageUsage::Bits::None;
+			}
+		}
+
+		static Flags::BufferUsage getBufferUsage(const ResourceUse& use)
+		{
+			Flags::BufferUsage usage;
+			if (use.access.hasFlag(Flags::Access::Bits::VertexAttributeRead))
+				usage |= Flags::BufferUsage::Bits::VertexBuffer;
+			if (use.access.hasFlag(Flags::Access::Bits::IndexRead))
+				usage |= Flags::BufferUsage::Bits::IndexBuffer;
+			if (use.access.hasFlag(Flags::Access::Bits::IndirectCommandRead))
+				usage |= Flags::BufferUsage::Bits::IndirectBuffer;
+			if (use.access.hasFlag(Flags::Access::Bits::UniformRead))
+				usage |= Flags::BufferUsage::Bits::UniformBuffer;
+			if ((use.access & (Flags::Access::Bits::ShaderRead | Flags::Access::Bits::ShaderWrite)) != 0)
+				usage |= Flags::BufferUsage::Bits::StorageBuffer;
+			if (use.access.hasFlag(Flags::Access::Bits::TransferRead))
+				usage |= Flags::BufferUsage::Bits::TransferSrc;
+			if (use.access.hasFlag(Flags::Access::Bits::TransferWrite))
+				usage |= Flags::BufferUsage::Bits::TransferDst;
+			return usage;
+		}
+	};
+
+	inline ImageRef PassContext::getImage(ResourceHandle handle) const {
+		return m_graph.getImage(m_graph.getResource(handle), handle.index, m_frameIndex);
+	}
+
+	inline ImageViewRef PassContext::getImageView(ResourceHandle handle) const {
+		const auto& resource = m_graph.getResource(handle);
+		return resource.imported ? resource.view : m_graph.m_transients[m_frameIndex].views[handle.index].getReference();
+	}
+
+	inline BufferRef PassContext::getBuffer(ResourceHandle handle) const {
+		return m_graph.getBuffer(m_graph.getResource(handle), handle.index, m_frameIndex);
+	}
+
+	inline const TextureDesc& PassContext::getTextureDesc(ResourceHandle handle) const {
+		return m_graph.getResource(handle).texture;
+	}
+
+	inline ResourceHandle PassBuilder::createTexture(const std::string& name, const TextureDesc& desc)
+	{
+		Graph::Resource resource;
+		resource.name = name;
+		resource.type = Graph::ResourceType::Texture;
+		resource.texture = desc;
+		m_graph.m_resources.push_back(std::move(resource));
+		return { static_cast<uint32_t>(m_graph.m_resources.size() - 1) };
+	}
+
+	inline ResourceHandle PassBuilder::createBuffer(const std::string& name, const BufferDesc& desc)
+	{
+		Graph::Resource resource;
+		resource.name = name;
+		resource.type = Graph::ResourceType::Buffer;
+		resource.buffer = desc;
+		m_graph.m_resources.push_back(std::move(resource));
+		return { static_cast<uint32_t>(m_graph.m_resources.size() - 1) };
+	}
+
+	inline ResourceHandle PassBuilder::read(ResourceHandle resource, const ResourceUse& use)
+	{
+		GRAPHICS_VERIFY(!use.isWrite(), "Read declared with a writing access");
+		addAccess(resource, use);
+		return resource;
+	}
+
+	inline ResourceHandle PassBuilder::write(ResourceHandle resource, const ResourceUse& use)
+	{
+		GRAPHICS_VERIFY(use.isWrite(), "Write declared without a writing access");
+		addAccess(resource, use);
+		return resource;
+	}
+
+	// the tracker orders uses of one resource only between flushes, a pass has one use per resource
+	inline void PassBuilder::addAccess(ResourceHandle resource, const ResourceUse& use)
+	{
+		const auto& declared = m_graph.getResource(resource);
+		auto& accesses = m_graph.m_passes[m_pass].accesses;
+		auto it = std::find_if(accesses.begin(), accesses.end(),
+			[&](const Graph::Access& access) { return access.resource == resource.index; });
+		if (it == accesses.end())
+		{
+			accesses.push_back({ resource.index, use });
+			return;
+		}
+
+		GRAPHICS_VERIFY(declared.type == Graph::ResourceType::Buffer || it->use.layout == use.layout,
+			"A pass declared one texture in two layouts");
+		it->use.stages |= use.stages;
+		it->use.access |= use.access;
+	}
+
+	inline void PassBuilder::setSideEffect() { m_graph.m_passes[m_pass].sideEffect = true; }
+}
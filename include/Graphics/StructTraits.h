@@ -1698,6 +1698,26 @@ namespace Graphics {
         static constexpr auto s_name = "VkGraphicsPipelineCreateInfo";
     };
 
+    // ComputePipelineCreateInfo
+    template<>
+    struct EnumToStructTraits<StructureType::ComputePipelineCreateInfo> {
+        using Type = vk::ComputePipelineCreateInfo;
+        using CType = VkComputePipelineCreateInfo;
+        static constexpr auto s_name = "VkComputePipelineCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::ComputePipelineCreateInfo> {
+        static constexpr auto s_type = StructureType::ComputePipelineCreateInfo;
+        static constexpr auto s_name = "VkComputePipelineCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkComputePipelineCreateInfo> {
+        static constexpr auto s_type = StructureType::ComputePipelineCreateInfo;
+        static constexpr auto s_name = "VkComputePipelineCreateInfo";
+    };
+
     // PipelineVertexInputStateCreateInfo
     template<>
     struct EnumToStructTraits<StructureType::PipelineVertexInputStateCreateInfo> {
@@ -1938,6 +1958,346 @@ namespace Graphics {
         static constexpr auto s_name = "VkBufferMemoryBarrier";
     };
 
+    // MemoryBarrier2
+    template<>
+    struct EnumToStructTraits<StructureType::MemoryBarrier2> {
+        using Type = vk::MemoryBarrier2;
+        using CType = VkMemoryBarrier2;
+        static constexpr auto s_name = "VkMemoryBarrier2";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::MemoryBarrier2> {
+        static constexpr auto s_type = StructureType::MemoryBarrier2;
+        static constexpr auto s_name = "VkMemoryBarrier2";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkMemoryBarrier2> {
+        static constexpr auto s_type = StructureType::MemoryBarrier2;
+        static constexpr auto s_name = "VkMemoryBarrier2";
+    };
+
+    // BufferMemoryBarrier2
+    template<>
+    struct EnumToStructTraits<StructureType::BufferMemoryBarrier2> {
+        using Type = vk::BufferMemoryBarrier2;
+        using CType = VkBufferMemoryBarrier2;
+        static constexpr auto s_name = "VkBufferMemoryBarrier2";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::BufferMemoryBarrier2> {
+        static constexpr auto s_type = StructureType::BufferMemoryBarrier2;
+        static constexpr auto s_name = "VkBufferMemoryBarrier2";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkBufferMemoryBarrier2> {
+        static constexpr auto s_type = StructureType::BufferMemoryBarrier2;
+        static constexpr auto s_name = "VkBufferMemoryBarrier2";
+    };
+
+    // ImageMemoryBarrier2
+    template<>
+    struct EnumToStructTraits<StructureType::ImageMemoryBarrier2> {
+        using Type = vk::ImageMemoryBarrier2;
+        using CType = VkImageMemoryBarrier2;
+        static constexpr auto s_name = "VkImageMemoryBarrier2";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::ImageMemoryBarrier2> {
+        static constexpr auto s_type = StructureType::ImageMemoryBarrier2;
+        static constexpr auto s_name = "VkImageMemoryBarrier2";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkImageMemoryBarrier2> {
+        static constexpr auto s_type = StructureType::ImageMemoryBarrier2;
+        static constexpr auto s_name = "VkImageMemoryBarrier2";
+    };
+
+    // DependencyInfo
+    template<>
+    struct EnumToStructTraits<StructureType::DependencyInfo> {
+        using Type = vk::DependencyInfo;
+        using CType = VkDependencyInfo;
+        static constexpr auto s_name = "VkDependencyInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::DependencyInfo> {
+        static constexpr auto s_type = StructureType::DependencyInfo;
+        static constexpr auto s_name = "VkDependencyInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkDependencyInfo> {
+        static constexpr auto s_type = StructureType::DependencyInfo;
+        static constexpr auto s_name = "VkDependencyInfo";
+    };
+
+    // SubmitInfo2
+    template<>
+    struct EnumToStructTraits<StructureType::SubmitInfo2> {
+        using Type = vk::SubmitInfo2;
+        using CType = VkSubmitInfo2;
+        static constexpr auto s_name = "VkSubmitInfo2";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::SubmitInfo2> {
+        static constexpr auto s_type = StructureType::SubmitInfo2;
+        static constexpr auto s_name = "VkSubmitInfo2";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkSubmitInfo2> {
+        static constexpr auto s_type = StructureType::SubmitInfo2;
+        static constexpr auto s_name = "VkSubmitInfo2";
+    };
+
+    // SemaphoreSubmitInfo
+    template<>
+    struct EnumToStructTraits<StructureType::SemaphoreSubmitInfo> {
+        using Type = vk::SemaphoreSubmitInfo;
+        using CType = VkSemaphoreSubmitInfo;
+        static constexpr auto s_name = "VkSemaphoreSubmitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::SemaphoreSubmitInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreSubmitInfo;
+        static constexpr auto s_name = "VkSemaphoreSubmitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkSemaphoreSubmitInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreSubmitInfo;
+        static constexpr auto s_name = "VkSemaphoreSubmitInfo";
+    };
+
+    // CommandBufferSubmitInfo
+    template<>
+    struct EnumToStructTraits<StructureType::CommandBufferSubmitInfo> {
+        using Type = vk::CommandBufferSubmitInfo;
+        using CType = VkCommandBufferSubmitInfo;
+        static constexpr auto s_name = "VkCommandBufferSubmitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::CommandBufferSubmitInfo> {
+        static constexpr auto s_type = StructureType::CommandBufferSubmitInfo;
+        static constexpr auto s_name = "VkCommandBufferSubmitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkCommandBufferSubmitInfo> {
+        static constexpr auto s_type = StructureType::CommandBufferSubmitInfo;
+        static constexpr auto s_name = "VkCommandBufferSubmitInfo";
+    };
+
+    // SemaphoreTypeCreateInfo
+    template<>
+    struct EnumToStructTraits<StructureType::SemaphoreTypeCreateInfo> {
+        using Type = vk::SemaphoreTypeCreateInfo;
+        using CType = VkSemaphoreTypeCreateInfo;
+        static constexpr auto s_name = "VkSemaphoreTypeCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::SemaphoreTypeCreateInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreTypeCreateInfo;
+        static constexpr auto s_name = "VkSemaphoreTypeCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkSemaphoreTypeCreateInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreTypeCreateInfo;
+        static constexpr auto s_name = "VkSemaphoreTypeCreateInfo";
+    };
+
+    // TimelineSemaphoreSubmitInfo
+    template<>
+    struct EnumToStructTraits<StructureType::TimelineSemaphoreSubmitInfo> {
+        using Type = vk::TimelineSemaphoreSubmitInfo;
+        using CType = VkTimelineSemaphoreSubmitInfo;
+        static constexpr auto s_name = "VkTimelineSemaphoreSubmitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::TimelineSemaphoreSubmitInfo> {
+        static constexpr auto s_type = StructureType::TimelineSemaphoreSubmitInfo;
+        static constexpr auto s_name = "VkTimelineSemaphoreSubmitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkTimelineSemaphoreSubmitInfo> {
+        static constexpr auto s_type = StructureType::TimelineSemaphoreSubmitInfo;
+        static constexpr auto s_name = "VkTimelineSemaphoreSubmitInfo";
+    };
+
+    // SemaphoreWaitInfo
+    template<>
+    struct EnumToStructTraits<StructureType::SemaphoreWaitInfo> {
+        using Type = vk::SemaphoreWaitInfo;
+        using CType = VkSemaphoreWaitInfo;
+        static constexpr auto s_name = "VkSemaphoreWaitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::SemaphoreWaitInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreWaitInfo;
+        static constexpr auto s_name = "VkSemaphoreWaitInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkSemaphoreWaitInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreWaitInfo;
+        static constexpr auto s_name = "VkSemaphoreWaitInfo";
+    };
+
+    // SemaphoreSignalInfo
+    template<>
+    struct EnumToStructTraits<StructureType::SemaphoreSignalInfo> {
+        using Type = vk::SemaphoreSignalInfo;
+        using CType = VkSemaphoreSignalInfo;
+        static constexpr auto s_name = "VkSemaphoreSignalInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::SemaphoreSignalInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreSignalInfo;
+        static constexpr auto s_name = "VkSemaphoreSignalInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkSemaphoreSignalInfo> {
+        static constexpr auto s_type = StructureType::SemaphoreSignalInfo;
+        static constexpr auto s_name = "VkSemaphoreSignalInfo";
+    };
+
+    // RenderingInfo
+    template<>
+    struct EnumToStructTraits<StructureType::RenderingInfo> {
+        using Type = vk::RenderingInfo;
+        using CType = VkRenderingInfo;
+        static constexpr auto s_name = "VkRenderingInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::RenderingInfo> {
+        static constexpr auto s_type = StructureType::RenderingInfo;
+        static constexpr auto s_name = "VkRenderingInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkRenderingInfo> {
+        static constexpr auto s_type = StructureType::RenderingInfo;
+        static constexpr auto s_name = "VkRenderingInfo";
+    };
+
+    // RenderingAttachmentInfo
+    template<>
+    struct EnumToStructTraits<StructureType::RenderingAttachmentInfo> {
+        using Type = vk::RenderingAttachmentInfo;
+        using CType = VkRenderingAttachmentInfo;
+        static constexpr auto s_name = "VkRenderingAttachmentInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::RenderingAttachmentInfo> {
+        static constexpr auto s_type = StructureType::RenderingAttachmentInfo;
+        static constexpr auto s_name = "VkRenderingAttachmentInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkRenderingAttachmentInfo> {
+        static constexpr auto s_type = StructureType::RenderingAttachmentInfo;
+        static constexpr auto s_name = "VkRenderingAttachmentInfo";
+    };
+
+    // PipelineRenderingCreateInfo
+    template<>
+    struct EnumToStructTraits<StructureType::PipelineRenderingCreateInfo> {
+        using Type = vk::PipelineRenderingCreateInfo;
+        using CType = VkPipelineRenderingCreateInfo;
+        static constexpr auto s_name = "VkPipelineRenderingCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::PipelineRenderingCreateInfo> {
+        static constexpr auto s_type = StructureType::PipelineRenderingCreateInfo;
+        static constexpr auto s_name = "VkPipelineRenderingCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkPipelineRenderingCreateInfo> {
+        static constexpr auto s_type = StructureType::PipelineRenderingCreateInfo;
+        static constexpr auto s_name = "VkPipelineRenderingCreateInfo";
+    };
+
+    // PresentIdKHR
+    template<>
+    struct EnumToStructTraits<StructureType::PresentIdKHR> {
+        using Type = vk::PresentIdKHR;
+        using CType = VkPresentIdKHR;
+        static constexpr auto s_name = "VkPresentIdKHR";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::PresentIdKHR> {
+        static constexpr auto s_type = StructureType::PresentIdKHR;
+        static constexpr auto s_name = "VkPresentIdKHR";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkPresentIdKHR> {
+        static constexpr auto s_type = StructureType::PresentIdKHR;
+        static constexpr auto s_name = "VkPresentIdKHR";
+    };
+
+    // QueryPoolCreateInfo
+    template<>
+    struct EnumToStructTraits<StructureType::QueryPoolCreateInfo> {
+        using Type = vk::QueryPoolCreateInfo;
+        using CType = VkQueryPoolCreateInfo;
+        static constexpr auto s_name = "VkQueryPoolCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::QueryPoolCreateInfo> {
+        static constexpr auto s_type = StructureType::QueryPoolCreateInfo;
+        static constexpr auto s_name = "VkQueryPoolCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkQueryPoolCreateInfo> {
+        static constexpr auto s_type = StructureType::QueryPoolCreateInfo;
+        static constexpr auto s_name = "VkQueryPoolCreateInfo";
+    };
+
+    // PipelineCacheCreateInfo
+    template<>
+    struct EnumToStructTraits<StructureType::PipelineCacheCreateInfo> {
+        using Type = vk::PipelineCacheCreateInfo;
+        using CType = VkPipelineCacheCreateInfo;
+        static constexpr auto s_name = "VkPipelineCacheCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<vk::PipelineCacheCreateInfo> {
+        static constexpr auto s_type = StructureType::PipelineCacheCreateInfo;
+        static constexpr auto s_name = "VkPipelineCacheCreateInfo";
+    };
+
+    template<>
+    struct StructToEnumTraits<VkPipelineCacheCreateInfo> {
+        static constexpr auto s_type = StructureType::PipelineCacheCreateInfo;
+        static constexpr auto s_name = "VkPipelineCacheCreateInfo";
+    };
+
     // RenderPassBeginInfo
     template<>
     struct EnumToStructTraits<StructureType::RenderPassBeginInfo> {
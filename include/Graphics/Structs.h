@@ -136,6 +136,16 @@ namespace Graphics {
         uint32_t firstInstance;
     };
 
+    // same layout as VkDrawIndexedIndirectCommand
+    struct alignas(4) DrawIndexedCommand
+    {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+
     struct Extent2D : public StructBase<VkExtent2D, Extent2D> {
         using Base = StructBase<VkExtent2D, Extent2D>;
     public:
@@ -0,0 +1,293 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Flags.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Fence.h"
+#include "Graphics/HandleTypes/Semaphore.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/HandleTypes/Queue.h"
+#include "Graphics/Utility/MpscQueue.h"
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <span>
+#include <algorithm>
+
+namespace Graphics::Submission
+{
+	// Submission that owns copies of everything a QueueSubmitInfo only points to, so it can cross threads.
+	// Wait and signal values are ignored for binary semaphores.
+	struct SubmitWork
+	{
+		std::vector<CommandBuffer> commandBuffers;
+		std::vector<SemaphoreRef> waitSemaphores;
+		std::vector<Flags::PipelineStage> waitStages;
+		std::vector<uint64_t> waitValues;
+		std::vector<SemaphoreRef> signalSemaphores;
+		std::vector<uint64_t> signalValues;
+		// signaled once this and every submission pushed to the same queue before it finished
+		FenceRef fence;
+
+		SubmitWork() = default;
+
+		// copies the arrays of submitInfo, including the values of a chained TimelineSemaphoreSubmitInfo
+		SubmitWork(const QueueSubmitInfo& submitInfo, const FenceRef& fence = FenceRef()) : fence(fence)
+		{
+			commandBuffers.assign(submitInfo.pCommandBuffers, submitInfo.pCommandBuffers + submitInfo.commandBufferCount);
+			waitSemaphores.assign(submitInfo.pWaitSemaphores, submitInfo.pWaitSemaphores + submitInfo.waitSemaphoreCount);
+			for (uint32_t i = 0; i < submitInfo.waitSemaphoreCount; ++i)
+				waitStages.push_back(Flags::PipelineStage(submitInfo.pWaitDstStageMask[i]));
+			signalSemaphores.assign(submitInfo.pSignalSemaphores, submitInfo.pSignalSemaphores + submitInfo.signalSemaphoreCount);
+
+			waitValues.assign(waitSemaphores.size(), 0);
+			signalValues.assign(signalSemaphores.size(), 0);
+			auto next = static_cast<const VkBaseInStructure*>(submitInfo.pNext);
+			for (; next; next = next->pNext)
+			{
+				if (next->sType != VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO)
+					continue;
+				auto timelineValues = reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(next);
+				if (timelineValues->pWaitSemaphoreValues)
+					waitValues.assign(timelineValues->pWaitSemaphoreValues,
+						timelineValues->pWaitSemaphoreValues + timelineValues->waitSemaphoreValueCount);
+				if (timelineValues->pSignalSemaphoreValues)
+					signalValues.assign(timelineValues->pSignalSemaphoreValues,
+						timelineValues->pSignalSemaphoreValues + timelineValues->signalSemaphoreValueCount);
+				break;
+			}
+		}
+
+		bool hasTimelineValues() const
+		{
+			auto nonZero = [](uint64_t value) { return value != 0; };
+			return std::any_of(waitValues.begin(), waitValues.end(), nonZero) ||
+				std::any_of(signalValues.begin(), signalValues.end(), nonZero);
+		}
+	};
+
+	struct SubmissionStatistics
+	{
+		// submissions pushed by producers and vkQueueSubmit calls made for them
+		uint64_t submissionCount = 0;
+		uint64_t submitCallCount = 0;
+		// time between push and the vkQueueSubmit call that contained the submission
+		std::chrono::nanoseconds totalLatency{ 0 };
+		std::chrono::nanoseconds maxLatency{ 0 };
+
+		std::chrono::nanoseconds getAverageLatency() const {
+			return submissionCount == 0 ? std::chrono::nanoseconds(0) : totalLatency / submissionCount;
+		}
+	};
+
+	// Owns the only thread that calls vkQueueSubmit for the registered queues, so producers need no external locking.
+	// Every wake up drains the MPSC queue and submits everything pending for a queue with one vkQueueSubmit,
+	// keeping push order so semaphore waits and signals behave as if the submissions were made one by one.
+	// A batch is split after a submission with a fence because vkQueueSubmit takes a single fence,
+	// and before a submission that waits on semaphores so signals on other queues are submitted first.
+	class SubmissionThread
+	{
+		struct Entry {
+			uint32_t queueIndex;
+			SubmitWork work;
+			std::chrono::steady_clock::time_point pushTime;
+			// set for flush markers, which carry no work
+			std::atomic<bool>* done = nullptr;
+		};
+
+		const DeviceFunctionTable* m_functions = nullptr;
+		std::vector<Queue> m_queues;
+		Utility::MpscQueue<Entry> m_pending;
+		std::thread m_thread;
+		std::atomic<uint64_t> m_pushCount = 0;
+		std::atomic<bool> m_stop = false;
+
+		std::atomic<uint64_t> m_submissionCount = 0;
+		std::atomic<uint64_t> m_submitCallCount = 0;
+		std::atomic<int64_t> m_totalLatency = 0;
+		std::atomic<int64_t> m_maxLatency = 0;
+
+		// consumer side storage reused between batches
+		std::vector<Entry> m_entries;
+		// [queue] indices into m_entries waiting for the next submit of that queue
+		std::vector<std::vector<size_t>> m_batches;
+		std::vector<QueueSubmitInfo> m_submitInfos;
+		std::vector<TimelineSemaphoreSubmitInfo> m_timelineInfos;
+
+	public:
+		SubmissionThread() = default;
+
+		SubmissionThread(const SubmissionThread&) = delete;
+		SubmissionThread& operator=(const SubmissionThread&) = delete;
+
+		~SubmissionThread() { GRAPHICS_VERIFY(!m_thread.joinable(), "SubmissionThread was not stopped"); };
+
+		// queue indices used by push are positions in queues, functions have to outlive the thread
+		void start(const DeviceFunctionTable& functions, std::span<const Queue> queues)
+		{
+			GRAPHICS_VERIFY(!m_thread.joinable(), "Trying to start a running SubmissionThread");
+			GRAPHICS_VERIFY(!queues.empty(), "SubmissionThread needs at least one queue");
+
+			m_functions = &functions;
+			m_queues.assign(queues.begin(), queues.end());
+			m_batches.assign(queues.size(), {});
+			m_stop = false;
+			m_thread = std::thread([this] { run(); });
+		}
+
+		// submits everything still pending and joins the thread
+		void stop()
+		{
+			if (!m_thread.joinable())
+				return;
+
+			m_stop = true;
+			wake();
+			m_thread.join();
+			m_queues.clear();
+			m_functions = nullptr;
+		}
+
+		// callable from any thread, the work is submitted in push order relative to other pushes to the same queue
+		void push(uint32_t queueIndex, SubmitWork&& work)
+		{
+			GRAPHICS_VERIFY(queueIndex < m_queues.size(), "Queue index is out of range");
+			m_pending.push(Entry{ queueIndex, std::move(work), std::chrono::steady_clock::now() });
+			wake();
+		}
+
+		void push(uint32_t queueIndex, const QueueSubmitInfo& submitInfo, const FenceRef& fence = FenceRef())
+		{
+			push(queueIndex, SubmitWork(submitInfo, fence));
+		}
+
+		// blocks until everything the calling thread pushed before has been handed to vkQueueSubmit
+		void flush()
+		{
+			GRAPHICS_VERIFY(m_thread.joinable(), "SubmissionThread is not running");
+			std::atomic<bool> done = false;
+			m_pending.push(Entry{ 0, SubmitWork(), std::chrono::steady_clock::now(), &done });
+			wake();
+			done.wait(false);
+		}
+
+		SubmissionStatistics getStatistics() const
+		{
+			SubmissionStatistics statistics;
+			statistics.submissionCount = m_submissionCount.load(std::memory_order_relaxed);
+			statistics.submitCallCount = m_submitCallCount.load(std::memory_order_relaxed);
+			statistics.totalLatency = std::chrono::nanoseconds(m_totalLatency.load(std::memory_order_relaxed));
+			statistics.maxLatency = std::chrono::nanoseconds(m_maxLatency.load(std::memory_order_relaxed));
+			return statistics;
+		}
+
+		void resetStatistics()
+		{
+			m_submissionCount = 0;
+			m_submitCallCount = 0;
+			m_totalLatency = 0;
+			m_maxLatency = 0;
+		}
+
+		bool isRunning() const { return m_thread.joinable(); };
+
+	private:
+		void wake()
+		{
+			m_pushCount.fetch_add(1, std::memory_order_release);
+			m_pushCount.notify_one();
+		}
+
+		void run()
+		{
+			while (true)
+			{
+				uint64_t seen = m_pushCount.load(std::memory_order_acquire);
+				bool stopping = m_stop.load(std::memory_order_acquire);
+
+				m_entries.clear();
+				if (m_pending.popAll(m_entries) > 0)
+					submitEntries();
+
+				if (stopping && m_pending.isEmpty())
+					break;
+				m_pushCount.wait(seen, std::memory_order_acquire);
+			}
+		}
+
+		void submitEntries()
+		{
+			for (auto& batch : m_batches)
+				batch.clear();
+
+			for (size_t i = 0; i < m_entries.size(); ++i)
+			{
+				const auto& entry = m_entries[i];
+				if (entry.done)
+					continue;
+
+				// a binary semaphore signal has to be submitted before its wait, so whatever other queues
+				// have pending goes out before a submission that waits
+				if (!entry.work.waitSemaphores.empty())
+					for (uint32_t queueIndex = 0; queueIndex < m_batches.size(); ++queueIndex)
+						if (queueIndex != entry.queueIndex)
+							submitBatch(queueIndex, FenceRef());
+
+				m_batches[entry.queueIndex].push_back(i);
+				if (entry.work.fence.isSet())
+					submitBatch(entry.queueIndex, entry.work.fence);
+			}
+			for (uint32_t queueIndex = 0; queueIndex < m_batches.size(); ++queueIndex)
+				submitBatch(queueIndex, FenceRef());
+
+			// markers are released after every submission that was pushed before them
+			for (auto& entry : m_entries)
+			{
+				if (!entry.done)
+					continue;
+				entry.done->store(true, std::memory_order_release);
+				entry.done->notify_all();
+			}
+		}
+
+		// submits the entries collected for the queue with one vkQueueSubmit
+		void submitBatch(uint32_t queueIndex, const FenceRef& fence)
+		{
+			auto& batch = m_batches[queueIndex];
+			if (batch.empty())
+				return;
+
+			m_submitInfos.clear();
+			m_timelineInfos.clear();
+			// reserved up front, submit infos point into the timeline infos
+			m_timelineInfos.reserve(batch.size());
+
+			auto now = std::chrono::steady_clock::now();
+			int64_t totalLatency = 0;
+			int64_t maxLatency = 0;
+			for (size_t i : batch)
+			{
+				const auto& entry = m_entries[i];
+				const auto& work = entry.work;
+				auto& submitInfo = m_submitInfos.emplace_back(std::span<const CommandBuffer>(work.commandBuffers),
+					std::span<const Flags::PipelineStage>(work.waitStages), work.waitSemaphores, work.signalSemaphores);
+				if (work.hasTimelineValues())
+					submitInfo.setTimelineValues(m_timelineInfos.emplace_back(work.waitValues, work.signalValues));
+
+				int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - entry.pushTime).count();
+				totalLatency += latency;
+				maxLatency = std::max(maxLatency, latency);
+			}
+			batch.clear();
+
+			m_queues[queueIndex].submit(*m_functions, m_submitInfos, fence);
+
+			m_submissionCount.fetch_add(m_submitInfos.size(), std::memory_order_relaxed);
+			m_submitCallCount.fetch_add(1, std::memory_order_relaxed);
+			m_totalLatency.fetch_add(totalLatency, std::memory_order_relaxed);
+			if (maxLatency > m_maxLatency.load(std::memory_order_relaxed))
+				m_maxLatency.store(maxLatency, std::memory_order_relaxed);
+		}
+	};
+}
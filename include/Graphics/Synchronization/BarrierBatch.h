@@ -0,0 +1,187 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Memory.h"
+#include "Graphics/HandleTypes/Image.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace Graphics::Synchronization
+{
+	// Collects synchronization2 barriers, each with its own stage masks, and records all of them
+	// with a single vkCmdPipelineBarrier2 call. Global memory barriers with equal masks are recorded once.
+	// Without synchronization2 the batch falls back to one legacy pipelineBarrier with the union of all stages.
+	class BarrierBatch
+	{
+		std::vector<MemoryBarrier2> m_memoryBarriers;
+		std::vector<BufferMemoryBarrier2> m_bufferBarriers;
+		std::vector<ImageMemoryBarrier2> m_imageBarriers;
+		Flags::Dependency m_dependencyFlags;
+
+		uint32_t m_flushCount = 0;
+		uint32_t m_flushedBarrierCount = 0;
+
+	public:
+		BarrierBatch& addMemoryBarrier(Flags::PipelineStage2 srcStages, Flags::Access2 srcAccess,
+			Flags::PipelineStage2 dstStages, Flags::Access2 dstAccess)
+		{
+			MemoryBarrier2 barrier(srcStages, srcAccess, dstStages, dstAccess);
+			bool duplicate = std::any_of(m_memoryBarriers.begin(), m_memoryBarriers.end(), [&](const MemoryBarrier2& other) {
+				return other.srcStageMask == barrier.srcStageMask && other.srcAccessMask == barrier.srcAccessMask &&
+					other.dstStageMask == barrier.dstStageMask && other.dstAccessMask == barrier.dstAccessMask;
+			});
+			if (!duplicate)
+				m_memoryBarriers.push_back(barrier);
+			return *this;
+		}
+
+		BarrierBatch& addBufferBarrier(const BufferMemoryBarrier2& barrier)
+		{
+			m_bufferBarriers.push_back(barrier);
+			return *this;
+		}
+
+		BarrierBatch& addBufferBarrier(const BufferRef& buffer, Flags::PipelineStage2 srcStages, Flags::Access2 srcAccess,
+			Flags::PipelineStage2 dstStages, Flags::Access2 dstAccess,
+			DeviceSize offset = 0, DeviceSize size = MemoryMapping::s_wholeSize)
+		{
+			return addBufferBarrier(BufferMemoryBarrier2(buffer, srcStages, srcAccess, dstStages, dstAccess, offset, size));
+		}
+
+		BarrierBatch& addImageBarrier(const ImageMemoryBarrier2& barrier)
+		{
+			m_imageBarriers.push_back(barrier);
+			return *this;
+		}
+
+		BarrierBatch& addImageBarrier(const ImageRef& image, Flags::PipelineStage2 srcStages, Flags::Access2 srcAccess,
+			Flags::PipelineStage2 dstStages, Flags::Access2 dstAccess, ImageLayout oldLayout, ImageLayout newLayout,
+			const ImageSubresourceRange& range)
+		{
+			return addImageBarrier(ImageMemoryBarrier2(image, srcStages, srcAccess, dstStages, dstAccess,
+				oldLayout, newLayout, range));
+		}
+
+		BarrierBatch& setDependencyFlags(Flags::Dependency flags)
+		{
+			m_dependencyFlags = flags;
+			return *this;
+		}
+
+		bool isEmpty() const { return m_memoryBarriers.empty() && m_bufferBarriers.empty() && m_imageBarriers.empty(); };
+		size_t getBarrierCount() const { return m_memoryBarriers.size() + m_bufferBarriers.size() + m_imageBarriers.size(); };
+
+		// records every collected barrier and clears the batch, does nothing when it is empty
+		void flush(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer)
+		{
+			if (isEmpty())
+				return;
+
+			if (functions.isLoaded<DeviceFunction::CmdPipelineBarrier2KHR>())
+				commandBuffer.pipelineBarrier2(functions,
+					DependencyInfo(m_memoryBarriers, m_bufferBarriers, m_imageBarriers, m_dependencyFlags));
+			else
+				flushLegacy(functions, commandBuffer);
+
+			++m_flushCount;
+			m_flushedBarrierCount += static_cast<uint32_t>(getBarrierCount());
+			clear();
+		}
+
+		// drops the collected barriers without recording them
+		void clear()
+		{
+			m_memoryBarriers.clear();
+			m_bufferBarriers.clear();
+			m_imageBarriers.clear();
+			m_dependencyFlags.clear();
+		}
+
+		uint32_t getFlushCount() const { return m_flushCount; };
+		uint32_t getFlushedBarrierCount() const { return m_flushedBarrierCount; };
+		void resetStatistics() { m_flushCount = 0; m_flushedBarrierCount = 0; };
+
+		// maps synchronization2 stages onto the closest legacy stages, the bits below 32 are identical
+		static Flags::PipelineStage toLegacyStages(Flags::PipelineStage2 stages)
+		{
+			using Stage2 = Flags::PipelineStage2::Bits;
+			using Stage = Flags::PipelineStage::Bits;
+
+			Flags::PipelineStage legacy(static_cast<uint32_t>(static_cast<uint64_t>(stages) & 0xFFFFFFFFull));
+			if ((stages & (Stage2::Copy | Stage2::Resolve | Stage2::Blit | Stage2::Clear)) != 0)
+				legacy |= Stage::Transfer;
+			if ((stages & (Stage2::IndexInput | Stage2::VertexAttributeInput)) != 0)
+				legacy |= Stage::VertexInput;
+			if (stages.hasFlag(Stage2::PreRasterizationShaders))
+				legacy |= Stage::VertexShader | Stage::TessellationControlShader |
+					Stage::TessellationEvaluationShader | Stage::GeometryShader;
+			return legacy;
+		}
+
+		static Flags::Access toLegacyAccess(Flags::Access2 access)
+		{
+			using Access2 = Flags::Access2::Bits;
+
+			Flags::Access legacy(static_cast<uint32_t>(static_cast<uint64_t>(access) & 0xFFFFFFFFull));
+			if ((access & (Access2::ShaderSampledRead | Access2::ShaderStorageRead)) != 0)
+				legacy |= Flags::Access::Bits::ShaderRead;
+			if (access.hasFlag(Access2::ShaderStorageWrite))
+				legacy |= Flags::Access::Bits::ShaderWrite;
+			return legacy;
+		}
+
+	private:
+		void flushLegacy(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer)
+		{
+			Flags::PipelineStage srcStages;
+			Flags::PipelineStage dstStages;
+			auto addStages = [&](const auto& barrier) {
+				srcStages |= toLegacyStages(barrier.srcStageMask);
+				dstStages |= toLegacyStages(barrier.dstStageMask);
+			};
+
+			std::vector<MemoryBarrier> memoryBarriers;
+			memoryBarriers.reserve(m_memoryBarriers.size());
+			for (const auto& barrier : m_memoryBarriers)
+			{
+				addStages(barrier);
+				memoryBarriers.emplace_back(toLegacyAccess(barrier.srcAccessMask), toLegacyAccess(barrier.dstAccessMask));
+			}
+
+			std::vector<BufferMemoryBarrier> bufferBarriers;
+			bufferBarriers.reserve(m_bufferBarriers.size());
+			for (const auto& barrier : m_bufferBarriers)
+			{
+				addStages(barrier);
+				bufferBarriers.emplace_back(BufferRef(barrier.buffer), toLegacyAccess(barrier.srcAccessMask),
+					toLegacyAccess(barrier.dstAccessMask), barrier.srcQueueFamilyIndex, barrier.dstQueueFamilyIndex,
+					barrier.offset, barrier.size);
+			}
+
+			std::vector<ImageMemoryBarrier> imageBarriers;
+			imageBarriers.reserve(m_imageBarriers.size());
+			for (const auto& barrier : m_imageBarriers)
+			{
+				addStages(barrier);
+				imageBarriers.emplace_back(ImageRef(barrier.image), static_cast<ImageLayout>(barrier.oldLayout),
+					static_cast<ImageLayout>(barrier.newLayout), toLegacyAccess(barrier.srcAccessMask),
+					toLegacyAccess(barrier.dstAccessMask), barrier.srcQueueFamilyIndex, barrier.dstQueueFamilyIndex,
+					ImageSubresourceRange(barrier.subresourceRange));
+			}
+
+			// synchronization2 allows empty masks, the legacy call does not
+			if (srcStages == Flags::PipelineStage::Bits::None)
+				srcStages = Flags::PipelineStage::Bits::TopOfPipe;
+			if (dstStages == Flags::PipelineStage::Bits::None)
+				dstStages = Flags::PipelineStage::Bits::BottomOfPipe;
+
+			commandBuffer.pipelineBarrier(functions, srcStages, dstStages, m_dependencyFlags,
+				memoryBarriers, bufferBarriers, imageBarriers);
+		}
+	};
+}
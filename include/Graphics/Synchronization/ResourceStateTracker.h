@@ -0,0 +1,517 @@
+#pragma once
+#include "Graphics/Common.h"
+#include "Graphics/Structs.h"
+#include "Graphics/Enums.h"
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/HandleTypes/Buffer.h"
+#include "Graphics/HandleTypes/Image.h"
+#include "Graphics/HandleTypes/CommandBuffer.h"
+
+#include <vector>
+#include <span>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+
+namespace Graphics::Synchronization
+{
+	// how a resource is going to be accessed, layout is ignored for buffers
+	struct ResourceUse
+	{
+		Flags::PipelineStage stages;
+		Flags::Access access;
+		ImageLayout layout = ImageLayout::Undefined;
+
+		static constexpr Flags::Access s_writeAccess = Flags::Access::Bits::ShaderWrite
+			| Flags::Access::Bits::ColorAttachmentWrite | Flags::Access::Bits::DepthStencilAttachmentWrite
+			| Flags::Access::Bits::TransferWrite | Flags::Access::Bits::HostWrite | Flags::Access::Bits::MemoryWrite
+			| Flags::Access::Bits::TransformFeedbackWriteEXT | Flags::Access::Bits::TransformFeedbackCounterWriteEXT
+			| Flags::Access::Bits::AccelerationStructureWriteKHR;
+
+		bool isWrite() const { return (access & s_writeAccess) != 0; };
+		// also true for uses that read and write, e.g. a depth attachment that is loaded
+		bool isRead() const {
+			return (static_cast<Flags::Access::StorageType>(access) &
+				~static_cast<Flags::Access::StorageType>(s_writeAccess)) != 0;
+		};
+
+		static constexpr ResourceUse transferRead() {
+			return { Flags::PipelineStage::Bits::Transfer, Flags::Access::Bits::TransferRead, ImageLayout::TransferSrcOptimal };
+		}
+		static constexpr ResourceUse transferWrite() {
+			return { Flags::PipelineStage::Bits::Transfer, Flags::Access::Bits::TransferWrite, ImageLayout::TransferDstOptimal };
+		}
+		static constexpr ResourceUse shaderRead(Flags::PipelineStage stages) {
+			return { stages, Flags::Access::Bits::ShaderRead, ImageLayout::ShaderReadOnlyOptimal };
+		}
+		// storage images and buffers
+		static constexpr ResourceUse shaderReadWrite(Flags::PipelineStage stages) {
+			return { stages, Flags::Access::Bits::ShaderRead | Flags::Access::Bits::ShaderWrite, ImageLayout::General };
+		}
+		static constexpr ResourceUse uniformRead(Flags::PipelineStage stages) {
+			return { stages, Flags::Access::Bits::UniformRead };
+		}
+		static constexpr ResourceUse colorAttachment() {
+			return { Flags::PipelineStage::Bits::ColorAttachmentOutput,
+				Flags::Access::Bits::ColorAttachmentRead | Flags::Access::Bits::ColorAttachmentWrite,
+				ImageLayout::ColorAttachmentOptimal };
+		}
+		static constexpr ResourceUse depthAttachment() {
+			return { Flags::PipelineStage::Bits::EarlyFragmentTests | Flags::PipelineStage::Bits::LateFragmentTests,
+				Flags::Access::Bits::DepthStencilAttachmentRead | Flags::Access::Bits::DepthStencilAttachmentWrite,
+				ImageLayout::DepthStencilAttachmentOptimal };
+		}
+		static constexpr ResourceUse depthRead(Flags::PipelineStage stages) {
+			return { stages, Flags::Access::Bits::ShaderRead, ImageLayout::DepthStencilReadOnlyOptimal };
+		}
+		static constexpr ResourceUse present() {
+			return { Flags::PipelineStage::Bits::BottomOfPipe, Flags::Access::Bits::None, ImageLayout::PresentSrcKHR };
+		}
+		static constexpr ResourceUse vertexBuffer() {
+			return { Flags::PipelineStage::Bits::VertexInput, Flags::Access::Bits::VertexAttributeRead };
+		}
+		static constexpr ResourceUse indexBuffer() {
+			return { Flags::PipelineStage::Bits::VertexInput, Flags::Access::Bits::IndexRead };
+		}
+		static constexpr ResourceUse indirectBuffer() {
+			return { Flags::PipelineStage::Bits::DrawIndirect, Flags::Access::Bits::IndirectCommandRead };
+		}
+		static constexpr ResourceUse hostRead() {
+			return { Flags::PipelineStage::Bits::Host, Flags::Access::Bits::HostRead };
+		}
+	};
+
+	// Remembers layout, last writes and readers since that write for every registered image
+	// subresource and buffer range. require* declares the next use of a resource and queues the
+	// smallest barrier that makes it safe: nothing for read after read, an execution dependency
+	// for write after read and a memory dependency or layout transition otherwise.
+	// Everything queued between two flushes is recorded with a single pipelineBarrier,
+	// uses declared in the same batch are treated as running concurrently after it. Reads of the same
+	// layout can share a batch, any other use of a resource already used in the batch needs the earlier
+	// use to be recorded first, so require* refuses it and the caller has to flush.
+	// The tracker is meant for one command buffer or queue timeline at a time.
+	class ResourceStateTracker
+	{
+		static constexpr uint32_t s_noBarrier = std::numeric_limits<uint32_t>::max();
+
+		struct AccessState {
+			ImageLayout layout = ImageLayout::Undefined;
+			Flags::PipelineStage writeStages;
+			Flags::Access writeAccess;
+			Flags::PipelineStage readStages;
+			Flags::Access readAccess;
+			// batch of the last use and whether a use of that batch wrote
+			uint64_t batch = 0;
+			bool batchWrite = false;
+			// barrier of that batch the state is waiting on
+			uint32_t pendingBarrier = s_noBarrier;
+
+			bool operator==(const AccessState&) const = default;
+		};
+
+		struct ImageData {
+			Flags::ImageAspect aspect;
+			uint32_t mipLevels;
+			uint32_t arrayLayers;
+			// layer major, index = layer * mipLevels + mip
+			std::vector<AccessState> subresources;
+		};
+
+		struct BufferRange {
+			DeviceSize begin;
+			DeviceSize end;
+			AccessState state;
+		};
+
+		struct BufferData {
+			DeviceSize size;
+			// sorted, non overlapping and covering the whole buffer
+			std::vector<BufferRange> ranges;
+		};
+
+		struct Transition {
+			bool needed;
+			bool exclusive;
+			Flags::PipelineStage srcStages;
+			Flags::Access srcAccess;
+		};
+
+		std::unordered_map<VkImage, ImageData> m_images;
+		std::unordered_map<VkBuffer, BufferData> m_buffers;
+
+		std::vector<ImageMemoryBarrier> m_imageBarriers;
+		std::vector<BufferMemoryBarrier> m_bufferBarriers;
+		Flags::PipelineStage m_srcStages;
+		Flags::PipelineStage m_dstStages;
+		uint64_t m_batch = 1;
+
+		uint32_t m_flushCount = 0;
+		uint32_t m_flushedBarrierCount = 0;
+
+	public:
+		void registerImage(const ImageRef& image, Flags::ImageAspect aspect, uint32_t mipLevels = 1,
+			uint32_t arrayLayers = 1, ImageLayout currentLayout = ImageLayout::Undefined)
+		{
+			auto& data = m_images[image.getHandle()];
+			data.aspect = aspect;
+			data.mipLevels = mipLevels;
+			data.arrayLayers = arrayLayers;
+			data.subresources.assign(static_cast<size_t>(mipLevels) * arrayLayers, AccessState{ currentLayout });
+		}
+
+		void registerBuffer(const BufferRef& buffer, DeviceSize size)
+		{
+			auto& data = m_buffers[buffer.getHandle()];
+			data.size = size;
+			data.ranges.assign(1, { 0, size, AccessState{} });
+		}
+
+		void unregisterImage(const ImageRef& image) { m_images.erase(image.getHandle()); };
+		void unregisterBuffer(const BufferRef& buffer) { m_buffers.erase(buffer.getHandle()); };
+
+		bool isRegistered(const ImageRef& image) const { return m_images.contains(image.getHandle()); };
+		bool isRegistered(const BufferRef& buffer) const { return m_buffers.contains(buffer.getHandle()); };
+
+		// declares the next use of a range of subresources, discardContents allows transitioning
+		// from Undefined when the previous contents are not needed anymore.
+		// Returns false and changes nothing when the use has to run after a use declared since the last flush,
+		// e.g. a read after a write, the caller then flushes, records the earlier use and requires again
+		[[nodiscard]] bool requireImage(const ImageRef& image, const ResourceUse& use,
+			const ImageSubresourceRange& range, bool discardContents = false)
+		{
+			auto& data = getImage(image);
+			uint32_t levelCount = range.levelCount == VK_REMAINING_MIP_LEVELS ?
+				data.mipLevels - range.baseMipLevel : range.levelCount;
+			uint32_t layerCount = range.layerCount == VK_REMAINING_ARRAY_LAYERS ?
+				data.arrayLayers - range.baseArrayLayer : range.layerCount;
+			GRAPHICS_VERIFY(range.baseMipLevel + levelCount <= data.mipLevels &&
+				range.baseArrayLayer + layerCount <= data.arrayLayers, "Subresource range is out of bounds");
+
+			for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + layerCount; ++layer)
+				for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + levelCount; ++mip)
+					if (conflicts(data.subresources[static_cast<size_t>(layer) * data.mipLevels + mip], use, true))
+						return false;
+
+			size_t firstBarrier = m_imageBarriers.size();
+			for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + layerCount; ++layer)
+			{
+				for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + levelCount; ++mip)
+				{
+					auto& state = data.subresources[static_cast<size_t>(layer) * data.mipLevels + mip];
+					auto transition = getTransition(state, use, true);
+					beginUse(state);
+
+					if (transition.needed && state.pendingBarrier != s_noBarrier)
+						mergeInto(m_imageBarriers[state.pendingBarrier], use);
+					else if (transition.needed)
+					{
+						ImageLayout oldLayout = discardContents ? ImageLayout::Undefined : state.layout;
+						state.pendingBarrier = appendImageBarrier(image, data.aspect, firstBarrier,
+							oldLayout, use, transition, mip, layer);
+						m_srcStages |= transition.srcStages;
+						m_dstStages |= use.stages;
+					}
+					apply(state, use, transition);
+				}
+			}
+
+			mergeLayers(data, firstBarrier);
+			return true;
+		}
+
+		[[nodiscard]] bool requireImage(const ImageRef& image, const ResourceUse& use, bool discardContents = false)
+		{
+			const auto& data = getImage(image);
+			return requireImage(image, use, ImageSubresourceRange(data.aspect, 0, data.mipLevels, 0, data.arrayLayers),
+				discardContents);
+		}
+
+		// same as requireImage, returns false when the use has to run after a use declared since the last flush
+		[[nodiscard]] bool requireBuffer(const BufferRef& buffer, const ResourceUse& use,
+			DeviceSize offset = 0, DeviceSize size = VK_WHOLE_SIZE)
+		{
+			auto& data = getBuffer(buffer);
+			DeviceSize end = size == VK_WHOLE_SIZE ? data.size : offset + size;
+			GRAPHICS_VERIFY(offset < end && end <= data.size, "Buffer range is out of bounds");
+
+			for (const auto& range : data.ranges)
+				if (range.end > offset && range.begin < end && conflicts(range.state, use, false))
+					return false;
+
+			splitAt(data, offset);
+			splitAt(data, end);
+
+			for (auto& range : data.ranges)
+			{
+				if (range.end <= offset || range.begin >= end)
+					continue;
+
+				auto& state = range.state;
+				auto transition = getTransition(state, use, false);
+				beginUse(state);
+
+				if (transition.needed && state.pendingBarrier != s_noBarrier)
+					mergeInto(m_bufferBarriers[state.pendingBarrier], use);
+				else if (transition.needed)
+				{
+					state.pendingBarrier = appendBufferBarrier(buffer, use, transition, range.begin, range.end);
+					m_srcStages |= transition.srcStages;
+					m_dstStages |= use.stages;
+				}
+				apply(state, use, transition);
+			}
+
+			coalesce(data);
+			return true;
+		}
+
+		// records every queued barrier with one pipelineBarrier call and starts the next batch,
+		// records nothing when no barrier is queued
+		void flush(const DeviceFunctionTable& functions, CommandBuffer& commandBuffer)
+		{
+			flush([&](Flags::PipelineStage srcStages, Flags::PipelineStage dstStages,
+				std::span<const BufferMemoryBarrier> bufferBarriers, std::span<const ImageMemoryBarrier> imageBarriers) {
+				commandBuffer.pipelineBarrier(functions, srcStages, dstStages, Flags::Dependency::Bits::None,
+					{}, bufferBarriers, imageBarriers);
+			});
+		}
+
+		// hands the queued barriers to record(srcStages, dstStages, bufferBarriers, imageBarriers) instead,
+		// e.g. to record them together with other barriers
+		template<typename Recorder>
+		void flush(Recorder&& record)
+		{
+			// uses of the ending batch are recorded after this point, even when they needed no barrier
+			++m_batch;
+			if (m_imageBarriers.empty() && m_bufferBarriers.empty())
+				return;
+
+			// nothing to wait for, e.g. the first use of a resource
+			Flags::PipelineStage srcStages = m_srcStages == Flags::PipelineStage::Bits::None ?
+				Flags::PipelineStage(Flags::PipelineStage::Bits::TopOfPipe) : m_srcStages;
+			record(srcStages, m_dstStages, std::span<const BufferMemoryBarrier>(m_bufferBarriers),
+				std::span<const ImageMemoryBarrier>(m_imageBarriers));
+
+			++m_flushCount;
+			m_flushedBarrierCount += static_cast<uint32_t>(m_imageBarriers.size() + m_bufferBarriers.size());
+			m_imageBarriers.clear();
+			m_bufferBarriers.clear();
+			m_srcStages.clear();
+			m_dstStages.clear();
+		}
+
+		bool hasPendingBarriers() const { return !m_imageBarriers.empty() || !m_bufferBarriers.empty(); };
+
+		// overrides the tracked state after the resource was changed outside of the tracker,
+		// e.g. by a render pass final layout or a swap chain image acquire
+		void assumeImage(const ImageRef& image, const ResourceUse& use)
+		{
+			for (auto& state : getImage(image).subresources)
+				state = { use.layout, use.stages, use.access & ResourceUse::s_writeAccess, Flags::PipelineStage::Bits::None,
+					Flags::Access::Bits::None };
+		}
+
+		void assumeBuffer(const BufferRef& buffer, const ResourceUse& use)
+		{
+			auto& data = getBuffer(buffer);
+			data.ranges.assign(1, { 0, data.size, AccessState{ ImageLayout::Undefined, use.stages,
+				use.access & ResourceUse::s_writeAccess, Flags::PipelineStage::Bits::None, Flags::Access::Bits::None } });
+		}
+
+		ImageLayout getLayout(const ImageRef& image, uint32_t mipLevel = 0, uint32_t arrayLayer = 0) const
+		{
+			auto it = m_images.find(image.getHandle());
+			GRAPHICS_VERIFY(it != m_images.end(), "Image is not tracked");
+			return it->second.subresources[static_cast<size_t>(arrayLayer) * it->second.mipLevels + mipLevel].layout;
+		}
+
+		uint32_t getFlushCount() const { return m_flushCount; };
+		uint32_t getFlushedBarrierCount() const { return m_flushedBarrierCount; };
+		void resetStatistics() { m_flushCount = 0; m_flushedBarrierCount = 0; };
+
+	private:
+		ImageData& getImage(const ImageRef& image) {
+			auto it = m_images.find(image.getHandle());
+			GRAPHICS_VERIFY(it != m_images.end(), "Image is not tracked");
+			return it->second;
+		}
+
+		BufferData& getBuffer(const BufferRef& buffer) {
+			auto it = m_buffers.find(buffer.getHandle());
+			GRAPHICS_VERIFY(it != m_buffers.end(), "Buffer is not tracked");
+			return it->second;
+		}
+
+		// only reads of the same layout can join a batch that already uses the state
+		bool conflicts(const AccessState& state, const ResourceUse& use, bool isImage) const {
+			return state.batch == m_batch && (state.batchWrite || use.isWrite() || (isImage && state.layout != use.layout));
+		}
+
+		void beginUse(AccessState& state) const
+		{
+			if (state.batch == m_batch)
+				return;
+			state.batch = m_batch;
+			state.batchWrite = false;
+			state.pendingBarrier = s_noBarrier;
+		}
+
+		static Transition getTransition(const AccessState& state, const ResourceUse& use, bool isImage)
+		{
+			bool layoutChange = isImage && state.layout != use.layout;
+			if (layoutChange || use.isWrite())
+			{
+				// write after read only needs the readers to finish, previous writes also have to be made available
+				Flags::PipelineStage srcStages = state.writeStages | state.readStages;
+				return { layoutChange || srcStages != Flags::PipelineStage::Bits::None, true, srcStages, state.writeAccess };
+			}
+
+			// read after read needs nothing, read after write needs the write to be visible to this stage and access
+			bool visible = state.readStages.hasFlags(use.stages) && state.readAccess.hasFlags(use.access);
+			bool needed = state.writeStages != Flags::PipelineStage::Bits::None && !visible;
+			return { needed, false, state.writeStages, state.writeAccess };
+		}
+
+		static void apply(AccessState& state, const ResourceUse& use, const Transition& transition)
+		{
+			state.batchWrite |= use.isWrite();
+			if (!transition.exclusive)
+			{
+				state.readStages |= use.stages;
+				state.readAccess |= use.access;
+				return;
+			}
+
+			state.layout = use.layout;
+			if (use.isWrite())
+			{
+				state.writeStages = use.stages;
+				state.writeAccess = use.access & ResourceUse::s_writeAccess;
+				state.readStages.clear();
+				state.readAccess.clear();
+			}
+			else
+			{
+				// a layout transition counts as a write that is already visible to this use
+				state.writeStages = use.stages;
+				state.writeAccess.clear();
+				state.readStages = use.stages;
+				state.readAccess = use.access;
+			}
+		}
+
+		template<typename Barrier>
+		void mergeInto(Barrier& barrier, const ResourceUse& use)
+		{
+			barrier.dstAccessMask |= static_cast<uint32_t>(use.access);
+			m_dstStages |= use.stages;
+		}
+
+		// extends the previous barrier of the same require call when the mip follows it on the same layer
+		uint32_t appendImageBarrier(const ImageRef& image, Flags::ImageAspect aspect, size_t firstBarrier,
+			ImageLayout oldLayout, const ResourceUse& use, const Transition& transition, uint32_t mip, uint32_t layer)
+		{
+			if (m_imageBarriers.size() > firstBarrier)
+			{
+				auto& last = m_imageBarriers.back();
+				auto& range = last.subresourceRange;
+				if (last.oldLayout == convertCEnum(oldLayout) &&
+					last.srcAccessMask == static_cast<uint32_t>(transition.srcAccess) &&
+					range.baseArrayLayer == layer && range.baseMipLevel + range.levelCount == mip)
+				{
+					++range.levelCount;
+					return static_cast<uint32_t>(m_imageBarriers.size() - 1);
+				}
+			}
+
+			m_imageBarriers.push_back(ImageMemoryBarrier(image, oldLayout, use.layout, transition.srcAccess, use.access,
+				ImageMemoryBarrier::s_queueFamilyIgnored, ImageMemoryBarrier::s_queueFamilyIgnored,
+				ImageSubresourceRange(aspect, mip, 1, layer, 1)));
+			return static_cast<uint32_t>(m_imageBarriers.size() - 1);
+		}
+
+		// joins the per layer barriers of one require call that cover the same mips of consecutive layers
+		// and points the subresources at the remaining barriers
+		void mergeLayers(ImageData& data, size_t firstBarrier)
+		{
+			if (m_imageBarriers.size() - firstBarrier < 2)
+				return;
+
+			size_t write = firstBarrier;
+			for (size_t read = firstBarrier + 1; read < m_imageBarriers.size(); ++read)
+			{
+				auto& target = m_imageBarriers[write];
+				const auto& source = m_imageBarriers[read];
+				auto& targetRange = target.subresourceRange;
+				const auto& sourceRange = source.subresourceRange;
+
+				bool mergeable = target.oldLayout == source.oldLayout && target.srcAccessMask == source.srcAccessMask &&
+					targetRange.baseMipLevel == sourceRange.baseMipLevel && targetRange.levelCount == sourceRange.levelCount &&
+					targetRange.baseArrayLayer + targetRange.layerCount == sourceRange.baseArrayLayer;
+				if (mergeable)
+					targetRange.layerCount += sourceRange.layerCount;
+				else
+					m_imageBarriers[++write] = source;
+			}
+			m_imageBarriers.resize(write + 1);
+
+			for (size_t i = firstBarrier; i < m_imageBarriers.size(); ++i)
+			{
+				const auto& range = m_imageBarriers[i].subresourceRange;
+				for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + range.layerCount; ++layer)
+					for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + range.levelCount; ++mip)
+						data.subresources[static_cast<size_t>(layer) * data.mipLevels + mip].pendingBarrier = static_cast<uint32_t>(i);
+			}
+		}
+
+		uint32_t appendBufferBarrier(const BufferRef& buffer, const ResourceUse& use, const Transition& transition,
+			DeviceSize begin, DeviceSize end)
+		{
+			if (!m_bufferBarriers.empty())
+			{
+				auto& last = m_bufferBarriers.back();
+				if (last.buffer == buffer.getHandle() && last.offset + last.size == begin &&
+					last.srcAccessMask == static_cast<uint32_t>(transition.srcAccess) &&
+					last.dstAccessMask == static_cast<uint32_t>(use.access))
+				{
+					last.size += end - begin;
+					return static_cast<uint32_t>(m_bufferBarriers.size() - 1);
+				}
+			}
+
+			m_bufferBarriers.push_back(BufferMemoryBarrier(buffer, transition.srcAccess, use.access,
+				BufferMemoryBarrier::s_queueFamilyIgnored, BufferMemoryBarrier::s_queueFamilyIgnored, begin, end - begin));
+			return static_cast<uint32_t>(m_bufferBarriers.size() - 1);
+		}
+
+		static void splitAt(BufferData& data, DeviceSize position)
+		{
+			if (position == 0 || position >= data.size)
+				return;
+
+			auto it = std::find_if(data.ranges.begin(), data.ranges.end(),
+				[position](const BufferRange& range) { return range.end > position; });
+			if (it->begin == position)
+				return;
+
+			BufferRange tail = *it;
+			it->end = position;
+			tail.begin = position;
+			data.ranges.insert(it + 1, tail);
+		}
+
+		// merges neighbouring ranges that ended up in the same state to keep the list short
+		static void coalesce(BufferData& data)
+		{
+			size_t write = 0;
+			for (size_t read = 1; read < data.ranges.size(); ++read)
+			{
+				if (data.ranges[write].state == data.ranges[read].state)
+					data.ranges[write].end = data.ranges[read].end;
+				else
+					data.ranges[++write] = data.ranges[read];
+			}
+			data.ranges.resize(write + 1);
+		}
+	};
+}
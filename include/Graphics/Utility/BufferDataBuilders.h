@@ -316,7 +316,7 @@ namespace Graphics::Utility {
         };
     };
 
-    struct VertexDefinitionId : public VertexDefinitionBase<VertexDefinitionModelTransform> {
+    struct VertexDefinitionId : public VertexDefinitionBase<VertexDefinitionId> {
     public:
         using Type = uint32_t;
 
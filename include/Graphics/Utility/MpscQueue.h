@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+namespace Graphics::Utility
+{
+	// Lock free multiple producer single consumer queue. Producers push onto an intrusive stack,
+	// the consumer takes the whole stack at once and reverses it, which restores push order.
+	template<typename T>
+	class MpscQueue
+	{
+		struct Node {
+			T value;
+			Node* next = nullptr;
+		};
+
+		std::atomic<Node*> m_head = nullptr;
+
+	public:
+		MpscQueue() = default;
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		~MpscQueue() { deleteList(m_head.exchange(nullptr)); };
+
+		void push(T&& value)
+		{
+			Node* node = new Node{ std::move(value) };
+			node->next = m_head.load(std::memory_order_relaxed);
+			while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		// appends everything pushed so far to values in push order, only called by the consumer
+		size_t popAll(std::vector<T>& values)
+		{
+			Node* reversed = nullptr;
+			Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+			while (node)
+			{
+				Node* next = node->next;
+				node->next = reversed;
+				reversed = node;
+				node = next;
+			}
+
+			size_t count = 0;
+			while (reversed)
+			{
+				Node* next = reversed->next;
+				values.push_back(std::move(reversed->value));
+				delete reversed;
+				reversed = next;
+				++count;
+			}
+			return count;
+		}
+
+		bool isEmpty() const { return m_head.load(std::memory_order_relaxed) == nullptr; };
+
+	private:
+		static void deleteList(Node* node)
+		{
+			while (node)
+			{
+				Node* next = node->next;
+				delete node;
+				node = next;
+			}
+		}
+	};
+}
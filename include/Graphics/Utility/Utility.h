@@ -6,8 +6,14 @@
 #include "Graphics/HandleTypes/FrameBuffer.h"
 #include "Graphics/HandleTypes/ShaderModule.h"
 #include "Graphics/HandleTypes/CommandBuffer.h"
+#include "Graphics/Synchronization/ResourceStateTracker.h"
 #include "Structs.h"
 
+namespace Graphics::FrameManagement
+{
+    class DeletionQueue;
+}
+
 // Utility functions that abstract some common operations
 namespace Graphics::Utility
 {    
@@ -49,10 +55,14 @@ namespace Graphics::Utility
 	//chooses a swap chain extent based on surface capabilities and desired frame buffer extent
 	Extent2D chooseExtent(const SurfaceCapabilities& capabilities, const Extent2D& frameBufferExtent);
 
+	//the present mode is picked by FrameManagement::FramePacer::choosePresentMode, Fifo unless lowLatency
     RenderPassData createColorDepthRenderPass(const DeviceFunctionTable& deviceFunctions, const DeviceRef& device,
-        std::span<SurfaceFormat> formats, std::span<PresentMode> presentModes, PixelFormat depthFormat);
+        std::span<SurfaceFormat> formats, std::span<PresentMode> presentModes, PixelFormat depthFormat,
+        bool lowLatency = false);
 
 	//creates a basic swap chain with image views and frame buffers, optionally with depth buffer
+	//no frame buffers are created when renderPass is not set, see createDynamicRenderingSwapChain
+	//depthImageUsage can add Sampled to read the depth attachment, e.g. for Culling::HiZOcclusionCuller
     SwapChainData createBasicSwapChain(
         const InstanceFunctionTable& functions,
         const DeviceFunctionTable& deviceFunctions,
@@ -67,14 +77,51 @@ namespace Graphics::Utility
         Flags::ImageUsage preferredImageUsage = Flags::ImageUsage::Bits::ColorAttachment,
         PresentMode preferredPresentMode = PresentMode::Mailbox,
         uint32_t desiredImageCount = 2,
-        uint32_t desiredImageArrayLayerCount = 1);
+        uint32_t desiredImageArrayLayerCount = 1,
+        Flags::ImageUsage depthImageUsage = Flags::ImageUsage::Bits::DepthStencilAttachment);
 
+    // no frame in flight may still use the old images, waiting for the frame fences
+    // (FrameContextManager::waitForAllFrames) is enough, the device does not have to idle
+    // FrameManagement::SwapChainRecreator recreates without waiting and retires the old resources instead
     void recreateBasicSwapChain(SwapChainData& data,
         const DeviceFunctionTable& deviceFunctions,
         const DeviceRef& device,
         const RenderPassRef& renderPass,
         const Extent2D& preferredExtent);
 
+    //rebuilds the image views, depth buffer and frame buffers of data for its current swap chain images
+    //the previous ones are destroyed right away, the caller made sure no frame uses them anymore,
+    //or retired through deletionQueue at retireValue when it is set, see FrameManagement::SwapChainRecreator
+    void recreateSwapChainImageResources(SwapChainData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const RenderPassRef& renderPass,
+        const Extent2D& extent,
+        FrameManagement::DeletionQueue* deletionQueue = nullptr,
+        uint64_t retireValue = 0);
+
+	//swap chain for CommandBuffer::beginRendering, only images, views and the depth buffer are created
+    SwapChainData createDynamicRenderingSwapChain(
+        const InstanceFunctionTable& functions,
+        const DeviceFunctionTable& deviceFunctions,
+        const PhysicalDevice& physicalDevice,
+        const DeviceRef& device,
+        const SurfaceRef& surface,
+        const Extent2D& preferredExtent,
+        PixelFormat preferredFormat = PixelFormat::B8G8R8A8Srgb,
+        PixelFormat preferredDepthFormat = PixelFormat::D32Sfloat,
+        ColorSpace preferredColorSpace = ColorSpace::SrgbNonlinear,
+        Flags::ImageUsage preferredImageUsage = Flags::ImageUsage::Bits::ColorAttachment,
+        PresentMode preferredPresentMode = PresentMode::Mailbox,
+        uint32_t desiredImageCount = 2,
+        uint32_t desiredImageArrayLayerCount = 1,
+        Flags::ImageUsage depthImageUsage = Flags::ImageUsage::Bits::DepthStencilAttachment);
+
+    void recreateDynamicRenderingSwapChain(SwapChainData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const Extent2D& preferredExtent);
+
     void destroySwapChainDaTa(const DeviceFunctionTable& deviceFunctions,
         const DeviceRef& device, SwapChainData& data);
 
@@ -88,6 +135,16 @@ namespace Graphics::Utility
         FrontFace desiredFrontFace, CompareOp depthCompareOp,
         bool depthWriteEnable);
 
+	//pipeline for dynamic rendering, renderingInfo only has to stay alive during the call
+    void createBasicGraphicsPipeline(GraphicsPipelineData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const PipelineRenderingCreateInfo& renderingInfo,
+        PrimitiveTopology desiredTopology,
+        PolygonMode desiredPolygonMode, Flags::CullMode desiredCullMode,
+        FrontFace desiredFrontFace, CompareOp depthCompareOp,
+        bool depthWriteEnable);
+
     ShaderModuleData createShaderModules(const DeviceFunctionTable& deviceFunctions,
         const DeviceRef& device, std::span<const std::string> shaderFilePaths);
 
@@ -103,6 +160,12 @@ namespace Graphics::Utility
         const BufferRef& srcBuffer, const ImageRef& dstImage, const Extent3D& dstExtent,
         ImageLayout srcLayout, ImageLayout dstLayout);
 
+    //copies into mip 0 layer 0 of an image registered with the tracker, overwriting all of its contents.
+    //The transition to finalUse is only queued, it is recorded with the tracker's next flush
+    void copyBufferToImage(const DeviceFunctionTable& deviceFunctions, CommandBuffer& commandBuffer,
+        Synchronization::ResourceStateTracker& tracker, const BufferRef& srcBuffer, const ImageRef& dstImage,
+        const Extent3D& dstExtent, const Synchronization::ResourceUse& finalUse);
+
     void transferData(const DeviceFunctionTable& deviceFunctions, CommandBuffer& commandBuffer,
         const BufferRef& srcBuffer, const BufferRef& dstBuffer, size_t size, size_t srcOffset = 0, size_t dstOffset = 0);
 
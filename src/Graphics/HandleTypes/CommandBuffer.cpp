@@ -11,6 +11,12 @@ namespace Graphics {
 			beginInfo.getUnderlyingPointer(), convertCEnum(subpassContents));
 	}
 
+	void CommandBuffer::beginRendering(const DeviceFunctionTable& functions, const RenderingInfo& renderingInfo)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdBeginRenderingKHR>(getHandle(), renderingInfo.getUnderlyingPointer());
+	}
+
 	void CommandBuffer::bindPipeline(const DeviceFunctionTable& functions, const PipelineRef& pipeline,
 		PipelineBindPoint bindPoint)
 	{
@@ -119,6 +125,32 @@ namespace Graphics {
 			offset, drawCount, stride);
 	}
 
+	void CommandBuffer::drawIndexedIndirect(const DeviceFunctionTable& functions, const BufferRef& buffer,
+		DeviceSize offset, uint32_t drawCount, uint32_t stride /*= sizeof(DrawIndexedCommand)*/)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdDrawIndexedIndirect>(getHandle(), buffer,
+			offset, drawCount, stride);
+	}
+
+	void CommandBuffer::drawIndirectCount(const DeviceFunctionTable& functions, const BufferRef& buffer,
+		DeviceSize offset, const BufferRef& countBuffer, DeviceSize countBufferOffset,
+		uint32_t maxDrawCount, uint32_t stride /*= sizeof(DrawCommand)*/)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdDrawIndirectCountKHR>(getHandle(), buffer,
+			offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+	}
+
+	void CommandBuffer::drawIndexedIndirectCount(const DeviceFunctionTable& functions, const BufferRef& buffer,
+		DeviceSize offset, const BufferRef& countBuffer, DeviceSize countBufferOffset,
+		uint32_t maxDrawCount, uint32_t stride /*= sizeof(DrawIndexedCommand)*/)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdDrawIndexedIndirectCountKHR>(getHandle(), buffer,
+			offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+	}
+
 	void CommandBuffer::dispatch(const DeviceFunctionTable& functions,
 		uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
 	{
@@ -127,12 +159,32 @@ namespace Graphics {
 			groupCountY, groupCountZ);
 	}
 
+	void CommandBuffer::dispatchIndirect(const DeviceFunctionTable& functions,
+		const BufferRef& buffer, DeviceSize offset)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdDispatchIndirect>(getHandle(), buffer, offset);
+	}
+
+	void CommandBuffer::fillBuffer(const DeviceFunctionTable& functions, const BufferRef& dstBuffer,
+		DeviceSize dstOffset, DeviceSize size, uint32_t data)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdFillBuffer>(getHandle(), dstBuffer, dstOffset, size, data);
+	}
+
 	void CommandBuffer::endRenderPass(const DeviceFunctionTable& functions)
 	{
 		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
 		functions.execute<DeviceFunction::CmdEndRenderPass>(getHandle());
 	}
 
+	void CommandBuffer::endRendering(const DeviceFunctionTable& functions)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdEndRenderingKHR>(getHandle());
+	}
+
 	Result CommandBuffer::stopRecord(const DeviceFunctionTable& functions)
 	{
 		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
@@ -190,4 +242,38 @@ namespace Graphics {
 			bufferMemoryBarriers.size(), BufferMemoryBarrier::underlyingCast(bufferMemoryBarriers.data()),
 			imageMemoryBarriers.size(), ImageMemoryBarrier::underlyingCast(imageMemoryBarriers.data()));
 	}
+
+	void CommandBuffer::pipelineBarrier2(const DeviceFunctionTable& functions, const DependencyInfo& dependencyInfo)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdPipelineBarrier2KHR>(getHandle(), DependencyInfo::underlyingCast(&dependencyInfo));
+	}
+
+	void CommandBuffer::beginQuery(const DeviceFunctionTable& functions, const QueryPoolRef& queryPool, uint32_t query,
+		Flags::QueryControl flags)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdBeginQuery>(getHandle(), queryPool.getHandle(), query, flags);
+	}
+
+	void CommandBuffer::endQuery(const DeviceFunctionTable& functions, const QueryPoolRef& queryPool, uint32_t query)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdEndQuery>(getHandle(), queryPool.getHandle(), query);
+	}
+
+	void CommandBuffer::resetQueryPool(const DeviceFunctionTable& functions, const QueryPoolRef& queryPool,
+		uint32_t firstQuery, uint32_t queryCount)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdResetQueryPool>(getHandle(), queryPool.getHandle(), firstQuery, queryCount);
+	}
+
+	void CommandBuffer::writeTimestamp(const DeviceFunctionTable& functions, Flags::PipelineStage::Bits stage,
+		const QueryPoolRef& queryPool, uint32_t query)
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to record an invalid command buffer");
+		functions.execute<DeviceFunction::CmdWriteTimestamp>(getHandle(),
+			static_cast<VkPipelineStageFlagBits>(stage), queryPool.getHandle(), query);
+	}
 }
\ No newline at end of file
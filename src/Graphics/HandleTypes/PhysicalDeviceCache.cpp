@@ -41,6 +41,20 @@ namespace Graphics
 		return SearchResult::unsuitable();
 	}
 
+	const PhysicalDeviceCache::Data* PhysicalDeviceCache::getData(const PhysicalDevice& device) const
+	{
+		auto it = std::find_if(m_data.begin(), m_data.end(),
+			[&](const auto& entry) { return entry.first == device; });
+		return it == m_data.end() ? nullptr : &it->second;
+	}
+
+	PipelineCacheIdentity PhysicalDeviceCache::getPipelineCacheIdentity(const PhysicalDevice& device) const
+	{
+		const Data* data = getData(device);
+		GRAPHICS_VERIFY(data != nullptr, "Physical device is not in the cache");
+		return PipelineCacheIdentity(data->m_properties.get<StructureType::PhysicalDeviceProperties2>().properties);
+	}
+
 	PhysicalDeviceCache::SearchResult PhysicalDeviceCache::getFittingDevice(
 		const DeviceRequirements& requirements) const
 	{
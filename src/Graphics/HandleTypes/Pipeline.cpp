@@ -2,11 +2,11 @@
 
 namespace Graphics {
 	void Pipeline::create(const DeviceFunctionTable& functions,
-		const DeviceRef& device, const PipelineCreateInfo& createInfo)
+		const DeviceRef& device, const PipelineCreateInfo& createInfo, const PipelineCacheRef& cache)
 	{
 		GRAPHICS_VERIFY(!isValid(), "Trying to create a valid pipeline");
 		auto result = functions.execute<DeviceFunction::CreateGraphicsPipelines>(
-			device.getHandle(), VK_NULL_HANDLE, 1,
+			device.getHandle(), cache.getHandle(), 1,
 			createInfo.getUnderlyingPointer(), nullptr, getUnderlyingPointer());
 		GRAPHICS_VERIFY_RESULT(result, "Failed to create a graphics pipeline");
 	}
@@ -18,16 +18,45 @@ namespace Graphics {
 	}
 
 	std::vector<Pipeline> Pipeline::create(const DeviceFunctionTable& functions,
-		const DeviceRef& device, std::span<const PipelineCreateInfo> createInfos)
+		const DeviceRef& device, std::span<const PipelineCreateInfo> createInfos, const PipelineCacheRef& cache)
 	{
 		std::vector<Pipeline> pipelines(createInfos.size());
 		auto result = functions.execute<DeviceFunction::CreateGraphicsPipelines>(
-			device.getHandle(), nullptr, createInfos.size(),
+			device.getHandle(), cache.getHandle(), createInfos.size(),
 			PipelineCreateInfo::underlyingCast(createInfos.data()), nullptr, Pipeline::underlyingCast(pipelines.data()));
 		GRAPHICS_VERIFY_RESULT(result, "Failed to create graphics pipelines");
 		return pipelines;
 	}
 
+	void ComputePipeline::create(const DeviceFunctionTable& functions,
+		const DeviceRef& device, const ComputePipelineCreateInfo& createInfo, const PipelineCacheRef& cache)
+	{
+		GRAPHICS_VERIFY(!isValid(), "Trying to create a valid compute pipeline");
+		auto result = functions.execute<DeviceFunction::CreateComputePipelines>(
+			device.getHandle(), cache.getHandle(), 1,
+			createInfo.getUnderlyingPointer(), nullptr, getUnderlyingPointer());
+		GRAPHICS_VERIFY_RESULT(result, "Failed to create a compute pipeline");
+	}
+
+	void ComputePipeline::destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+	{
+		GRAPHICS_VERIFY(isValid(), "Trying to destroy an invalid compute pipeline");
+		functions.execute<DeviceFunction::DestroyPipeline>(device.getHandle(), getHandle(), nullptr);
+		reset();
+	}
+
+	std::vector<ComputePipeline> ComputePipeline::create(const DeviceFunctionTable& functions,
+		const DeviceRef& device, std::span<const ComputePipelineCreateInfo> createInfos, const PipelineCacheRef& cache)
+	{
+		std::vector<ComputePipeline> pipelines(createInfos.size());
+		auto result = functions.execute<DeviceFunction::CreateComputePipelines>(
+			device.getHandle(), cache.getHandle(), createInfos.size(),
+			ComputePipelineCreateInfo::underlyingCast(createInfos.data()), nullptr,
+			ComputePipeline::underlyingCast(pipelines.data()));
+		GRAPHICS_VERIFY_RESULT(result, "Failed to create compute pipelines");
+		return pipelines;
+	}
+
 	void PipelineLayout::create(const DeviceFunctionTable& functions,
 		const DeviceRef& device, const PipelineLayoutCreateInfo& createInfo)
 	{
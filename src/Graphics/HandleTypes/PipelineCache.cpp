@@ -0,0 +1,164 @@
+#include "Graphics/Graphics.h"
+
+#include <atomic>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// unique per process and call, so concurrent saves to one path never write the same temporary file
+	std::filesystem::path makeTemporaryPath(const std::filesystem::path& path)
+	{
+		static std::atomic<uint64_t> s_counter = 0;
+#ifdef _WIN32
+		auto processId = _getpid();
+#else
+		auto processId = getpid();
+#endif
+		auto temporaryPath = path;
+		temporaryPath += "." + std::to_string(processId) + "." + std::to_string(s_counter.fetch_add(1)) + ".tmp";
+		return temporaryPath;
+	}
+
+	// creates path, fails if it exists, and returns once data reached the disk
+	bool writeDurably(const std::filesystem::path& path, std::span<const uint8_t> data)
+	{
+#ifdef _WIN32
+		std::FILE* file = _wfopen(path.c_str(), L"wbx");
+#else
+		std::FILE* file = std::fopen(path.c_str(), "wbx");
+#endif
+		if (!file)
+			return false;
+		bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size() && std::fflush(file) == 0;
+#ifdef _WIN32
+		written = written && _commit(_fileno(file)) == 0;
+#else
+		written = written && fsync(fileno(file)) == 0;
+#endif
+		return std::fclose(file) == 0 && written;
+	}
+
+	// makes a rename inside directory durable, Windows has no way to sync a directory
+	void syncDirectory([[maybe_unused]] const std::filesystem::path& directory)
+	{
+#ifndef _WIN32
+		int descriptor = open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+		if (descriptor < 0)
+			return;
+		fsync(descriptor);
+		close(descriptor);
+#endif
+	}
+}
+
+namespace Graphics
+{
+	std::vector<uint8_t> PipelineCacheRef::getData(const DeviceFunctionTable& functions, const DeviceRef& device) const
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to get data of an invalid pipeline cache");
+		// the cache can grow between the size query and the copy, which returns VK_INCOMPLETE
+		std::vector<uint8_t> data;
+		VkResult result;
+		do {
+			size_t size = 0;
+			result = functions.execute<DeviceFunction::GetPipelineCacheData>(device.getHandle(), getHandle(), &size, nullptr);
+			GRAPHICS_VERIFY_RESULT(result, "Failed to get pipeline cache data size");
+
+			data.resize(size);
+			result = functions.execute<DeviceFunction::GetPipelineCacheData>(device.getHandle(), getHandle(), &size, data.data());
+			data.resize(size);
+		} while (result == VK_INCOMPLETE);
+		GRAPHICS_VERIFY_RESULT(result, "Failed to get pipeline cache data");
+		return data;
+	}
+
+	void PipelineCacheRef::merge(const DeviceFunctionTable& functions, const DeviceRef& device,
+		std::span<const PipelineCacheRef> sources) const
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to merge into an invalid pipeline cache");
+		if (sources.empty())
+			return;
+		auto result = functions.execute<DeviceFunction::MergePipelineCaches>(device.getHandle(), getHandle(),
+			static_cast<uint32_t>(sources.size()), PipelineCacheRef::underlyingCast(sources.data()));
+		GRAPHICS_VERIFY_RESULT(result, "Failed to merge pipeline caches");
+	}
+
+	bool PipelineCacheRef::saveToFile(const DeviceFunctionTable& functions, const DeviceRef& device,
+		const std::filesystem::path& path) const
+	{
+		auto data = getData(functions, device);
+		auto temporaryPath = makeTemporaryPath(path);
+		std::error_code error;
+		if (!writeDurably(temporaryPath, data))
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+		syncDirectory(path.parent_path());
+		return true;
+	}
+
+	void PipelineCache::create(const DeviceFunctionTable& functions, const DeviceRef& device,
+		const PipelineCacheCreateInfo& createInfo)
+	{
+		GRAPHICS_VERIFY(!isValid(), "Trying to create a valid pipeline cache");
+		auto result = functions.execute<DeviceFunction::CreatePipelineCache>(
+			device.getHandle(), createInfo.getUnderlyingPointer(), nullptr, getUnderlyingPointer());
+		GRAPHICS_VERIFY_RESULT(result, "Failed to create a pipeline cache");
+	}
+
+	void PipelineCache::destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+	{
+		GRAPHICS_VERIFY(isValid(), "Trying to destroy an invalid pipeline cache");
+		functions.execute<DeviceFunction::DestroyPipelineCache>(device.getHandle(), getHandle(), nullptr);
+		reset();
+	}
+
+	bool PipelineCache::createFromFile(const DeviceFunctionTable& functions, const DeviceRef& device,
+		const std::filesystem::path& path, const PipelineCacheIdentity& identity)
+	{
+		std::vector<uint8_t> data;
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (file)
+		{
+			data.resize(static_cast<size_t>(file.tellg()));
+			file.seekg(0);
+			if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+				data.clear();
+		}
+
+		bool compatible = isCompatible(data, identity);
+		create(functions, device, PipelineCacheCreateInfo(compatible ? std::span<const uint8_t>(data) : std::span<const uint8_t>()));
+		return compatible;
+	}
+
+	bool PipelineCache::isCompatible(std::span<const uint8_t> data, const PipelineCacheIdentity& identity)
+	{
+		VkPipelineCacheHeaderVersionOne header;
+		if (data.size() < sizeof(header))
+			return false;
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		PipelineCacheIdentity cached;
+		cached.vendorId = header.vendorID;
+		cached.deviceId = header.deviceID;
+		std::copy(std::begin(header.pipelineCacheUUID), std::end(header.pipelineCacheUUID), cached.pipelineCacheUuid.begin());
+		return header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+			header.headerSize >= sizeof(header) && header.headerSize <= data.size() &&
+			cached == identity;
+	}
+}
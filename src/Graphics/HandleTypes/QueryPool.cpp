@@ -0,0 +1,32 @@
+#include "Graphics/Graphics.h"
+
+namespace Graphics
+{
+	Result QueryPoolRef::getResults(const DeviceFunctionTable& functions, const DeviceRef& device, uint32_t firstQuery,
+		uint32_t queryCount, std::span<uint64_t> data, DeviceSize stride, Flags::QueryResult flags) const
+	{
+		GRAPHICS_VERIFY(isSet(), "Trying to read results of an invalid query pool");
+		GRAPHICS_VERIFY(data.size_bytes() >= stride * queryCount, "Query result buffer is too small");
+		auto result = functions.execute<DeviceFunction::GetQueryPoolResults>(device.getHandle(), getHandle(),
+			firstQuery, queryCount, data.size_bytes(), data.data(), stride, flags);
+		if (result != VK_NOT_READY)
+			GRAPHICS_VERIFY_RESULT(result, "Failed to get query pool results");
+		return convertCEnum(result);
+	}
+
+	void QueryPool::create(const DeviceFunctionTable& functions, const DeviceRef& device,
+		const QueryPoolCreateInfo& createInfo)
+	{
+		GRAPHICS_VERIFY(!isValid(), "Trying to create a valid query pool");
+		auto result = functions.execute<DeviceFunction::CreateQueryPool>(
+			device.getHandle(), createInfo.getUnderlyingPointer(), nullptr, getUnderlyingPointer());
+		GRAPHICS_VERIFY_RESULT(result, "Failed to create a query pool");
+	}
+
+	void QueryPool::destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
+	{
+		GRAPHICS_VERIFY(isValid(), "Trying to destroy an invalid query pool");
+		functions.execute<DeviceFunction::DestroyQueryPool>(device.getHandle(), getHandle(), nullptr);
+		reset();
+	}
+}
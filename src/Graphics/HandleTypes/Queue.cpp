@@ -6,6 +6,7 @@ namespace Graphics
         const QueueSubmitInfo& submitInfo,
         const FenceRef& fence) const
     {
+        GRAPHICS_PROFILE_SCOPE("Queue::submit");
         GRAPHICS_VERIFY(isSet(), "Cannot submit to an unset queue");
         auto result = functions.execute<DeviceFunction::QueueSubmit>(
             getHandle(), 1, QueueSubmitInfo::underlyingCast(&submitInfo),
@@ -17,6 +18,7 @@ namespace Graphics
         std::span<const QueueSubmitInfo> submitInfos,
         const FenceRef& fence) const
     {
+        GRAPHICS_PROFILE_SCOPE("Queue::submit");
         GRAPHICS_VERIFY(isSet(), "Cannot submit to an unset queue");
         auto result = functions.execute<DeviceFunction::QueueSubmit>(
             getHandle(), submitInfos.size(), QueueSubmitInfo::underlyingCast(submitInfos.data()),
@@ -24,8 +26,33 @@ namespace Graphics
         GRAPHICS_VERIFY_RESULT(result, "Failed to submit to queues");
     }
 
+    void Queue::submit2(const DeviceFunctionTable& functions,
+        const QueueSubmitInfo2& submitInfo,
+        const FenceRef& fence) const
+    {
+        GRAPHICS_PROFILE_SCOPE("Queue::submit2");
+        GRAPHICS_VERIFY(isSet(), "Cannot submit to an unset queue");
+        auto result = functions.execute<DeviceFunction::QueueSubmit2KHR>(
+            getHandle(), 1, QueueSubmitInfo2::underlyingCast(&submitInfo),
+            fence.getHandle());
+        GRAPHICS_VERIFY_RESULT(result, "Failed to submit to queues");
+    }
+
+    void Queue::submit2(const DeviceFunctionTable& functions,
+        std::span<const QueueSubmitInfo2> submitInfos,
+        const FenceRef& fence) const
+    {
+        GRAPHICS_PROFILE_SCOPE("Queue::submit2");
+        GRAPHICS_VERIFY(isSet(), "Cannot submit to an unset queue");
+        auto result = functions.execute<DeviceFunction::QueueSubmit2KHR>(
+            getHandle(), static_cast<uint32_t>(submitInfos.size()), QueueSubmitInfo2::underlyingCast(submitInfos.data()),
+            fence.getHandle());
+        GRAPHICS_VERIFY_RESULT(result, "Failed to submit to queues");
+    }
+
     Result Queue::present(const DeviceFunctionTable& functions, const QueuePresentInfo& presentInfo) const
     {
+        GRAPHICS_PROFILE_SCOPE("Queue::present");
         GRAPHICS_VERIFY(isSet(), "Cannot present to an unset queue");
         return convertCEnum(functions.execute<DeviceFunction::QueuePresentKHR>(
             getHandle(), presentInfo.getUnderlyingPointer()));
@@ -11,6 +11,13 @@ namespace Graphics
         GRAPHICS_VERIFY_RESULT(result, "Failed to create a semaphore");
     }
 
+    void Semaphore::createTimeline(const DeviceFunctionTable& functions, const DeviceRef& device,
+        uint64_t initialValue /*= 0*/)
+    {
+        SemaphoreTypeCreateInfo typeInfo(SemaphoreType::Timeline, initialValue);
+        create(functions, device, SemaphoreCreateInfo().setTypeInfo(typeInfo));
+    }
+
     void Semaphore::destroy(const DeviceFunctionTable& functions, const DeviceRef& device)
     {
         GRAPHICS_VERIFY(isValid(), "Trying to destroy an invalid Semaphore");
@@ -18,4 +25,45 @@ namespace Graphics
             (device.getHandle(), getHandle(), nullptr);
         reset();
     }
+
+    bool Semaphore::wait(const DeviceFunctionTable& functions, const DeviceRef& device,
+        std::span<const SemaphoreRef> semaphores, std::span<const uint64_t> values,
+        uint64_t timeout /*= std::numeric_limits<uint64_t>::max()*/, bool waitAll /*= true*/)
+    {
+        GRAPHICS_VERIFY(semaphores.size() == values.size(), "Semaphores and values must have the same size");
+        SemaphoreWaitInfo waitInfo(semaphores, values,
+            waitAll ? Flags::SemaphoreWait::Bits::None : Flags::SemaphoreWait::Bits::Any);
+        auto result = functions.execute<DeviceFunction::WaitSemaphoresKHR>(
+            device.getHandle(), waitInfo.getUnderlyingPointer(), timeout);
+        if (result == VK_TIMEOUT)
+            return false;
+        GRAPHICS_VERIFY_RESULT(result, "Failed to wait for semaphores");
+        return true;
+    }
+
+    uint64_t SemaphoreRef::getCounterValue(const DeviceFunctionTable& functions, const DeviceRef& device) const
+    {
+        GRAPHICS_VERIFY(isSet(), "Trying to query an invalid Semaphore");
+        uint64_t value = 0;
+        auto result = functions.execute<DeviceFunction::GetSemaphoreCounterValueKHR>(
+            device.getHandle(), getHandle(), &value);
+        GRAPHICS_VERIFY_RESULT(result, "Failed to get the semaphore counter value");
+        return value;
+    }
+
+    void SemaphoreRef::signal(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t value) const
+    {
+        GRAPHICS_VERIFY(isSet(), "Trying to signal an invalid Semaphore");
+        SemaphoreSignalInfo signalInfo(*this, value);
+        auto result = functions.execute<DeviceFunction::SignalSemaphoreKHR>(
+            device.getHandle(), signalInfo.getUnderlyingPointer());
+        GRAPHICS_VERIFY_RESULT(result, "Failed to signal the semaphore");
+    }
+
+    bool SemaphoreRef::wait(const DeviceFunctionTable& functions, const DeviceRef& device, uint64_t value,
+        uint64_t timeout /*= std::numeric_limits<uint64_t>::max()*/) const
+    {
+        return Semaphore::wait(functions, device, std::span<const SemaphoreRef>(this, 1),
+            std::span<const uint64_t>(&value, 1), timeout);
+    }
 }
\ No newline at end of file
@@ -51,7 +51,7 @@ namespace Graphics
         }
 
         Flags::ShaderStage::Bits foundStage = Flags::ShaderStage::Bits::None;
-#if defined(_DEBUG) && !defined(GRAPHICS_NO_VERIFY) || defined(GRAPHICS_ALWAYS_VERIFY)
+#if GRAPHICS_VERIFY_LEVEL >= GRAPHICS_VERIFY_LEVEL_FULL
         size_t entryPointCount = 0;
 #endif
 
@@ -62,9 +62,9 @@ namespace Graphics
             uint32_t wordLength = instruction >> 16;      // Word count is in the upper 16 bits
 
             if (opCode == 15) { // OpEntryPoint
-#if defined(_DEBUG) && !defined(GRAPHICS_NO_VERIFY) || defined(GRAPHICS_ALWAYS_VERIFY)
+#if GRAPHICS_VERIFY_LEVEL >= GRAPHICS_VERIFY_LEVEL_FULL
                 entryPointCount++;
-                GRAPHICS_VERIFY(entryPointCount == 1, "Multiple entry points found in SPIR-V module - use separate files for each shader stage");
+                GRAPHICS_VERIFY_FULL(entryPointCount == 1, "Multiple entry points found in SPIR-V module - use separate files for each shader stage");
 #endif
                 if (i + 1 < wordCount) {
                     uint32_t executionModel = words[i + 1];
@@ -82,7 +82,7 @@ namespace Graphics
                     case 5365:  foundStage = Flags::ShaderStage::Bits::MeshEXT; break;
                     default:    foundStage = Flags::ShaderStage::Bits::None; break;
                     }
-#if !defined(_DEBUG) && !defined(GRAPHICS_ALWAYS_VERIFY) || defined(GRAPHICS_NO_VERIFY) 
+#if GRAPHICS_VERIFY_LEVEL < GRAPHICS_VERIFY_LEVEL_FULL
                     return foundStage; // Early return in release mode
 #endif
                 }
@@ -37,6 +37,17 @@ namespace Graphics
         GRAPHICS_VERIFY_RESULT(result, "Failed to create a surface");
     }
 
+    void Surface::createHeadless(const InstanceFunctionTable& functions, const InstanceRef& instance)
+    {
+        GRAPHICS_VERIFY(!isValid(), "Trying to create a valid surface");
+
+        VkHeadlessSurfaceCreateInfoEXT createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+        auto result = functions.execute<InstanceFunction::CreateHeadlessSurfaceEXT>(instance, &createInfo, nullptr, this);
+
+        GRAPHICS_VERIFY_RESULT(result, "Failed to create a headless surface");
+    }
+
     void Surface::destroy(const InstanceFunctionTable& functions, const InstanceRef& instance)
     {
         GRAPHICS_VERIFY(isValid(), "Trying to destroy an invalid surface");
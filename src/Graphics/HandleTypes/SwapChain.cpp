@@ -40,6 +40,25 @@ namespace Graphics {
         *this = std::move(newSwapChain);
     }
 
+    void SwapChain::recreate(const DeviceFunctionTable& functions, const DeviceRef& device,
+        SwapChainCreateInfo& createInfo, SwapChain& retired)
+    {
+        GRAPHICS_VERIFY(!retired.isValid(), "The retired swap chain has to be empty");
+        SwapChain newSwapChain;
+        createInfo.setOldSwapChain(*this);
+        newSwapChain.create(functions, device, createInfo);
+        retired = std::move(*this);
+        *this = std::move(newSwapChain);
+    }
+
+    Result SwapChainRef::waitForPresent(const DeviceFunctionTable& functions, const DeviceRef& device,
+        uint64_t presentId, uint64_t timeout /*= std::numeric_limits<uint64_t>::max()*/) const
+    {
+        GRAPHICS_VERIFY(isSet(), "Trying to wait for a present of an invalid swap chain");
+        return convertCEnum(functions.execute<DeviceFunction::WaitForPresentKHR>(
+            device.getHandle(), getHandle(), presentId, timeout));
+    }
+
     std::vector<ImageRef> SwapChainRef::getImages(const DeviceFunctionTable& functions, const DeviceRef& device) const {
         uint32_t imageCount = 0;
 
@@ -1,4 +1,5 @@
 ﻿#include "Graphics/PlatformManagement/Window.h"
+#include "Graphics/Profiling/CpuProfiler.h"
 
 #ifdef STRICT
 #undef STRICT
@@ -163,6 +164,7 @@ namespace Platform::Win32
     }
 
     void Window::pollEvents() {
+        GRAPHICS_PROFILE_SCOPE("Window::pollEvents");
         MSG msg;
         while (PeekMessage(&msg, reinterpret_cast<HWND>(m_windowHandle), 0, 0, PM_REMOVE)) {
             TranslateMessage(&msg);
@@ -171,6 +173,7 @@ namespace Platform::Win32
     }
 
     void Window::pollEventsGlobal() {
+        GRAPHICS_PROFILE_SCOPE("Window::pollEventsGlobal");
         MSG msg;
         while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
             TranslateMessage(&msg);
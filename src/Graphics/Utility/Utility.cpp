@@ -1,4 +1,6 @@
 #include "Graphics/Utility/Utility.h"
+#include "Graphics/FrameManagement/DeletionQueue.h"
+#include "Graphics/FrameManagement/FramePacer.h"
 
 // Utility functions that abstract some common operations
 namespace Graphics::Utility
@@ -175,7 +177,8 @@ namespace Graphics::Utility
     }
 
     RenderPassData createColorDepthRenderPass(const DeviceFunctionTable& deviceFunctions, const DeviceRef& device,
-        std::span<SurfaceFormat> formats, std::span<PresentMode> presentModes, PixelFormat depthFormat)
+        std::span<SurfaceFormat> formats, std::span<PresentMode> presentModes, PixelFormat depthFormat,
+        bool lowLatency /*= false*/)
     {
         RenderPassData data;
 
@@ -186,13 +189,7 @@ namespace Graphics::Utility
             }
         }
 
-        for (size_t i = 0; i < presentModes.size(); i++) {
-            if (presentModes[i] == PresentMode::Mailbox) {
-                data.presentMode = presentModes[i];
-            }
-        }
-
-
+        data.presentMode = FrameManagement::FramePacer::choosePresentMode(presentModes, lowLatency);
 
         data.attachments.resize(2);
 
@@ -246,6 +243,81 @@ namespace Graphics::Utility
         return data;
     }
 
+    //views of the swap chain images and their frame buffers, the depth view has to exist already
+    static void createSwapChainImageViews(SwapChainData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const RenderPassRef& renderPass,
+        const Extent2D& extent)
+    {
+        uint32_t layerCount = data.swapChainInfo.getImageArrayLayers();
+        data.swapChainImageViews.reserve(data.swapChainImages.size());
+        data.swapChainFrameBuffers.reserve(data.swapChainImages.size());
+        data.swapChainImageViewCreateInfos.reserve(data.swapChainImages.size());
+        data.swapChainFrameBufferCreateInfos.reserve(data.swapChainImages.size());
+        data.attachmentRefs.resize(data.swapChainImages.size());
+
+        for (size_t i = 0; i < data.swapChainImages.size(); ++i)
+        {
+            data.swapChainImageViewCreateInfos.push_back(ImageViewCreateInfo{});
+            data.swapChainImageViewCreateInfos.back().setComponents(ComponentMapping())
+                .setSubresourceRange(ImageSubresourceRange(
+                    Flags::ImageAspect::Bits::Color, 0, 1, 0, layerCount))
+                .setFormat(data.swapChainInfo.getImageFormat())
+                .setViewType(layerCount > 1 ? ImageViewType::T2DArray : ImageViewType::T2D)
+                .setImage(data.swapChainImages[i]);
+            data.swapChainImageViews.push_back(ImageView{});
+            data.swapChainImageViews.back().create(device, deviceFunctions,
+                data.swapChainImageViewCreateInfos.back());
+
+            data.attachmentRefs[i] = { data.swapChainImageViews.back(), data.depthImageView };
+            if (!renderPass.isSet())
+                continue;
+
+            data.swapChainFrameBufferCreateInfos.push_back(FrameBufferCreateInfo{});
+            data.swapChainFrameBufferCreateInfos.back().setRenderPass(renderPass)
+                .setAttachments(data.attachmentRefs[i])
+                .setExtent(extent)
+                .setLayers(layerCount);
+            data.swapChainFrameBuffers.push_back(FrameBuffer{});
+            data.swapChainFrameBuffers.back().create(device, deviceFunctions, data.swapChainFrameBufferCreateInfos.back());
+        }
+    }
+
+    //destroys the frame buffers, image views and depth buffer, or retires them when deletionQueue is set
+    static void releaseSwapChainImageResources(SwapChainData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        FrameManagement::DeletionQueue* deletionQueue,
+        uint64_t retireValue)
+    {
+        if (deletionQueue)
+        {
+            for (auto& framebuffer : data.swapChainFrameBuffers)
+                deletionQueue->enqueue(retireValue, std::move(framebuffer));
+            for (auto& imageView : data.swapChainImageViews)
+                deletionQueue->enqueue(retireValue, std::move(imageView));
+            deletionQueue->enqueue(retireValue, std::move(data.depthImageView));
+            deletionQueue->enqueue(retireValue, std::move(data.depthImage));
+            deletionQueue->enqueue(retireValue, std::move(data.depthImageMemory));
+        }
+        else
+        {
+            for (auto& framebuffer : data.swapChainFrameBuffers)
+                framebuffer.destroy(device, deviceFunctions);
+            for (auto& imageView : data.swapChainImageViews)
+                imageView.destroy(device, deviceFunctions);
+            data.depthImageView.destroy(device, deviceFunctions);
+            data.depthImage.destroy(deviceFunctions, device);
+            data.depthImageMemory.destroy(deviceFunctions, device);
+        }
+        data.swapChainFrameBuffers.clear();
+        data.swapChainFrameBufferCreateInfos.clear();
+        data.swapChainImageViews.clear();
+        data.swapChainImageViewCreateInfos.clear();
+        data.attachmentRefs.clear();
+    }
+
     SwapChainData createBasicSwapChain(
         const InstanceFunctionTable& functions,
         const DeviceFunctionTable& deviceFunctions,
@@ -260,7 +332,8 @@ namespace Graphics::Utility
         Flags::ImageUsage preferredImageUsage /*= Flags::ImageUsage::Bits::ColorAttachment*/,
 		PresentMode preferredPresentMode /*= PresentMode::Mailbox*/,
         uint32_t desiredImageCount /*= 2*/,
-        uint32_t desiredImageArrayLayerCount /*= 1*/)
+        uint32_t desiredImageArrayLayerCount /*= 1*/,
+        Flags::ImageUsage depthImageUsage /*= Flags::ImageUsage::Bits::DepthStencilAttachment*/)
     {
 		SwapChainData swapChainData;
         swapChainData.swapChainInfo.setClipped(true)
@@ -286,7 +359,7 @@ namespace Graphics::Utility
             .setMipLevels(1)
             .setSamples(Flags::SampleCount::Bits::SC1)
             .setTiling(ImageTiling::Optimal)
-            .setUsage(Flags::ImageUsage::Bits::DepthStencilAttachment);
+            .setUsage(depthImageUsage);
 
         swapChainData.depthImage.create(deviceFunctions, device, swapChainData.depthImageCreateInfo);
         auto memRequirements = swapChainData.depthImage.getMemoryRequirements(device, deviceFunctions);
@@ -304,58 +377,44 @@ namespace Graphics::Utility
             .setComponents(ComponentMapping());
         swapChainData.depthImageView.create(device, deviceFunctions, swapChainData.depthImageViewCreateInfo);
 
-        swapChainData.swapChainImageViews.reserve(swapChainData.swapChainImages.size());
-        swapChainData.swapChainFrameBuffers.reserve(swapChainData.swapChainImages.size());
-        swapChainData.swapChainImageViewCreateInfos.reserve(swapChainData.swapChainImages.size());
-        swapChainData.swapChainFrameBufferCreateInfos.reserve(swapChainData.swapChainImages.size());
+        createSwapChainImageViews(swapChainData, deviceFunctions, device, renderPass, preferredExtent);
 
-        swapChainData.attachmentRefs.resize(swapChainData.swapChainImages.size());
+		return swapChainData;
+    }
 
-        for (size_t i = 0; i < swapChainData.swapChainImages.size(); ++i)
-        {
-            swapChainData.swapChainImageViewCreateInfos.push_back(ImageViewCreateInfo{});
-            swapChainData.swapChainImageViewCreateInfos.back().setComponents(ComponentMapping())
-                .setSubresourceRange(ImageSubresourceRange(
-                    Flags::ImageAspect::Bits::Color, 0, 1, 0, desiredImageArrayLayerCount))
-                .setFormat(preferredFormat)
-                .setViewType(desiredImageArrayLayerCount > 1 ? ImageViewType::T2DArray : ImageViewType::T2D)
-                .setImage(swapChainData.swapChainImages[i]);
-
-            swapChainData.swapChainImageViews.push_back(ImageView{});
-            swapChainData.swapChainImageViews.back().create(device, deviceFunctions,
-                swapChainData.swapChainImageViewCreateInfos.back());
-
-            swapChainData.attachmentRefs[i] = { swapChainData.swapChainImageViews.back(), swapChainData.depthImageView };
-            swapChainData.swapChainFrameBufferCreateInfos.push_back(FrameBufferCreateInfo{});
-            swapChainData.swapChainFrameBufferCreateInfos.back().setRenderPass(renderPass)
-                .setAttachments(swapChainData.attachmentRefs[i])
-                .setExtent(preferredExtent)
-                .setLayers(desiredImageArrayLayerCount);
-
-            swapChainData.swapChainFrameBuffers.push_back(FrameBuffer{});
-            swapChainData.swapChainFrameBuffers.back().create(device, deviceFunctions, swapChainData.swapChainFrameBufferCreateInfos.back());
-        }
+    SwapChainData createDynamicRenderingSwapChain(
+        const InstanceFunctionTable& functions,
+        const DeviceFunctionTable& deviceFunctions,
+        const PhysicalDevice& physicalDevice,
+        const DeviceRef& device,
+        const SurfaceRef& surface,
+        const Extent2D& preferredExtent,
+        PixelFormat preferredFormat /*= Format::B8G8R8A8Srgb*/,
+        PixelFormat preferredDepthFormat /*= Format::D32Sfloat*/,
+        ColorSpace preferredColorSpace /*= ColorSpace::SrgbNonlinear*/,
+        Flags::ImageUsage preferredImageUsage /*= Flags::ImageUsage::Bits::ColorAttachment*/,
+        PresentMode preferredPresentMode /*= PresentMode::Mailbox*/,
+        uint32_t desiredImageCount /*= 2*/,
+        uint32_t desiredImageArrayLayerCount /*= 1*/,
+        Flags::ImageUsage depthImageUsage /*= Flags::ImageUsage::Bits::DepthStencilAttachment*/)
+    {
+        return createBasicSwapChain(functions, deviceFunctions, physicalDevice, device, surface, RenderPassRef(),
+            preferredExtent, preferredFormat, preferredDepthFormat, preferredColorSpace, preferredImageUsage,
+            preferredPresentMode, desiredImageCount, desiredImageArrayLayerCount, depthImageUsage);
+    }
 
-		return swapChainData;
+    void recreateDynamicRenderingSwapChain(SwapChainData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const Extent2D& preferredExtent)
+    {
+        recreateBasicSwapChain(data, deviceFunctions, device, RenderPassRef(), preferredExtent);
     }
 
     void destroySwapChainDaTa(const DeviceFunctionTable& deviceFunctions,
         const DeviceRef& device, SwapChainData& data)
     {
-        for (auto& framebuffer : data.swapChainFrameBuffers) {
-            framebuffer.destroy(device, deviceFunctions);
-        }
-        data.swapChainFrameBuffers.clear();
-        data.swapChainFrameBufferCreateInfos.clear();
-        for (auto& imageView : data.swapChainImageViews) {
-            imageView.destroy(device, deviceFunctions);
-        }        
-        data.swapChainImageViews.clear();
-        data.swapChainImageViewCreateInfos.clear();
-        data.attachmentRefs.clear();
-        data.depthImageView.destroy(device, deviceFunctions);
-        data.depthImage.destroy(deviceFunctions, device);
-        data.depthImageMemory.destroy(deviceFunctions, device);
+        releaseSwapChainImageResources(data, deviceFunctions, device, nullptr, 0);
 		data.swapChain.destroy(deviceFunctions, device);
         data.swapChainImages.clear();
     }
@@ -371,60 +430,35 @@ namespace Graphics::Utility
         data.swapChain.recreate(deviceFunctions, device, data.swapChainInfo);
         data.swapChainImages = data.swapChain.getImages(deviceFunctions, device);
 
-        for (auto& framebuffer : data.swapChainFrameBuffers) {
-            framebuffer.destroy(device, deviceFunctions);
-        }
-        data.swapChainFrameBuffers.clear();
-        data.swapChainFrameBufferCreateInfos.clear();
-        for (auto& imageView : data.swapChainImageViews) {
-            imageView.destroy(device, deviceFunctions);
-        }
-        data.swapChainImageViews.clear();
-        data.swapChainImageViewCreateInfos.clear();
-        data.attachmentRefs.clear();
-        data.depthImageView.destroy(device, deviceFunctions);
-        data.depthImage.destroy(deviceFunctions, device);
+        recreateSwapChainImageResources(data, deviceFunctions, device, renderPass, preferredExtent);
+    }
+
+    void recreateSwapChainImageResources(SwapChainData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const RenderPassRef& renderPass,
+        const Extent2D& extent,
+        FrameManagement::DeletionQueue* deletionQueue /*= nullptr*/,
+        uint64_t retireValue /*= 0*/)
+    {
+        releaseSwapChainImageResources(data, deviceFunctions, device, deletionQueue, retireValue);
 
-        data.depthImageCreateInfo.setExtent(Extent3D(preferredExtent, 1));
+        data.depthImageCreateInfo.setExtent(Extent3D(extent, 1));
         data.depthImage.create(deviceFunctions, device, data.depthImageCreateInfo);
 
+        // the memory type index is kept from the initial allocation, only the size changes
+        auto memRequirements = data.depthImage.getMemoryRequirements(device, deviceFunctions);
+        data.depthImageMemoryCreateInfo.setAllocationSize(memRequirements.getSize());
+        data.depthImageMemory.create(deviceFunctions, device, data.depthImageMemoryCreateInfo);
+        data.depthImageMemory.bindImage(deviceFunctions, device, data.depthImage);
+
         data.depthImageViewCreateInfo.setImage(data.depthImage);
         data.depthImageView.create(device, deviceFunctions, data.depthImageViewCreateInfo);
 
-        data.swapChainImageViews.reserve(data.swapChainImages.size());
-        data.swapChainFrameBuffers.reserve(data.swapChainImages.size());
-        data.swapChainImageViewCreateInfos.reserve(data.swapChainImages.size());
-        data.swapChainFrameBufferCreateInfos.reserve(data.swapChainImages.size());
-        data.attachmentRefs.resize(data.swapChainImages.size());
-
-        for (size_t i = 0; i < data.swapChainImages.size(); ++i)
-        {
-            data.swapChainImageViewCreateInfos.push_back(ImageViewCreateInfo{});
-            data.swapChainImageViewCreateInfos.back().setComponents(ComponentMapping())
-                .setSubresourceRange(ImageSubresourceRange(
-                    Flags::ImageAspect::Bits::Color, 0, 1, 0, 1))
-                .setFormat(data.swapChainInfo.getImageFormat())
-                .setViewType(ImageViewType::T2D)
-                .setImage(data.swapChainImages[i]);
-            data.swapChainImageViews.push_back(ImageView{});
-            data.swapChainImageViews.back().create(device, deviceFunctions,
-                data.swapChainImageViewCreateInfos.back());
-            data.attachmentRefs[i] = { data.swapChainImageViews.back(), data.depthImageView };
-            data.swapChainFrameBufferCreateInfos.push_back(FrameBufferCreateInfo{});
-            data.swapChainFrameBufferCreateInfos.back().setRenderPass(renderPass)
-                .setAttachments(data.attachmentRefs[i])
-                .setExtent(preferredExtent)
-                .setLayers(1);
-            data.swapChainFrameBuffers.push_back(FrameBuffer{});
-            data.swapChainFrameBuffers.back().create(device, deviceFunctions, data.swapChainFrameBufferCreateInfos.back());
-		}
+        createSwapChainImageViews(data, deviceFunctions, device, renderPass, extent);
     }
 
-    void createBasicGraphicsPipeline(GraphicsPipelineData& data,
-        const DeviceFunctionTable& deviceFunctions,
-        const DeviceRef& device,
-        const RenderPassRef& renderPass,
-        uint32_t subpassIndex,
+    static void setBasicGraphicsPipelineStates(GraphicsPipelineData& data,
         PrimitiveTopology desiredTopology,
         PolygonMode desiredPolygonMode, Flags::CullMode desiredCullMode,
         FrontFace desiredFrontFace, CompareOp depthCompareOp,
@@ -438,8 +472,6 @@ namespace Graphics::Utility
             Flags::ColorComponent::Bits::B | Flags::ColorComponent::Bits::A));
 
         data.graphicsPipelineInfo.setLayout(data.pipelineLayout)
-            .setRenderPass(renderPass)
-            .setSubpass(subpassIndex)
             .setStages(data.shaderStages)
             .setVertexInputState(PipelineVertexInputStateCreateInfo(data.vertexBindings, data.vertexAttributes))
             .setInputAssemblyState(PipelineInputAssemblyStateCreateInfo(desiredTopology, false))
@@ -453,9 +485,42 @@ namespace Graphics::Utility
                 false, LogicOp::Copy, Color::Empty()))
             .setDepthStencilState(PipelineDepthStencilStateCreateInfo(StencilOpState(), StencilOpState(),
                 depthCompareOp, false, false, depthWriteEnable, 0, 1));
+    }
+
+    void createBasicGraphicsPipeline(GraphicsPipelineData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const RenderPassRef& renderPass,
+        uint32_t subpassIndex,
+        PrimitiveTopology desiredTopology,
+        PolygonMode desiredPolygonMode, Flags::CullMode desiredCullMode,
+        FrontFace desiredFrontFace, CompareOp depthCompareOp,
+        bool depthWriteEnable)
+    {
+        setBasicGraphicsPipelineStates(data, desiredTopology, desiredPolygonMode, desiredCullMode,
+            desiredFrontFace, depthCompareOp, depthWriteEnable);
+        data.graphicsPipelineInfo.setRenderPass(renderPass)
+            .setSubpass(subpassIndex);
         data.graphicsPipeline.create(deviceFunctions, device, data.graphicsPipelineInfo);
     }
 
+    void createBasicGraphicsPipeline(GraphicsPipelineData& data,
+        const DeviceFunctionTable& deviceFunctions,
+        const DeviceRef& device,
+        const PipelineRenderingCreateInfo& renderingInfo,
+        PrimitiveTopology desiredTopology,
+        PolygonMode desiredPolygonMode, Flags::CullMode desiredCullMode,
+        FrontFace desiredFrontFace, CompareOp depthCompareOp,
+        bool depthWriteEnable)
+    {
+        setBasicGraphicsPipelineStates(data, desiredTopology, desiredPolygonMode, desiredCullMode,
+            desiredFrontFace, depthCompareOp, depthWriteEnable);
+        data.graphicsPipelineInfo.setRenderingInfo(renderingInfo);
+        data.graphicsPipeline.create(deviceFunctions, device, data.graphicsPipelineInfo);
+        //renderingInfo may be gone after the call, the stored info must not point at it
+        data.graphicsPipelineInfo.setNext(nullptr);
+    }
+
     ShaderModuleData createShaderModules(const DeviceFunctionTable& deviceFunctions,
         const DeviceRef& device, std::span<const std::string> shaderFilePaths)
     {
@@ -594,6 +659,37 @@ namespace Graphics::Utility
             {}, {}, std::span<ImageMemoryBarrier>(&barrier2, 1));
     }
 
+    void copyBufferToImage(const DeviceFunctionTable& deviceFunctions, CommandBuffer& commandBuffer,
+        Synchronization::ResourceStateTracker& tracker, const BufferRef& srcBuffer, const ImageRef& dstImage,
+        const Extent3D& dstExtent, const Synchronization::ResourceUse& finalUse)
+    {
+        ImageSubresourceRange range(Flags::ImageAspect::Bits::Color, 0, 1, 0, 1);
+        //the image may already be used by barriers queued before, those have to be recorded first
+        if (!tracker.requireImage(dstImage, Synchronization::ResourceUse::transferWrite(), range, true)) {
+            tracker.flush(deviceFunctions, commandBuffer);
+            bool queued = tracker.requireImage(dstImage, Synchronization::ResourceUse::transferWrite(), range, true);
+            GRAPHICS_VERIFY(queued, "Transfer write could not be queued after flushing");
+        }
+        tracker.flush(deviceFunctions, commandBuffer);
+
+        BufferImageCopy copyRegion;
+        copyRegion.setBufferOffset(0)
+            .setBufferRowLength(0)
+            .setBufferImageHeight(0)
+            .setImageSubresource(ImageSubresourceLayers(Flags::ImageAspect::Bits::Color, 0, 0, 1))
+            .setImageOffset({ 0, 0, 0 })
+            .setImageExtent(dstExtent);
+
+        commandBuffer.copyBufferToImage(deviceFunctions,
+            srcBuffer, dstImage,
+            ImageLayout::TransferDstOptimal,
+            std::span<BufferImageCopy>(&copyRegion, 1));
+
+        //the flush before the copy ended the batch of the transfer write, nothing can conflict
+        bool queued = tracker.requireImage(dstImage, finalUse, range);
+        GRAPHICS_VERIFY(queued, "Final use could not be queued after the copy");
+    }
+
     void transferData(const DeviceFunctionTable& deviceFunctions, CommandBuffer& commandBuffer,
         const BufferRef& srcBuffer, const BufferRef& dstBuffer, size_t size, size_t srcOffset /*= 0*/, size_t dstOffset /*= 0*/)
     {
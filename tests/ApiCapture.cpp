@@ -0,0 +1,243 @@
+// Captures calls into a stream and replays them against stub functions returning other handles.
+// Built with GRAPHICS_BUILD_TESTS, no device is needed, handles are never dereferenced.
+#include "Graphics/DeviceFunctionTable.h"
+#include "Graphics/ApiCapture.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+	using Graphics::ApiCapture;
+	using Graphics::DeviceFunction;
+
+	using Test::makeHandle;
+
+	template<typename Handle>
+	uint64_t toValue(Handle handle)
+	{
+		return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+	}
+
+	// handles the stubs create, capture and replay hand out different ones
+	uint64_t g_nextHandle = 0;
+
+	// what the stubs received, copied since the arguments do not outlive the call
+	struct Received {
+		VkDevice device = VK_NULL_HANDLE;
+		VkDeviceSize allocationSize = 0;
+		bool hasFlagsInfo = false;
+		VkMemoryAllocateFlags allocateFlags = 0;
+		VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		std::vector<uint32_t> queueFamilies;
+		VkBuffer boundBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory boundMemory = VK_NULL_HANDLE;
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		VkCommandBuffer copyCommandBuffer = VK_NULL_HANDLE;
+		VkBuffer copySource = VK_NULL_HANDLE;
+		VkBuffer copyDestination = VK_NULL_HANDLE;
+		std::vector<VkBufferCopy> regions;
+	};
+
+	Received g_received;
+
+	VkResult VKAPI_PTR stubAllocateMemory(VkDevice device, const VkMemoryAllocateInfo* info,
+		const VkAllocationCallbacks*, VkDeviceMemory* memory)
+	{
+		g_received.device = device;
+		g_received.allocationSize = info->allocationSize;
+		auto flagsInfo = static_cast<const VkMemoryAllocateFlagsInfo*>(info->pNext);
+		g_received.hasFlagsInfo = flagsInfo && flagsInfo->sType == VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+		g_received.allocateFlags = g_received.hasFlagsInfo ? flagsInfo->flags : 0;
+		*memory = makeHandle<VkDeviceMemory>(g_nextHandle++);
+		return VK_SUCCESS;
+	}
+
+	VkResult VKAPI_PTR stubCreateBuffer(VkDevice, const VkBufferCreateInfo* info,
+		const VkAllocationCallbacks*, VkBuffer* buffer)
+	{
+		g_received.sharingMode = info->sharingMode;
+		g_received.queueFamilies.assign(info->pQueueFamilyIndices,
+			info->pQueueFamilyIndices + info->queueFamilyIndexCount);
+		*buffer = makeHandle<VkBuffer>(g_nextHandle++);
+		return VK_SUCCESS;
+	}
+
+	VkResult VKAPI_PTR stubBindBufferMemory(VkDevice, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize)
+	{
+		g_received.boundBuffer = buffer;
+		g_received.boundMemory = memory;
+		return VK_SUCCESS;
+	}
+
+	VkResult VKAPI_PTR stubAllocateCommandBuffers(VkDevice, const VkCommandBufferAllocateInfo* info,
+		VkCommandBuffer* commandBuffers)
+	{
+		g_received.commandPool = info->commandPool;
+		for (uint32_t i = 0; i < info->commandBufferCount; ++i)
+			commandBuffers[i] = makeHandle<VkCommandBuffer>(g_nextHandle++);
+		return VK_SUCCESS;
+	}
+
+	void VKAPI_PTR stubCmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer source, VkBuffer destination,
+		uint32_t regionCount, const VkBufferCopy* regions)
+	{
+		g_received.copyCommandBuffer = commandBuffer;
+		g_received.copySource = source;
+		g_received.copyDestination = destination;
+		g_received.regions.assign(regions, regions + regionCount);
+	}
+
+	PFN_vkVoidFunction VKAPI_PTR stubGetDeviceProcAddr(VkDevice, const char* name)
+	{
+		if (std::strcmp(name, "vkAllocateMemory") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubAllocateMemory);
+		if (std::strcmp(name, "vkCreateBuffer") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubCreateBuffer);
+		if (std::strcmp(name, "vkBindBufferMemory") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubBindBufferMemory);
+		if (std::strcmp(name, "vkAllocateCommandBuffers") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubAllocateCommandBuffers);
+		if (std::strcmp(name, "vkCmdCopyBuffer") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubCmdCopyBuffer);
+		return nullptr;
+	}
+
+	const VkDevice s_capturedDevice = makeHandle<VkDevice>(0x10);
+	const VkCommandPool s_capturedPool = makeHandle<VkCommandPool>(0x20);
+
+	// records the calls the way DeviceFunctionTable::execute does with GRAPHICS_ENABLE_CAPTURE
+	std::string capture()
+	{
+		std::ostringstream stream(std::ios::binary);
+		ApiCapture::begin(stream);
+		g_nextHandle = 0x100;
+
+		VkMemoryAllocateFlagsInfo flagsInfo{};
+		flagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+		flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+		VkMemoryAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocateInfo.pNext = &flagsInfo;
+		allocateInfo.allocationSize = 4096;
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		ApiCapture::invoke("vkAllocateMemory", &stubAllocateMemory, s_capturedDevice, &allocateInfo, nullptr, &memory);
+
+		uint32_t queueFamilies[] = { 0, 2 };
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = 4096;
+		bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		bufferInfo.queueFamilyIndexCount = 2;
+		bufferInfo.pQueueFamilyIndices = queueFamilies;
+		VkBuffer buffer = VK_NULL_HANDLE;
+		ApiCapture::invoke("vkCreateBuffer", &stubCreateBuffer, s_capturedDevice, &bufferInfo, nullptr, &buffer);
+		ApiCapture::invoke("vkBindBufferMemory", &stubBindBufferMemory, s_capturedDevice, buffer, memory, VkDeviceSize(0));
+
+		VkCommandBufferAllocateInfo commandBufferInfo{};
+		commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferInfo.commandPool = s_capturedPool;
+		commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferInfo.commandBufferCount = 2;
+		VkCommandBuffer commandBuffers[2] = {};
+		ApiCapture::invoke("vkAllocateCommandBuffers", &stubAllocateCommandBuffers, s_capturedDevice,
+			&commandBufferInfo, commandBuffers);
+
+		VkBufferCopy regions[] = { { 0, 2048, 1024 }, { 1024, 3072, 512 } };
+		ApiCapture::invoke("vkCmdCopyBuffer", &stubCmdCopyBuffer, commandBuffers[1], buffer, buffer, 2u, regions);
+
+		// a pNext struct ApiCapture does not know makes the call unsupported instead of replaying it partly
+		VkExternalMemoryBufferCreateInfo externalInfo{};
+		externalInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+		bufferInfo.pNext = &externalInfo;
+		ApiCapture::invoke("vkCreateBuffer", &stubCreateBuffer, s_capturedDevice, &bufferInfo, nullptr, &buffer);
+
+		ApiCapture::end();
+		TEST_CHECK(ApiCapture::getCallCount() == 6);
+		return stream.str();
+	}
+
+	void testRoundTrip()
+	{
+		std::string captured = capture();
+		g_received = {};
+		g_nextHandle = 0x9000;
+
+		Graphics::DeviceFunctionTable functions(&stubGetDeviceProcAddr);
+		functions.loadFunctions<DeviceFunction::AllocateMemory, DeviceFunction::CreateBuffer,
+			DeviceFunction::BindBufferMemory, DeviceFunction::AllocateCommandBuffers,
+			DeviceFunction::CmdCopyBuffer>(VK_NULL_HANDLE);
+
+		const VkDevice replayedDevice = makeHandle<VkDevice>(0x8010);
+		Graphics::ApiReplayer<Graphics::DeviceFunctionTable> replayer(functions);
+		replayer.setDefaultHandle(replayedDevice);
+		replayer.mapHandle(toValue(s_capturedPool), 0x8020);
+		std::vector<uint64_t> created;
+		replayer.setCreateCallback([&](std::string_view, uint64_t handle) { created.push_back(handle); });
+
+		std::istringstream stream(captured, std::ios::binary);
+		TEST_CHECK(replayer.replay(stream));
+
+		const auto& statistics = replayer.getStatistics();
+		TEST_CHECK(statistics.replayedCalls == 5);
+		TEST_CHECK(statistics.unsupportedCalls == 1);
+		TEST_CHECK(statistics.unmappedCalls == 0);
+		TEST_CHECK(statistics.createdHandles == 4);
+		TEST_CHECK((created == std::vector<uint64_t>{ 0x9000, 0x9001, 0x9002, 0x9003 }));
+
+		// create infos arrive deeply, with their pNext chain and arrays
+		TEST_CHECK(g_received.device == replayedDevice);
+		TEST_CHECK(g_received.allocationSize == 4096);
+		TEST_CHECK(g_received.hasFlagsInfo);
+		TEST_CHECK(g_received.allocateFlags == VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT);
+		TEST_CHECK(g_received.sharingMode == VK_SHARING_MODE_CONCURRENT);
+		TEST_CHECK((g_received.queueFamilies == std::vector<uint32_t>{ 0, 2 }));
+		TEST_CHECK(toValue(g_received.commandPool) == 0x8020);
+
+		// later calls use the objects the replay created
+		TEST_CHECK(toValue(g_received.boundMemory) == 0x9000);
+		TEST_CHECK(toValue(g_received.boundBuffer) == 0x9001);
+		TEST_CHECK(toValue(g_received.copyCommandBuffer) == 0x9003);
+		TEST_CHECK(toValue(g_received.copySource) == 0x9001);
+		TEST_CHECK(toValue(g_received.copyDestination) == 0x9001);
+		TEST_CHECK(g_received.regions.size() == 2);
+		if (g_received.regions.size() == 2)
+		{
+			TEST_CHECK(g_received.regions[1].srcOffset == 1024);
+			TEST_CHECK(g_received.regions[1].dstOffset == 3072);
+			TEST_CHECK(g_received.regions[1].size == 512);
+		}
+	}
+
+	// without a mapping for a handle the call is skipped
+	void testUnmappedHandle()
+	{
+		std::string captured = capture();
+		g_received = {};
+		g_nextHandle = 0x9000;
+
+		Graphics::DeviceFunctionTable functions(&stubGetDeviceProcAddr);
+		functions.loadFunctions<DeviceFunction::AllocateCommandBuffers>(VK_NULL_HANDLE);
+
+		Graphics::ApiReplayer<Graphics::DeviceFunctionTable> replayer(functions);
+		replayer.setDefaultHandle(makeHandle<VkDevice>(0x8010));
+		std::istringstream stream(captured, std::ios::binary);
+		TEST_CHECK(replayer.replay(stream));
+
+		// the pool is not mapped and the other functions are not loaded
+		TEST_CHECK(replayer.getStatistics().replayedCalls == 0);
+		TEST_CHECK(replayer.getStatistics().unmappedCalls == 1);
+		TEST_CHECK(replayer.getStatistics().unsupportedCalls == 5);
+		TEST_CHECK(g_received.commandPool == VK_NULL_HANDLE);
+	}
+}
+
+int main()
+{
+	testRoundTrip();
+	testUnmappedHandle();
+	return Test::finish();
+}
@@ -0,0 +1,195 @@
+// Checks which passes RenderGraph::Graph culls when it is compiled.
+// Built with GRAPHICS_BUILD_TESTS, no device is needed, the stubs hand out handles that are never dereferenced.
+#include "Graphics/RenderGraph/RenderGraph.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Graphics::RenderGraph::Graph;
+	using Graphics::RenderGraph::PassBuilder;
+	using Graphics::RenderGraph::PassContext;
+	using Graphics::RenderGraph::QueueType;
+	using Graphics::RenderGraph::ResourceHandle;
+	using Graphics::RenderGraph::ResourceUse;
+	using Graphics::RenderGraph::TextureDesc;
+	using Graphics::DeviceFunction;
+	namespace Flags = Graphics::Flags;
+
+	using Test::makeHandle;
+
+	uint64_t g_nextHandle = 0x100;
+
+	VkResult VKAPI_PTR stubCreateImage(VkDevice, const VkImageCreateInfo*, const VkAllocationCallbacks*, VkImage* image)
+	{
+		*image = makeHandle<VkImage>(g_nextHandle++);
+		return VK_SUCCESS;
+	}
+
+	void VKAPI_PTR stubGetImageMemoryRequirements(VkDevice, VkImage, VkMemoryRequirements* requirements)
+	{
+		requirements->size = 1024;
+		requirements->alignment = 256;
+		requirements->memoryTypeBits = 1;
+	}
+
+	VkResult VKAPI_PTR stubAllocateMemory(VkDevice, const VkMemoryAllocateInfo*, const VkAllocationCallbacks*,
+		VkDeviceMemory* memory)
+	{
+		*memory = makeHandle<VkDeviceMemory>(g_nextHandle++);
+		return VK_SUCCESS;
+	}
+
+	VkResult VKAPI_PTR stubBindImageMemory(VkDevice, VkImage, VkDeviceMemory, VkDeviceSize)
+	{
+		return VK_SUCCESS;
+	}
+
+	VkResult VKAPI_PTR stubCreateImageView(VkDevice, const VkImageViewCreateInfo*, const VkAllocationCallbacks*,
+		VkImageView* view)
+	{
+		*view = makeHandle<VkImageView>(g_nextHandle++);
+		return VK_SUCCESS;
+	}
+
+	void VKAPI_PTR stubDestroyImageView(VkDevice, VkImageView, const VkAllocationCallbacks*) {}
+	void VKAPI_PTR stubDestroyImage(VkDevice, VkImage, const VkAllocationCallbacks*) {}
+	void VKAPI_PTR stubFreeMemory(VkDevice, VkDeviceMemory, const VkAllocationCallbacks*) {}
+
+	PFN_vkVoidFunction VKAPI_PTR stubGetDeviceProcAddr(VkDevice, const char* name)
+	{
+		if (std::strcmp(name, "vkCreateImage") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubCreateImage);
+		if (std::strcmp(name, "vkGetImageMemoryRequirements") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubGetImageMemoryRequirements);
+		if (std::strcmp(name, "vkAllocateMemory") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubAllocateMemory);
+		if (std::strcmp(name, "vkBindImageMemory") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubBindImageMemory);
+		if (std::strcmp(name, "vkCreateImageView") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubCreateImageView);
+		if (std::strcmp(name, "vkDestroyImageView") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubDestroyImageView);
+		if (std::strcmp(name, "vkDestroyImage") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubDestroyImage);
+		if (std::strcmp(name, "vkFreeMemory") == 0)
+			return reinterpret_cast<PFN_vkVoidFunction>(&stubFreeMemory);
+		return nullptr;
+	}
+
+	struct Device {
+		Graphics::DeviceFunctionTable functions{ &stubGetDeviceProcAddr };
+		Graphics::DeviceRef device{ makeHandle<VkDevice>(0x10) };
+		Graphics::PhysicalDeviceMemoryProperties memoryProperties;
+
+		Device()
+		{
+			functions.loadFunctions<DeviceFunction::CreateImage, DeviceFunction::GetImageMemoryRequirements,
+				DeviceFunction::AllocateMemory, DeviceFunction::BindImageMemory, DeviceFunction::CreateImageView,
+				DeviceFunction::DestroyImageView, DeviceFunction::DestroyImage, DeviceFunction::FreeMemory>(VK_NULL_HANDLE);
+			memoryProperties.memoryTypeCount = 1;
+			memoryProperties.memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+			memoryProperties.memoryHeapCount = 1;
+			memoryProperties.memoryHeaps[0].size = 1 << 20;
+		}
+	};
+
+	void noExecute(const Graphics::DeviceFunctionTable&, PassContext&) {}
+
+	bool isScheduled(const Graph& graph, const std::string& name)
+	{
+		const auto& order = graph.getExecutionOrder();
+		return std::any_of(order.begin(), order.end(),
+			[&](uint32_t pass) { return graph.getPassName(pass) == name; });
+	}
+
+	// depthAttachment() and a blended colorAttachment() read what the pass before wrote, even though
+	// they are declared as one writing access
+	void testReadWriteConsumerKeepsProducer()
+	{
+		Device device;
+		Graph graph;
+
+		TextureDesc colorDesc;
+		colorDesc.width = 64;
+		colorDesc.height = 64;
+		TextureDesc depthDesc = colorDesc;
+		depthDesc.format = Graphics::PixelFormat::D32Sfloat;
+		depthDesc.aspect = Flags::ImageAspect::Bits::Depth;
+
+		auto backBuffer = graph.importImage("back buffer", Graphics::ImageRef(makeHandle<VkImage>(1)),
+			Graphics::ImageViewRef(makeHandle<VkImageView>(2)), colorDesc,
+			{ Flags::PipelineStage::Bits::None, Flags::Access::Bits::None, Graphics::ImageLayout::Undefined });
+		ResourceHandle depth;
+		ResourceHandle scene;
+
+		graph.addPass("depth prepass", QueueType::Graphics, [&](PassBuilder& builder) {
+			depth = builder.createTexture("depth", depthDesc);
+			builder.write(depth, ResourceUse::depthAttachment());
+		}, &noExecute);
+		graph.addPass("clear", QueueType::Graphics, [&](PassBuilder& builder) {
+			scene = builder.createTexture("scene", colorDesc);
+			builder.write(scene, ResourceUse::transferWrite());
+		}, &noExecute);
+		graph.addPass("main", QueueType::Graphics, [&](PassBuilder& builder) {
+			builder.write(depth, ResourceUse::depthAttachment());
+			builder.write(scene, ResourceUse::colorAttachment());
+		}, &noExecute);
+		graph.addPass("unused", QueueType::Graphics, [&](PassBuilder& builder) {
+			builder.write(builder.createTexture("debug", colorDesc), ResourceUse::colorAttachment());
+		}, &noExecute);
+		graph.addPass("compose", QueueType::Graphics, [&](PassBuilder& builder) {
+			builder.read(scene, ResourceUse::shaderRead(Flags::PipelineStage::Bits::FragmentShader));
+			builder.write(backBuffer, ResourceUse::colorAttachment());
+		}, &noExecute);
+
+		graph.compile(device.functions, device.device, device.memoryProperties, 1);
+
+		TEST_CHECK(graph.getCulledPassCount() == 1);
+		TEST_CHECK(isScheduled(graph, "depth prepass"));
+		TEST_CHECK(isScheduled(graph, "clear"));
+		TEST_CHECK(isScheduled(graph, "main"));
+		TEST_CHECK(isScheduled(graph, "compose"));
+		TEST_CHECK(!isScheduled(graph, "unused"));
+
+		graph.destroy(device.functions, device.device);
+	}
+
+	// a pass that only reads is kept when it declared a side effect
+	void testSideEffectKeepsPass()
+	{
+		Device device;
+		Graph graph;
+
+		TextureDesc desc;
+		auto image = graph.importImage("image", Graphics::ImageRef(makeHandle<VkImage>(1)),
+			Graphics::ImageViewRef(makeHandle<VkImageView>(2)), desc, ResourceUse::transferWrite());
+
+		graph.addPass("readback", QueueType::Graphics, [&](PassBuilder& builder) {
+			builder.read(image, ResourceUse::transferRead());
+			builder.setSideEffect();
+		}, &noExecute);
+		graph.addPass("inspect", QueueType::Graphics, [&](PassBuilder& builder) {
+			builder.read(image, ResourceUse::transferRead());
+		}, &noExecute);
+
+		graph.compile(device.functions, device.device, device.memoryProperties, 1);
+
+		TEST_CHECK(graph.getCulledPassCount() == 1);
+		TEST_CHECK(isScheduled(graph, "readback"));
+		TEST_CHECK(!isScheduled(graph, "inspect"));
+
+		graph.destroy(device.functions, device.device);
+	}
+}
+
+int main()
+{
+	testReadWriteConsumerKeepsProducer();
+	testSideEffectKeepsPass();
+	return Test::finish();
+}
@@ -0,0 +1,152 @@
+// Checks the barriers ResourceStateTracker queues for uses declared before one flush.
+// Built with GRAPHICS_BUILD_TESTS, no device is needed, handles are never dereferenced.
+#include "Graphics/Synchronization/ResourceStateTracker.h"
+#include "TestCheck.h"
+
+#include <vector>
+
+namespace
+{
+	using Graphics::Synchronization::ResourceStateTracker;
+	using Graphics::Synchronization::ResourceUse;
+	namespace Flags = Graphics::Flags;
+
+	using Test::makeHandle;
+
+	struct RecordedBatch {
+		Flags::PipelineStage srcStages;
+		Flags::PipelineStage dstStages;
+		std::vector<VkBufferMemoryBarrier> bufferBarriers;
+		std::vector<VkImageMemoryBarrier> imageBarriers;
+	};
+
+	void flush(ResourceStateTracker& tracker, std::vector<RecordedBatch>& recorded)
+	{
+		tracker.flush([&](Flags::PipelineStage srcStages, Flags::PipelineStage dstStages,
+			std::span<const Graphics::BufferMemoryBarrier> bufferBarriers,
+			std::span<const Graphics::ImageMemoryBarrier> imageBarriers) {
+			RecordedBatch batch{ srcStages, dstStages };
+			for (const auto& barrier : bufferBarriers)
+				batch.bufferBarriers.push_back(barrier);
+			for (const auto& barrier : imageBarriers)
+				batch.imageBarriers.push_back(barrier);
+			recorded.push_back(std::move(batch));
+		});
+	}
+
+	// a read required after a write of the same range before flushing must not share the write's barrier
+	void testWriteThenReadBuffer()
+	{
+		ResourceStateTracker tracker;
+		Graphics::BufferRef buffer(makeHandle<VkBuffer>(1));
+		tracker.registerBuffer(buffer, 256);
+		tracker.assumeBuffer(buffer, { Flags::PipelineStage::Bits::Host, Flags::Access::Bits::HostWrite });
+
+		std::vector<RecordedBatch> recorded;
+		auto read = ResourceUse::shaderRead(Flags::PipelineStage::Bits::ComputeShader);
+		TEST_CHECK(tracker.requireBuffer(buffer, ResourceUse::transferWrite(), 0, 128));
+		TEST_CHECK(!tracker.requireBuffer(buffer, read, 64, 64));
+
+		// the refused read left the tracker untouched
+		flush(tracker, recorded);
+		TEST_CHECK(recorded.size() == 1);
+
+		// the transfer would be recorded here
+		TEST_CHECK(tracker.requireBuffer(buffer, read, 64, 64));
+		flush(tracker, recorded);
+
+		TEST_CHECK(recorded.size() == 2);
+		if (recorded.size() != 2)
+			return;
+
+		const auto& write = recorded[0];
+		TEST_CHECK(write.srcStages == Flags::PipelineStage::Bits::Host);
+		TEST_CHECK(write.dstStages == Flags::PipelineStage::Bits::Transfer);
+		TEST_CHECK(write.bufferBarriers.size() == 1);
+		if (write.bufferBarriers.size() == 1)
+		{
+			TEST_CHECK(write.bufferBarriers[0].srcAccessMask == uint32_t(VK_ACCESS_HOST_WRITE_BIT));
+			TEST_CHECK(write.bufferBarriers[0].dstAccessMask == uint32_t(VK_ACCESS_TRANSFER_WRITE_BIT));
+			TEST_CHECK(write.bufferBarriers[0].offset == 0 && write.bufferBarriers[0].size == 128);
+		}
+
+		const auto& second = recorded[1];
+		TEST_CHECK(second.srcStages == Flags::PipelineStage::Bits::Transfer);
+		TEST_CHECK(second.dstStages == Flags::PipelineStage::Bits::ComputeShader);
+		TEST_CHECK(second.bufferBarriers.size() == 1);
+		if (second.bufferBarriers.size() == 1)
+		{
+			TEST_CHECK(second.bufferBarriers[0].srcAccessMask == uint32_t(VK_ACCESS_TRANSFER_WRITE_BIT));
+			TEST_CHECK(second.bufferBarriers[0].dstAccessMask == uint32_t(VK_ACCESS_SHADER_READ_BIT));
+			TEST_CHECK(second.bufferBarriers[0].offset == 64 && second.bufferBarriers[0].size == 64);
+		}
+	}
+
+	// write after read and write after write in one batch need a flush as well, even without a queued barrier
+	void testWriteAfterUseInBatch()
+	{
+		ResourceStateTracker tracker;
+		Graphics::BufferRef buffer(makeHandle<VkBuffer>(2));
+		tracker.registerBuffer(buffer, 256);
+
+		std::vector<RecordedBatch> recorded;
+		TEST_CHECK(tracker.requireBuffer(buffer, ResourceUse::transferWrite()));
+		TEST_CHECK(!tracker.requireBuffer(buffer, ResourceUse::transferWrite()));
+		flush(tracker, recorded);
+		// the first write had nothing to wait for
+		TEST_CHECK(recorded.empty());
+
+		TEST_CHECK(tracker.requireBuffer(buffer, ResourceUse::vertexBuffer()));
+		TEST_CHECK(!tracker.requireBuffer(buffer, ResourceUse::transferWrite()));
+		flush(tracker, recorded);
+		TEST_CHECK(tracker.requireBuffer(buffer, ResourceUse::transferWrite()));
+		flush(tracker, recorded);
+
+		TEST_CHECK(recorded.size() == 2);
+		if (recorded.size() == 2)
+		{
+			TEST_CHECK(recorded[0].dstStages == Flags::PipelineStage::Bits::VertexInput);
+			// the write waits for the vertex input that read the range before
+			TEST_CHECK(recorded[1].srcStages.hasFlag(Flags::PipelineStage::Bits::VertexInput));
+			TEST_CHECK(recorded[1].dstStages == Flags::PipelineStage::Bits::Transfer);
+			TEST_CHECK(recorded[1].bufferBarriers.size() == 1);
+		}
+	}
+
+	// reads of one layout share the barrier of the batch
+	void testReadsShareBarrier()
+	{
+		ResourceStateTracker tracker;
+		Graphics::ImageRef image(makeHandle<VkImage>(3));
+		tracker.registerImage(image, Flags::ImageAspect::Bits::Color);
+		tracker.assumeImage(image, ResourceUse::transferWrite());
+
+		std::vector<RecordedBatch> recorded;
+		TEST_CHECK(tracker.requireImage(image, ResourceUse::shaderRead(Flags::PipelineStage::Bits::FragmentShader)));
+		TEST_CHECK(tracker.requireImage(image, ResourceUse::shaderRead(Flags::PipelineStage::Bits::ComputeShader)));
+		TEST_CHECK(!tracker.requireImage(image, ResourceUse::transferRead()));
+		flush(tracker, recorded);
+
+		TEST_CHECK(recorded.size() == 1);
+		if (recorded.size() == 1)
+		{
+			TEST_CHECK(recorded[0].imageBarriers.size() == 1);
+			TEST_CHECK(recorded[0].dstStages ==
+				(Flags::PipelineStage::Bits::FragmentShader | Flags::PipelineStage::Bits::ComputeShader));
+			if (recorded[0].imageBarriers.size() == 1)
+			{
+				TEST_CHECK(recorded[0].imageBarriers[0].oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+				TEST_CHECK(recorded[0].imageBarriers[0].newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			}
+		}
+		TEST_CHECK(tracker.getLayout(image) == Graphics::ImageLayout::ShaderReadOnlyOptimal);
+	}
+}
+
+int main()
+{
+	testWriteThenReadBuffer();
+	testWriteAfterUseInBatch();
+	testReadsShareBarrier();
+	return Test::finish();
+}
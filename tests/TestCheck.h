@@ -0,0 +1,39 @@
+// Checks shared by the tests, a failed check is reported and counted without stopping the test.
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+#define TEST_CHECK(condition) do { \
+	if (!(condition)) { \
+		std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+		++Test::g_failures; \
+	} \
+} while (false)
+
+namespace Test
+{
+	inline int g_failures = 0;
+
+	// handles are never dereferenced, any distinct value works
+	template<typename Handle>
+	Handle makeHandle(uint64_t value)
+	{
+		if constexpr (std::is_pointer_v<Handle>)
+			return reinterpret_cast<Handle>(static_cast<uintptr_t>(value));
+		else
+			return Handle(value);
+	}
+
+	// the return value of main
+	inline int finish()
+	{
+		if (g_failures != 0)
+		{
+			std::cerr << g_failures << " checks failed\n";
+			return 1;
+		}
+		std::cout << "all checks passed\n";
+		return 0;
+	}
+}